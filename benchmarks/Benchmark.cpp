@@ -0,0 +1,61 @@
+//------------------------------------------------------------------------------
+// Benchmark.cpp
+// Minimal harness for throughput benchmarks.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <fmt/format.h>
+
+namespace slang::bench {
+
+static constexpr int MinIterations = 5;
+static constexpr double MinTotalSeconds = 0.5;
+
+std::vector<Benchmark>& getBenchmarks() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+double timeOnce(const std::function<void()>& setup, const std::function<void()>& func) {
+    setup();
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+static std::string formatRate(double perSecond, const char* unit) {
+    const char* prefixes[] = { "", "K", "M", "G", "T" };
+    size_t index = 0;
+    while (perSecond >= 1000.0 && index < std::size(prefixes) - 1) {
+        perSecond /= 1000.0;
+        index++;
+    }
+    return fmt::format("{:8.2f} {}{}/s", perSecond, prefixes[index], unit);
+}
+
+void measure(string_view name, Work work, const std::function<void()>& setup,
+             const std::function<void()>& func) {
+    double best = timeOnce(setup, func);
+    double total = best;
+    int iterations = 1;
+    while (iterations < MinIterations || total < MinTotalSeconds) {
+        double t = timeOnce(setup, func);
+        best = std::min(best, t);
+        total += t;
+        iterations++;
+    }
+
+    std::string result = fmt::format("  {:<40} {:10.3f} ms", name, best * 1000.0);
+    if (work.bytes)
+        result += "  " + formatRate(double(work.bytes) / best, "B");
+    if (work.items)
+        result += "  " + formatRate(double(work.items) / best, work.itemName ? work.itemName : "op");
+
+    fmt::print("{}  ({} runs)\n", result, iterations);
+}
+
+} // namespace slang::bench
@@ -0,0 +1,70 @@
+//------------------------------------------------------------------------------
+// Benchmark.h
+// Minimal harness for throughput benchmarks.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "slang/util/Util.h"
+
+namespace slang::bench {
+
+/// A benchmark is a named function that sets up its inputs and calls
+/// @a measure for each operation it wants timed.
+struct Benchmark {
+    const char* name;
+    void (*func)();
+};
+
+std::vector<Benchmark>& getBenchmarks();
+
+inline bool registerBenchmark(const char* name, void (*func)()) {
+    getBenchmarks().push_back({ name, func });
+    return true;
+}
+
+/// Declares and registers a new benchmark function.
+#define BENCHMARK(name)                                                           \
+    static void name();                                                           \
+    [[maybe_unused]] static const bool name##_registered =                        \
+        slang::bench::registerBenchmark(#name, &name);                            \
+    static void name()
+
+/// Describes how much work a single run of an operation performs.
+struct Work {
+    uint64_t bytes = 0;
+    uint64_t items = 0;
+    const char* itemName = nullptr;
+};
+
+/// Times a single run of @a func, with @a setup called (untimed) beforehand.
+double timeOnce(const std::function<void()>& setup, const std::function<void()>& func);
+
+/// Runs @a func repeatedly (calling @a setup untimed before each run) until enough
+/// samples have been collected, then prints the throughput of the fastest run.
+void measure(string_view name, Work work, const std::function<void()>& setup,
+             const std::function<void()>& func);
+
+/// Runs @a func repeatedly and prints the throughput of the fastest run.
+inline void measure(string_view name, Work work, const std::function<void()>& func) {
+    measure(name, work, [] {}, func);
+}
+
+/// Prevents the compiler from optimizing away the computation of @a value.
+template<typename T>
+void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+} // namespace slang::bench
@@ -0,0 +1,77 @@
+//------------------------------------------------------------------------------
+// ConditionalBench.cpp
+// Benchmarks for preprocessing code with large inactive conditional regions.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#include <fmt/format.h>
+
+#include "Benchmark.h"
+
+#include "slang/parsing/Preprocessor.h"
+#include "slang/text/SourceManager.h"
+#include "slang/util/BumpAllocator.h"
+
+using namespace slang;
+using namespace slang::bench;
+
+static void generateBody(std::string& text, int depth, int& counter) {
+    std::string indent(size_t(depth) * 4, ' ');
+    for (int i = 0; i < 16; i++, counter++) {
+        text += fmt::format("{}assign w_{} = a_{} & b_{}; // \"{}\" `ifdef in a comment\n", indent,
+                            counter, counter, counter, counter);
+    }
+    text += fmt::format("{}initial $display(\"vendor model `endif {}\");\n", indent, counter);
+}
+
+// Generates nested conditionals where only the innermost `else branches are active,
+// so most of the text lives in inactive regions that themselves contain conditionals.
+static void generateNest(std::string& text, int depth, int maxDepth, int& counter) {
+    std::string indent(size_t(depth) * 4, ' ');
+    text += fmt::format("{}`ifdef VENDOR_MODEL_{}\n", indent, depth);
+    generateBody(text, depth + 1, counter);
+    if (depth + 1 < maxDepth)
+        generateNest(text, depth + 1, maxDepth, counter);
+    text += fmt::format("{}`elsif ALT_IMPL_{}\n", indent, depth);
+    generateBody(text, depth + 1, counter);
+    if (depth + 1 < maxDepth)
+        generateNest(text, depth + 1, maxDepth, counter);
+    text += fmt::format("{}`else\n", indent);
+    generateBody(text, depth + 1, counter);
+    text += fmt::format("{}`endif\n", indent);
+}
+
+static std::string generateConditionals(size_t targetSize, int maxDepth) {
+    std::string text;
+    int counter = 0;
+    while (text.size() < targetSize)
+        generateNest(text, 0, maxDepth, counter);
+    return text;
+}
+
+static void preprocessConditionals(string_view name, int maxDepth) {
+    std::string text = generateConditionals(16 * 1024 * 1024, maxDepth);
+
+    SourceManager sourceManager;
+    SourceBuffer buffer = sourceManager.assignText(text);
+
+    uint64_t tokenCount = 0;
+    auto run = [&] {
+        BumpAllocator alloc;
+        Diagnostics diagnostics;
+        Preprocessor preprocessor(sourceManager, alloc, diagnostics);
+        preprocessor.pushSource(buffer);
+
+        tokenCount = 0;
+        while (preprocessor.next().kind != TokenKind::EndOfFile)
+            tokenCount++;
+    };
+
+    run();
+    measure(name, { text.size(), tokenCount, "tok" }, run);
+}
+
+BENCHMARK(InactiveConditionals) {
+    preprocessConditionals("16MB, nesting depth 4", 4);
+    preprocessConditionals("16MB, nesting depth 10", 10);
+}
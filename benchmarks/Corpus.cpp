@@ -0,0 +1,199 @@
+//------------------------------------------------------------------------------
+// Corpus.cpp
+// Generators for synthetic SystemVerilog benchmark inputs.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#include "Corpus.h"
+
+#include <fmt/format.h>
+
+namespace slang::bench {
+
+std::string generateCommented(size_t targetSize) {
+    std::string text;
+    int counter = 0;
+    while (text.size() < targetSize) {
+        text += "//" + std::string(78, '-') + "\n";
+        text += fmt::format("// Register block {}: control and status registers for the\n"
+                            "// interface. Fields are documented inline below.\n",
+                            counter);
+        text += "//" + std::string(78, '-') + "\n";
+        text += "/*\n * Reset values come from the specification, section 4.2.\n"
+                " * Do not change them without updating the register map.\n */\n";
+        for (int i = 0; i < 8; i++, counter++) {
+            text += fmt::format("                logic [31:0] reg_{};        "
+                                "// offset 0x{:x}, read/write\n",
+                                counter, counter * 4);
+        }
+        text += "\n";
+    }
+    return text;
+}
+
+std::string generateNetlist(size_t targetSize) {
+    static const char* cells[] = { "NAND2X1", "NOR2X1", "AOI21X1", "OAI22X2", "DFFRX1", "INVX2" };
+
+    std::string text = "module top_netlist (clk, rst_n, data_in, data_out);\n"
+                       "  input clk, rst_n;\n";
+    int net = 0;
+    for (int cell = 0; text.size() < targetSize; cell++) {
+        if (cell % 32 == 0) {
+            text += "  wire ";
+            for (int i = 0; i < 32; i++)
+                text += fmt::format("{}u_core_dp_alu_n{}", i ? ", " : "", net + i);
+            text += ";\n";
+        }
+
+        text += fmt::format("  {} u_core_dp_alu_add_{}_U{} ( .A(u_core_dp_alu_n{}), "
+                            ".B(u_core_dp_alu_n{}), .Y(u_core_dp_alu_n{}) );\n",
+                            cells[cell % 6], cell / 32, cell, net, net + 1, net + 2);
+        net++;
+    }
+    text += "endmodule\n";
+    return text;
+}
+
+// The macros are cut down versions of the real UVM ones, keeping their shape:
+// bodies spanning many lines, stringified arguments, and nested invocations.
+static const char* uvmMacros = R"(`define uvm_info(ID, MSG, VERBOSITY) \
+    begin \
+        if (uvm_report_enabled(VERBOSITY, UVM_INFO, ID)) \
+            uvm_report_info(ID, MSG, VERBOSITY, `__FILE__, `__LINE__); \
+    end
+
+`define uvm_field_int(ARG, FLAG) \
+    begin \
+        if (what__ == UVM_PRINT && (FLAG & UVM_NOPRINT) == 0) \
+            printer.print_field(`"ARG`", ARG, $bits(ARG)); \
+        else if (what__ == UVM_COMPARE && (FLAG & UVM_NOCOMPARE) == 0) \
+            `uvm_compare_field(ARG) \
+    end
+
+`define uvm_compare_field(ARG) \
+    if (ARG !== rhs__.ARG) comparer.compare_field(`"ARG`", ARG, rhs__.ARG, $bits(ARG));
+
+`define uvm_object_utils_begin(T) \
+    typedef uvm_object_registry #(T, `"T`") type_id; \
+    static function type_id get_type(); \
+        return type_id::get(); \
+    endfunction \
+    function void field_automation(int what__, T rhs__);
+
+`define uvm_object_utils_end \
+    endfunction
+
+)";
+
+std::string generateMacroHeavy(size_t targetSize) {
+    std::string text = uvmMacros;
+    for (int item = 0; text.size() < targetSize; item++) {
+        text += fmt::format("class seq_item_{0} extends uvm_sequence_item;\n"
+                            "    rand bit [31:0] addr;\n"
+                            "    rand bit [63:0] data;\n"
+                            "    rand int unsigned burst_len;\n"
+                            "    rand bit [3:0] byte_en;\n\n"
+                            "    `uvm_object_utils_begin(seq_item_{0})\n"
+                            "        `uvm_field_int(addr, UVM_ALL_ON)\n"
+                            "        `uvm_field_int(data, UVM_ALL_ON)\n"
+                            "        `uvm_field_int(burst_len, UVM_NOCOMPARE)\n"
+                            "        `uvm_field_int(byte_en, UVM_NOPRINT)\n"
+                            "    `uvm_object_utils_end\n\n"
+                            "    function void set_name(string name = \"seq_item_{0}\");\n"
+                            "        m_name = name;\n"
+                            "    endfunction\n\n"
+                            "    task body();\n"
+                            "        `uvm_info(\"SEQ_{0}\", $sformatf(\"addr=%0h data=%0h\", "
+                            "addr, data), UVM_MEDIUM)\n"
+                            "        `uvm_info(\"SEQ_{0}\", \"done\", UVM_HIGH)\n"
+                            "    endtask\n"
+                            "endclass\n\n",
+                            item);
+    }
+    return text;
+}
+
+static void generateNested(std::string& text, int depth, int& operand) {
+    static const char* ops[] = { " + ", " * ", " - ", " ^ ", " & ", " | ", " << ", " >>> " };
+    if (depth == 0) {
+        text += fmt::format("in_{}", operand++ % 64);
+        return;
+    }
+
+    text += fmt::format("(in_{}{}", operand++ % 64, ops[depth % 8]);
+    generateNested(text, depth - 1, operand);
+    text += ")";
+}
+
+std::string generateDeepExpressions(size_t targetSize) {
+    static const char* ops[] = { " + ", " * ", " - ", " == ", " && ", " || ", " < ", " ? " };
+
+    std::string text = "module deep_exprs;\n  logic [31:0] ";
+    for (int i = 0; i < 64; i++)
+        text += fmt::format("{}in_{}", i ? ", " : "", i);
+    text += ";\n";
+
+    int operand = 0;
+    for (int i = 0; text.size() < targetSize; i++) {
+        text += fmt::format("  logic [31:0] nest_{0}, chain_{0};\n  assign nest_{0} = ", i);
+        generateNested(text, 64, operand);
+
+        text += fmt::format(";\n  assign chain_{} = in_{}", i, operand++ % 64);
+        for (int j = 0; j < 128; j++) {
+            int op = (i + j) % 8;
+            text += fmt::format("{}in_{}", ops[op], operand++ % 64);
+
+            // A conditional operator needs its colon; everything else chains freely.
+            if (op == 7)
+                text += fmt::format(" : in_{}", operand++ % 64);
+        }
+        text += ";\n";
+    }
+    text += "endmodule\n";
+    return text;
+}
+
+std::string generateLongChains(size_t targetSize) {
+    static const char* ops[] = { " + ", " - ", " & ", " | " };
+
+    std::string text = "module long_chains;\n  logic [31:0] ";
+    for (int i = 0; i < 64; i++)
+        text += fmt::format("{}in_{}", i ? ", " : "", i);
+    text += ";\n  logic [31:0] sum, sel;\n  assign sum = in_0";
+
+    int operand = 1;
+    while (text.size() < targetSize / 2) {
+        text += fmt::format("{}in_{}", ops[operand % 4], operand % 64);
+        if (++operand % 8 == 0)
+            text += "\n    ";
+    }
+
+    text += ";\n  assign sel = ";
+    while (text.size() < targetSize) {
+        text += fmt::format("in_{} == {} ? in_{} :\n    ", operand % 64, operand,
+                            (operand + 1) % 64);
+        operand++;
+    }
+    text += "in_0;\nendmodule\n";
+    return text;
+}
+
+std::string generateWideLiterals(size_t targetSize) {
+    std::string text = "module rom_model;\n"
+                       "  logic [255:0] mem [0:1048575];\n"
+                       "  logic [7:0] mask [0:1048575];\n"
+                       "  initial begin\n";
+    uint64_t state = 0x9e3779b97f4a7c15ull;
+    for (int i = 0; text.size() < targetSize; i++) {
+        text += fmt::format("    mem[{}] = 256'h", i);
+        for (int j = 0; j < 4; j++) {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            text += fmt::format("{}{:016x}", j ? "_" : "", state);
+        }
+        text += fmt::format(";\n    mask[{}] = 8'b{:04b}_x{:03b};\n", i, i & 0xf, (i >> 4) & 0x7);
+    }
+    text += "  end\nendmodule\n";
+    return text;
+}
+
+} // namespace slang::bench
@@ -0,0 +1,43 @@
+//------------------------------------------------------------------------------
+// Corpus.h
+// Generators for synthetic SystemVerilog benchmark inputs.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <string>
+
+namespace slang::bench {
+
+// Each generator produces deterministic text of at least the given size
+// (in bytes), modeled on a kind of code that stresses a particular part
+// of the front end.
+
+/// Code in the style of heavily documented IP: long banner and block
+/// comments, deep indentation, and trailing comments on most lines.
+std::string generateCommented(size_t targetSize);
+
+/// A flat gate-level netlist: almost nothing but identifiers, with the
+/// long hierarchical names synthesis tools like to produce.
+std::string generateNetlist(size_t targetSize);
+
+/// Verification code in the style of UVM: a block of multi-line macros at the
+/// top, then classes made mostly of invocations of them, so that most of the
+/// tokens the parser sees come out of macro expansions.
+std::string generateMacroHeavy(size_t targetSize);
+
+/// Continuous assignments with deeply nested parenthesized expressions and
+/// long chains of binary operators of mixed precedence.
+std::string generateDeepExpressions(size_t targetSize);
+
+/// A handful of enormous expressions, the way generated code sometimes has: one
+/// long chain of left associative binary operators, and one long chain of
+/// conditional operators, each a single statement.
+std::string generateLongChains(size_t targetSize);
+
+/// A memory initialization block, the way generated ROM models and test vectors
+/// look: wide hex words, with some four-state binary patterns mixed in.
+std::string generateWideLiterals(size_t targetSize);
+
+} // namespace slang::bench
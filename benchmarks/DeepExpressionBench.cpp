@@ -0,0 +1,67 @@
+//------------------------------------------------------------------------------
+// DeepExpressionBench.cpp
+// Parsing and walking the deep trees of very long expressions.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#include <fmt/format.h>
+
+#include "Benchmark.h"
+#include "Corpus.h"
+
+#include "slang/syntax/SyntaxPrinter.h"
+#include "slang/syntax/SyntaxTree.h"
+#include "slang/syntax/SyntaxVisitor.h"
+
+using namespace slang;
+using namespace slang::bench;
+
+namespace {
+
+struct TokenCounter : public SyntaxVisitor<TokenCounter, true> {
+    uint64_t count = 0;
+    void visitToken(Token) { count++; }
+};
+
+struct OperandRenamer : public SyntaxRewriter<OperandRenamer, true> {
+    void handle(const IdentifierNameSyntax& name) {
+        if (name.identifier.valueText() == "in_0")
+            replace(name, parse(" in_63"));
+    }
+};
+
+} // namespace
+
+// Each expression in the input is a single node chain hundreds of thousands of nodes
+// deep, which used to overflow the stack everywhere the tree got walked recursively,
+// and ran conditional chains into the parser's recursion limit.
+static void walkLongChains(string_view name, const std::string& text) {
+    SourceManager sourceManager;
+    SourceBuffer buffer = sourceManager.assignText(text);
+
+    std::shared_ptr<SyntaxTree> tree;
+    auto parse = [&] { tree = SyntaxTree::fromBuffer(buffer, sourceManager); };
+    parse();
+
+    if (!tree->diagnostics().empty())
+        fmt::print("  warning: {} has {} diagnostics\n", name, tree->diagnostics().size());
+
+    TokenCounter counter;
+    tree->root().visit(counter);
+    uint64_t tokens = counter.count;
+
+    measure(fmt::format("{}, parse", name), { text.size(), tokens, "tok" }, parse);
+    measure(fmt::format("{}, visit", name), { text.size(), tokens, "tok" }, [&] {
+        TokenCounter visitor;
+        tree->root().visit(visitor);
+        doNotOptimize(visitor.count);
+    });
+    measure(fmt::format("{}, print", name), { text.size(), tokens, "tok" },
+            [&] { doNotOptimize(SyntaxPrinter::printFile(*tree)); });
+    measure(fmt::format("{}, rewrite", name), { text.size(), tokens, "tok" },
+            [&] { doNotOptimize(OperandRenamer().transform(tree)); });
+}
+
+BENCHMARK(DeepExpression) {
+    walkLongChains("4MB long chains", generateLongChains(4 * 1024 * 1024));
+}
@@ -0,0 +1,38 @@
+//------------------------------------------------------------------------------
+// EditBench.cpp
+// Cost of updating a syntax tree after a small edit, compared with parsing again.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#include <fmt/format.h>
+
+#include "Benchmark.h"
+#include "Corpus.h"
+
+#include "slang/syntax/SyntaxTree.h"
+
+using namespace slang;
+using namespace slang::bench;
+
+BENCHMARK(Edit) {
+    // About 50k lines, where every register is its own top-level member. Each run adds
+    // another copy of the text to the source manager, so keep it from being too big.
+    std::string text = generateCommented(4 * 1024 * 1024);
+
+    SourceManager sourceManager;
+    auto tree = SyntaxTree::fromBuffer(sourceManager.assignText(text), sourceManager);
+
+    measure("4MB commented, full reparse", { text.size() }, [&] {
+        doNotOptimize(SyntaxTree::fromBuffer(sourceManager.assignText(text), sourceManager));
+    });
+
+    // Renaming one register, near the start, in the middle, and near the end. Members
+    // before the edit get shared with the old tree; those after it get copied. Near the
+    // start, there's so much to copy that the whole text gets reparsed instead.
+    for (int percent : { 10, 50, 90 }) {
+        size_t offset = text.find("reg_", text.size() * size_t(percent) / 100) + 4;
+        std::vector<TextEdit> edits = { { (uint32_t)offset, 1, "x" } };
+        measure(fmt::format("4MB commented, edit at {}%", percent), { text.size() },
+                [&] { doNotOptimize(SyntaxTree::fromEdits(tree, edits)); });
+    }
+}
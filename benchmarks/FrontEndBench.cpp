@@ -0,0 +1,128 @@
+//------------------------------------------------------------------------------
+// FrontEndBench.cpp
+// Throughput of each stage of the front end on a range of inputs.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#include <fmt/format.h>
+
+#include "Benchmark.h"
+#include "Corpus.h"
+
+#include "slang/parsing/Lexer.h"
+#include "slang/parsing/Parser.h"
+#include "slang/parsing/Preprocessor.h"
+#include "slang/syntax/SyntaxTree.h"
+#include "slang/text/SourceManager.h"
+#include "slang/util/BumpAllocator.h"
+
+using namespace slang;
+using namespace slang::bench;
+
+// Measures lexing, preprocessing, and parsing of the same text separately. Each
+// stage includes the ones before it, so the cost of a stage on its own is the
+// difference from the one before; the token counts are for what that stage
+// consumes (raw tokens for the lexer, expanded tokens for the others).
+static void measureStages(string_view name, const std::string& text) {
+    SourceManager sourceManager;
+    SourceBuffer buffer = sourceManager.assignText(text);
+
+    uint64_t lexedTokens = 0;
+    auto lex = [&] {
+        BumpAllocator alloc;
+        Diagnostics diagnostics;
+        Lexer lexer(buffer, alloc, diagnostics);
+
+        lexedTokens = 0;
+        while (lexer.lex().kind != TokenKind::EndOfFile)
+            lexedTokens++;
+    };
+
+    uint64_t expandedTokens = 0;
+    auto preprocess = [&] {
+        BumpAllocator alloc;
+        Diagnostics diagnostics;
+        Preprocessor preprocessor(sourceManager, alloc, diagnostics);
+        preprocessor.pushSource(buffer);
+
+        expandedTokens = 0;
+        while (preprocessor.next().kind != TokenKind::EndOfFile)
+            expandedTokens++;
+    };
+
+    size_t diagCount = 0;
+    auto parse = [&] {
+        BumpAllocator alloc;
+        Diagnostics diagnostics;
+        Preprocessor preprocessor(sourceManager, alloc, diagnostics);
+        preprocessor.pushSource(buffer);
+
+        Parser parser(preprocessor);
+        doNotOptimize(parser.parseCompilationUnit());
+        diagCount = diagnostics.size();
+    };
+
+    // Skimming bodies leaves them to be parsed on first use, which for
+    // a tool that only looks at declarations is never.
+    Bag skimOptions;
+    ParserOptions parserOptions;
+    parserOptions.skimBodies = true;
+    skimOptions.add(parserOptions);
+
+    auto skim = [&] {
+        BumpAllocator alloc;
+        Diagnostics diagnostics;
+        Preprocessor preprocessor(sourceManager, alloc, diagnostics);
+        preprocessor.pushSource(buffer);
+
+        Parser parser(preprocessor, skimOptions);
+        doNotOptimize(parser.parseCompilationUnit());
+    };
+
+    // Loading a cached tree replaces all of the other stages. Each load gets a fresh
+    // source manager, as a new run of a tool would, since loading registers buffers.
+    auto cachePath = (fs::temp_directory_path() / "slang_bench_tree.cache").string();
+    SyntaxTree::fromBuffer(buffer, sourceManager)->writeCache(cachePath);
+
+    std::unique_ptr<SourceManager> loadManager;
+    SourceBuffer loadBuffer;
+    auto resetLoad = [&] {
+        loadManager = std::make_unique<SourceManager>();
+        loadBuffer = loadManager->assignText(text);
+    };
+    auto load = [&] {
+        auto tree = SyntaxTree::fromCache(cachePath, loadBuffer, *loadManager);
+        if (!tree->isFromCache())
+            fmt::print("  warning: {} didn't load from the cache\n", name);
+    };
+
+    lex();
+    preprocess();
+    parse();
+
+    // The inputs are meant to be valid code; errors would mean we're timing
+    // error recovery instead of the paths real code takes.
+    if (diagCount)
+        fmt::print("  warning: {} has {} diagnostics\n", name, diagCount);
+
+    measure(fmt::format("{}, lex", name), { text.size(), lexedTokens, "tok" }, lex);
+    measure(fmt::format("{}, preprocess", name), { text.size(), expandedTokens, "tok" },
+            preprocess);
+    measure(fmt::format("{}, parse", name), { text.size(), expandedTokens, "tok" }, parse);
+    measure(fmt::format("{}, parse skimmed", name), { text.size(), expandedTokens, "tok" },
+            skim);
+    measure(fmt::format("{}, load cached", name), { text.size(), expandedTokens, "tok" },
+            resetLoad, load);
+
+    std::error_code ec;
+    fs::remove(cachePath, ec);
+}
+
+BENCHMARK(FrontEnd) {
+    static constexpr size_t Size = 16 * 1024 * 1024;
+    measureStages("16MB netlist", generateNetlist(Size));
+    measureStages("16MB macro heavy", generateMacroHeavy(Size));
+    measureStages("16MB deep expressions", generateDeepExpressions(Size));
+    measureStages("16MB wide literals", generateWideLiterals(Size));
+    measureStages("16MB comment heavy", generateCommented(Size));
+}
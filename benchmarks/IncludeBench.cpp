@@ -0,0 +1,73 @@
+//------------------------------------------------------------------------------
+// IncludeBench.cpp
+// Preprocessing of files that include the same header many times.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+
+#include "Benchmark.h"
+#include "Corpus.h"
+
+#include "slang/parsing/Preprocessor.h"
+#include "slang/parsing/TokenStreamCache.h"
+#include "slang/text/SourceManager.h"
+#include "slang/util/BumpAllocator.h"
+
+using namespace slang;
+using namespace slang::bench;
+
+namespace fs = std::filesystem;
+
+// Models a compilation unit that pulls in the same unguarded header over and over,
+// the way code generated per instance often does, with and without a token cache.
+// The cache lives across iterations, the same as one shared by a whole build, so
+// after the first run every include is a replay.
+BENCHMARK(RepeatedInclude) {
+    static constexpr size_t HeaderSize = 256 * 1024;
+    static constexpr size_t IncludeCount = 64;
+
+    auto dir = fs::temp_directory_path() / "slang_include_bench";
+    fs::create_directories(dir);
+    {
+        std::ofstream header(dir / "common.svh");
+        header << generateCommented(HeaderSize);
+    }
+
+    std::string text;
+    for (size_t i = 0; i < IncludeCount; i++)
+        text += "`include \"common.svh\"\n";
+
+    SourceManager sourceManager;
+    sourceManager.addUserDirectory(dir.string());
+    SourceBuffer buffer = sourceManager.assignText(text);
+
+    uint64_t tokenCount = 0;
+    auto run = [&](TokenStreamCache* cache) {
+        BumpAllocator alloc;
+        Diagnostics diagnostics;
+        PreprocessorOptions ppOptions;
+        ppOptions.tokenCache = cache;
+
+        Bag options;
+        options.add(ppOptions);
+
+        Preprocessor preprocessor(sourceManager, alloc, diagnostics, options);
+        preprocessor.pushSource(buffer);
+
+        tokenCount = 0;
+        while (preprocessor.next().kind != TokenKind::EndOfFile)
+            tokenCount++;
+    };
+
+    TokenStreamCache cache;
+    run(nullptr);
+
+    Work work{ HeaderSize * IncludeCount, tokenCount, "tok" };
+    measure("repeated include, no cache", work, [&] { run(nullptr); });
+    measure("repeated include, token cache", work, [&] { run(&cache); });
+
+    fs::remove_all(dir);
+}
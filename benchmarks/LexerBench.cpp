@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------
+// LexerBench.cpp
+// Benchmarks for raw lexing throughput.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#include <fmt/format.h>
+
+#include "Benchmark.h"
+#include "Corpus.h"
+
+#include "slang/parsing/Lexer.h"
+#include "slang/parsing/Parser.h"
+#include "slang/parsing/Preprocessor.h"
+#include "slang/text/SourceManager.h"
+#include "slang/util/BumpAllocator.h"
+#include "slang/util/ThreadPool.h"
+
+using namespace slang;
+using namespace slang::bench;
+
+static void lexText(string_view name, const std::string& text) {
+    SourceManager sourceManager;
+    SourceBuffer buffer = sourceManager.assignText(text);
+
+    uint64_t tokenCount = 0;
+    auto run = [&] {
+        BumpAllocator alloc;
+        Diagnostics diagnostics;
+        Lexer lexer(buffer, alloc, diagnostics);
+
+        tokenCount = 0;
+        while (lexer.lex().kind != TokenKind::EndOfFile)
+            tokenCount++;
+    };
+
+    run();
+    measure(name, { text.size(), tokenCount, "tok" }, run);
+}
+
+BENCHMARK(LexTrivia) {
+    lexText("16MB, comment heavy", generateCommented(16 * 1024 * 1024));
+}
+
+BENCHMARK(LexNetlist) {
+    lexText("16MB, gate-level netlist", generateNetlist(16 * 1024 * 1024));
+}
+
+// Reports how much memory tokens take up, both straight out of the lexer and
+// once the parser has built a tree around them, per megabyte of source text.
+static void reportTokenMemory(string_view name, const std::string& text, bool discardTrivia) {
+    SourceManager sourceManager;
+    SourceBuffer buffer = sourceManager.assignText(text);
+    double sourceMB = double(text.size()) / (1024 * 1024);
+
+    LexerOptions lexerOptions;
+    lexerOptions.discardTrivia = discardTrivia;
+
+    Bag options;
+    options.add(lexerOptions);
+
+    BumpAllocator lexAlloc;
+    Diagnostics diagnostics;
+    Lexer lexer(buffer, lexAlloc, diagnostics, lexerOptions);
+
+    uint64_t tokenCount = 0;
+    while (lexer.lex().kind != TokenKind::EndOfFile)
+        tokenCount++;
+
+    BumpAllocator parseAlloc;
+    Preprocessor preprocessor(sourceManager, parseAlloc, diagnostics, options);
+    preprocessor.pushSource(buffer);
+    Parser parser(preprocessor);
+    doNotOptimize(parser.parseCompilationUnit());
+
+    double lexMB = double(lexAlloc.getBytesAllocated()) / (1024 * 1024);
+    double parseMB = double(parseAlloc.getBytesAllocated()) / (1024 * 1024);
+    fmt::print("  {:<40} {:6.1f} MB/MB lexed ({:.1f} B/tok)  {:6.1f} MB/MB parsed\n", name,
+               lexMB / sourceMB, double(lexAlloc.getBytesAllocated()) / double(tokenCount),
+               parseMB / sourceMB);
+}
+
+BENCHMARK(TokenMemory) {
+    std::string commented = generateCommented(16 * 1024 * 1024);
+    std::string netlist = generateNetlist(16 * 1024 * 1024);
+
+    reportTokenMemory("16MB, comment heavy", commented, false);
+    reportTokenMemory("16MB, comment heavy, no trivia", commented, true);
+    reportTokenMemory("16MB, gate-level netlist", netlist, false);
+    reportTokenMemory("16MB, gate-level netlist, no trivia", netlist, true);
+}
+
+static void preprocessText(string_view name, const std::string& text, ThreadPool* pool) {
+    SourceManager sourceManager;
+    SourceBuffer buffer = sourceManager.assignText(text);
+
+    PreprocessorOptions ppOptions;
+    ppOptions.lexPool = pool;
+
+    Bag options;
+    options.add(ppOptions);
+
+    uint64_t tokenCount = 0;
+    auto run = [&] {
+        BumpAllocator alloc;
+        Diagnostics diagnostics;
+        Preprocessor preprocessor(sourceManager, alloc, diagnostics, options);
+        preprocessor.pushSource(buffer);
+
+        tokenCount = 0;
+        while (preprocessor.next().kind != TokenKind::EndOfFile)
+            tokenCount++;
+    };
+
+    run();
+    measure(name, { text.size(), tokenCount, "tok" }, run);
+}
+
+BENCHMARK(ChunkedLexing) {
+    std::string netlist = generateNetlist(128 * 1024 * 1024);
+    preprocessText("128MB netlist, serial", netlist, nullptr);
+
+    ThreadPool pool;
+    preprocessText(fmt::format("128MB netlist, {} lex threads", pool.getThreadCount()), netlist,
+                   &pool);
+}
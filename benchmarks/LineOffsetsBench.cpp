@@ -0,0 +1,53 @@
+//------------------------------------------------------------------------------
+// LineOffsetsBench.cpp
+// Benchmarks for computing line tables of large source files.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#include <memory>
+#include <random>
+
+#include "Benchmark.h"
+
+#include "slang/text/SourceManager.h"
+
+using namespace slang;
+using namespace slang::bench;
+
+static std::string generateLines(size_t targetSize, string_view newline) {
+    // Lines of random length, roughly matching the distribution in typical code.
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<size_t> lengthDist(0, 120);
+
+    std::string text;
+    text.reserve(targetSize + 256);
+    while (text.size() < targetSize) {
+        size_t len = lengthDist(rng);
+        for (size_t i = 0; i < len; i++)
+            text.push_back(char('a' + (i % 26)));
+        text += newline;
+    }
+    return text;
+}
+
+static void lineTable(string_view name, string_view newline) {
+    std::string text = generateLines(64 * 1024 * 1024, newline);
+
+    // Line tables are cached per buffer, so each run needs a fresh one. Asking
+    // for the line number of the last character forces the whole table to be built.
+    std::unique_ptr<SourceManager> manager;
+    SourceLocation last;
+    measure(
+        name, { text.size(), 0, nullptr },
+        [&] {
+            manager = std::make_unique<SourceManager>();
+            auto buffer = manager->assignText(text);
+            last = SourceLocation(buffer.id, text.size() - 1);
+        },
+        [&] { doNotOptimize(manager->getLineNumber(last)); });
+}
+
+BENCHMARK(LineOffsets) {
+    lineTable("64MB, LF line endings", "\n");
+    lineTable("64MB, CRLF line endings", "\r\n");
+}
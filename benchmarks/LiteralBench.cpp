@@ -0,0 +1,51 @@
+//------------------------------------------------------------------------------
+// LiteralBench.cpp
+// Benchmarks for parsing code dominated by integer literals.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#include <fmt/format.h>
+
+#include "Benchmark.h"
+#include "Corpus.h"
+
+#include "slang/parsing/Parser.h"
+#include "slang/parsing/Preprocessor.h"
+#include "slang/text/SourceManager.h"
+#include "slang/util/BumpAllocator.h"
+
+using namespace slang;
+using namespace slang::bench;
+
+static void parseLiterals(string_view name, const std::string& text, bool lazy) {
+    SourceManager sourceManager;
+    SourceBuffer buffer = sourceManager.assignText(text);
+
+    ParserOptions parserOptions;
+    parserOptions.lazyIntegerLiterals = lazy;
+
+    Bag options;
+    options.add(parserOptions);
+
+    size_t bytesAllocated = 0;
+    auto run = [&] {
+        BumpAllocator alloc;
+        Diagnostics diagnostics;
+        Preprocessor preprocessor(sourceManager, alloc, diagnostics, options);
+        preprocessor.pushSource(buffer);
+
+        Parser parser(preprocessor, options);
+        doNotOptimize(parser.parseCompilationUnit());
+        bytesAllocated = alloc.getBytesAllocated();
+    };
+
+    run();
+    measure(name, { text.size() }, run);
+    fmt::print("  {:<40} {:10.1f} MB allocated\n", "", double(bytesAllocated) / (1024 * 1024));
+}
+
+BENCHMARK(ParseLiterals) {
+    std::string text = generateWideLiterals(16 * 1024 * 1024);
+    parseLiterals("16MB, memory init, decoded", text, false);
+    parseLiterals("16MB, memory init, lazy", text, true);
+}
@@ -0,0 +1,31 @@
+//------------------------------------------------------------------------------
+// main.cpp
+// Entry point for the benchmark runner.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#include <algorithm>
+#include <fmt/format.h>
+
+#include "Benchmark.h"
+
+using namespace slang::bench;
+
+int main(int argc, char** argv) {
+    // Any arguments given are treated as filters; a benchmark runs if its
+    // name contains any of them.
+    std::vector<string_view> filters(argv + 1, argv + argc);
+
+    for (auto& benchmark : getBenchmarks()) {
+        string_view name = benchmark.name;
+        if (!filters.empty() &&
+            std::none_of(filters.begin(), filters.end(),
+                         [&](string_view f) { return name.find(f) != string_view::npos; })) {
+            continue;
+        }
+
+        fmt::print("{}\n", name);
+        benchmark.func();
+    }
+    return 0;
+}
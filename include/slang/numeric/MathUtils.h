@@ -57,6 +57,20 @@ inline uint32_t countLeadingZeros64(uint64_t value) {
 #endif
 }
 
+/// If value is zero, returns 32. Otherwise, returns the number of zeros, starting
+/// from the LSB.
+inline uint32_t countTrailingZeros32(uint32_t value) {
+    if (value == 0)
+        return 32;
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return index;
+#else
+    return (uint32_t)__builtin_ctz(value);
+#endif
+}
+
 inline uint32_t countLeadingOnes64(uint64_t value) {
     return countLeadingZeros64(~value);
 }
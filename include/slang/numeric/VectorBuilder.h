@@ -31,8 +31,14 @@ public:
     /// Finish off the literal and convert it into an SVInt instance.
     SVInt finish();
 
+    /// Finish off the literal, reporting any errors it has but without actually
+    /// building its value. Returns true if the literal is well formed, in which
+    /// case @a width and @a hasUnknown are set to describe the value it would have.
+    bool check(bitwidth_t& width, bool& hasUnknown);
+
 private:
     void addDigit(logic_t digit, int maxValue);
+    bool computeWidth(bitwidth_t& width);
 
     Diagnostics& diagnostics;
     SmallVectorSized<logic_t, 16> digits;
@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+// ChunkedLexer.h
+// Parallel lexing of very large source buffers.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "slang/parsing/Lexer.h"
+#include "slang/text/SourceManager.h"
+
+namespace slang {
+
+class ThreadPool;
+
+/// ChunkedLexer - Lexes one large buffer on many threads at once.
+///
+/// The buffer is split at line breaks where a quick pre-scan shows the lexer can't
+/// be in the middle of anything (a block comment, a string, or a line continuation),
+/// and each chunk is lexed into its own token array on a thread pool. Tokens are then
+/// handed out in order, the same as a Lexer would produce them: the token that starts
+/// each chunk is taken from the end of the previous chunk, which is the copy that has
+/// all of the trivia leading up to it, and diagnostics are reported as the tokens that
+/// caused them are handed out.
+///
+/// The pre-lexed tokens assume that the default keyword version is in effect and that
+/// there are no disabled conditional regions. When asked for anything else, or when a
+/// chunk's tokens don't line up with the end of the previous chunk, lexing continues
+/// serially from the last token handed out, until the serial lexer reaches the start
+/// of a later chunk in a state where it can pick up the pre-lexed tokens again.
+class ChunkedLexer {
+public:
+    /// Splits @a buffer into chunks of roughly @a chunkSize bytes and starts lexing
+    /// them on @a threadPool with the given @a keywordVersion. Tokens are allocated
+    /// from per-chunk allocators that are merged into @a alloc when the lexer is
+    /// destroyed, so they live as long as @a alloc does.
+    ChunkedLexer(SourceBuffer buffer, BumpAllocator& alloc, Diagnostics& diagnostics,
+                 LexerOptions options, KeywordVersion keywordVersion, ThreadPool& threadPool,
+                 size_t chunkSize);
+
+    /// Waits for any chunks still being lexed.
+    ~ChunkedLexer();
+
+    ChunkedLexer(const ChunkedLexer&) = delete;
+    ChunkedLexer& operator=(const ChunkedLexer&) = delete;
+
+    /// Lexes the next token, as Lexer::lex does.
+    Token lex(KeywordVersion keywordVersion);
+
+    /// Lexes the next token after an inactive region, as Lexer::lexDisabledRegion does.
+    Token lexDisabledRegion(KeywordVersion keywordVersion);
+
+    /// Gets the number of chunks the buffer was split into.
+    size_t getChunkCount() const { return chunks.size(); }
+
+    /// Finds offsets in @a text at which lexing can safely start over, roughly
+    /// @a chunkSize bytes apart. Each offset is just past a line break that isn't
+    /// inside a comment or string and doesn't follow a line continuation. The first
+    /// offset is always zero.
+    static void findChunkBoundaries(string_view text, size_t chunkSize,
+                                    SmallVector<size_t>& results);
+
+private:
+    struct Chunk {
+        // The range of source text this chunk is responsible for. The chunk's lexer
+        // keeps going past the end until it has lexed the first token of the next chunk.
+        size_t begin;
+        size_t end;
+
+        BumpAllocator alloc;
+        std::vector<Token> tokens;
+
+        // Diagnostics issued while lexing, each with the index of the token it goes with.
+        Diagnostics diagnostics;
+        std::vector<size_t> diagTokens;
+        size_t nextDiag = 0;
+
+        bool ready = false;
+    };
+
+    Token next(KeywordVersion keywordVersion, bool disabled);
+    Token nextSerial(KeywordVersion keywordVersion, bool disabled);
+    void startSerial();
+    void tryResync(Token token);
+    void enterChunk(size_t index);
+    void lexChunk(Chunk& chunk);
+    Chunk& waitForChunk(size_t index);
+    size_t countDiagnostics(const Chunk& chunk, size_t tokenIndex) const;
+    void reportDiagnostics(Chunk& chunk, size_t tokenIndex);
+    void handedOut(Token token);
+
+    SourceBuffer buffer;
+    BumpAllocator& alloc;
+    Diagnostics& diagnostics;
+    LexerOptions options;
+    KeywordVersion keywordVersion;
+
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    size_t currentChunk = 0;
+    size_t currentIndex = 0;
+
+    // The offset just past the last token handed out, which is where
+    // the serial lexer needs to start if we fall back to it.
+    size_t lastEnd = 0;
+    std::unique_ptr<Lexer> serialLexer;
+
+    // Guards the ready flags in each chunk and the count of tasks still running.
+    std::mutex mutex;
+    std::condition_variable chunkDone;
+    size_t pendingTasks = 0;
+};
+
+} // namespace slang
@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+// DeferredBodyParser.h
+// On-demand parsing of skimmed declaration bodies.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "slang/diagnostics/Diagnostics.h"
+#include "slang/parsing/Token.h"
+#include "slang/syntax/SyntaxNode.h"
+#include "slang/util/Bag.h"
+#include "slang/util/BumpAllocator.h"
+
+namespace slang {
+
+struct ParserOptions;
+
+/// DeferredBodyParser - Parses the bodies of declarations that the parser only skimmed.
+///
+/// When ParserOptions::skimBodies is set, the parser saves the tokens of each module,
+/// interface, program, function and task body instead of parsing them, and creates one
+/// of these to parse them later. A body gets parsed the first time one of its
+/// declaration's children is requested through SyntaxNode (which includes visiting and
+/// printing it), or when SyntaxNode::parseSkimmedBody is called.
+///
+/// The syntax tree takes ownership of this, since the nodes and diagnostics produced by
+/// parsing the bodies live here. Bodies of different nodes in the same tree can be
+/// parsed from different threads, but the first access to any one node must not race
+/// with other accesses to it.
+class DeferredBodyParser {
+public:
+    /// What the parser noted about a module body while skimming it.
+    struct SkimInfo {
+        /// The names of definitions that might be instantiated in the body. This can
+        /// include names that turn out to be something else, such as parameterized classes.
+        span<const string_view> instantiatedNames;
+
+        /// Whether the body declares nested modules, interfaces or programs.
+        bool hasNestedDefinitions = false;
+    };
+
+    /// Creates a deferred body parser that will parse with the given options.
+    explicit DeferredBodyParser(const ParserOptions& options);
+
+    DeferredBodyParser(const DeferredBodyParser&) = delete;
+    DeferredBodyParser& operator=(const DeferredBodyParser&) = delete;
+
+    /// Parses the body of @a node if it was skimmed and hasn't been parsed yet.
+    static void parse(const SyntaxNode& node);
+
+    /// If the body of @a node was skimmed and hasn't been parsed yet, returns what the
+    /// parser noted about it while skimming. Otherwise returns null.
+    static const SkimInfo* getSkimInfo(const SyntaxNode& node);
+
+    /// Parses every body skimmed so far that hasn't been parsed yet.
+    void parseAll();
+
+    /// Moves any diagnostics found while parsing bodies to the end of @a target.
+    void takeDiagnostics(Diagnostics& target);
+
+private:
+    friend class Parser;
+
+    // A declaration node, along with the tokens of its body, up to and including
+    // the end keyword.
+    template<typename T>
+    struct Deferred : public T {
+        template<typename... Args>
+        Deferred(DeferredBodyParser& owner, span<Token> body, const SkimInfo& info,
+                 Args&&... args) :
+            T(std::forward<Args>(args)...),
+            owner(owner), body(body), info(info) {}
+
+        DeferredBodyParser& owner;
+        span<Token> body;
+        SkimInfo info;
+    };
+
+    template<typename T, typename... Args>
+    T& create(BumpAllocator& nodeAlloc, span<Token> body, const SkimInfo& info,
+              Args&&... args) {
+        T* node = nodeAlloc.emplace<Deferred<T>>(*this, body, info, std::forward<Args>(args)...);
+        node->skimmed = true;
+
+        std::unique_lock lock(mutex);
+        skimmedNodes.push_back(node);
+        return *node;
+    }
+
+    void parseBody(SyntaxNode& node, span<const Token> body);
+
+    mutable std::mutex mutex;
+    BumpAllocator alloc;
+    Diagnostics diagnostics;
+    Bag options;
+    std::vector<SyntaxNode*> skimmedNodes;
+};
+
+} // namespace slang
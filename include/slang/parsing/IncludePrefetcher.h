@@ -0,0 +1,72 @@
+//------------------------------------------------------------------------------
+// IncludePrefetcher.h
+// Speculative background loading of included files.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <unordered_set>
+
+#include "slang/text/SourceManager.h"
+#include "slang/util/SmallVector.h"
+
+namespace slang {
+
+class ThreadPool;
+
+/// IncludePrefetcher - Loads include files before the preprocessor asks for them.
+///
+/// Given a source buffer, the prefetcher does a quick scan of its raw text for
+/// `include directives (skipping over comments and strings) and starts loading
+/// each named file into the SourceManager on a thread pool. Files found this way
+/// are scanned in turn, so by the time the preprocessor reaches an include the
+/// file is usually already resident and its location already resolved.
+///
+/// The scan doesn't know about macros or conditional directives, so it may load
+/// files that end up never being used; that's harmless, just wasted work.
+class IncludePrefetcher {
+public:
+    IncludePrefetcher(SourceManager& sourceManager, ThreadPool& threadPool);
+
+    /// Cancels any prefetching that hasn't started yet and waits for
+    /// work that's already in flight.
+    ~IncludePrefetcher();
+
+    IncludePrefetcher(const IncludePrefetcher&) = delete;
+    IncludePrefetcher& operator=(const IncludePrefetcher&) = delete;
+
+    /// Starts prefetching all of the files included by the given buffer.
+    void prefetch(SourceBuffer buffer);
+
+    /// The name of an included file found by @a findIncludes.
+    struct IncludeName {
+        /// The path, without its surrounding quotes or angle brackets.
+        string_view path;
+
+        /// Whether this was a system include (used angle brackets).
+        bool isSystem;
+    };
+
+    /// Scans the given text for `include directives that name a file directly,
+    /// skipping over comments and string literals.
+    static void findIncludes(string_view text, SmallVector<IncludeName>& results);
+
+private:
+    void scan(string_view text, const fs::path* directory);
+    void load(const fs::path* directory, IncludeName name);
+
+    SourceManager& sourceManager;
+    ThreadPool& threadPool;
+
+    // Guards all of the state below.
+    std::mutex mutex;
+    std::condition_variable allDone;
+    std::unordered_set<const char*> scannedBuffers;
+    size_t pendingTasks = 0;
+    bool cancelled = false;
+};
+
+} // namespace slang
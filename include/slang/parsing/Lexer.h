@@ -23,6 +23,21 @@ struct LexerOptions {
     /// The maximum number of errors that can occur before the rest of the source
     /// buffer is skipped.
     uint32_t maxErrors = 16;
+
+    /// If set to true, whitespace and comments are not kept as trivia. Each token instead
+    /// gets at most one placeholder trivia that records whether it was separated from the
+    /// previous token by whitespace or by a line break, which is all the preprocessor and
+    /// parser need to behave the same. This saves a lot of memory for pipelines that only
+    /// care about diagnostics and elaboration, but it means that:
+    /// - SyntaxPrinter output no longer matches the source text; comments are gone and
+    ///   whitespace is normalized (the output is still valid, equivalent source);
+    /// - trivia text no longer comes from the source buffer, so offsets computed by
+    ///   walking back from a token through its trivia are not meaningful;
+    /// - runs of whitespace inside stringified macro arguments collapse to one space.
+    /// Tokens preceded on the same line by a comment that affects preprocessing (a block
+    /// comment spanning lines, or a line comment ending in a line continuation) keep all
+    /// of their trivia as is.
+    bool discardTrivia = false;
 };
 
 /// The Lexer is responsible for taking source text and chopping it up into tokens.
@@ -45,6 +60,13 @@ public:
     /// an infinite stream of EndOfFile tokens will be generated
     Token lex(KeywordVersion keywordVersion = getDefaultKeywordVersion());
 
+    /// Lexes the next token from the source code after first skipping over the text of an
+    /// inactive conditional compilation region. Only comments, strings and directives are
+    /// recognized while skipping; everything up to the `else, `elsif or `endif that ends the
+    /// region (nested conditionals are skipped whole) is attached to the returned token as a
+    /// single DisabledText trivia.
+    Token lexDisabledRegion(KeywordVersion keywordVersion = getDefaultKeywordVersion());
+
     BufferID getBufferID() const;
     BumpAllocator& getAllocator() { return alloc; }
     Diagnostics& getDiagnostics() { return diagnostics; }
@@ -66,9 +88,14 @@ public:
                             KeywordVersion keywordVersion, SmallVector<Token>& results);
 
 private:
+    friend class CachedLexer;
+    friend class ChunkedLexer;
+    friend class SyntaxTree;
+
     Lexer(BufferID bufferId, string_view source, const char* startPtr, BumpAllocator& alloc,
           Diagnostics& diagnostics, LexerOptions options);
 
+    Token lex(SmallVector<Trivia>& triviaBuffer, KeywordVersion keywordVersion);
     TokenKind lexToken(Token::Info* info, KeywordVersion keywordVersion);
     TokenKind lexNumericLiteral(Token::Info* info);
     TokenKind lexEscapeSequence(Token::Info* info);
@@ -81,11 +108,13 @@ private:
     bool lexTimeLiteral(Token::Info* info);
 
     void lexTrivia(SmallVector<Trivia>& triviaBuffer);
+    span<Trivia const> summarizeTrivia(const SmallVector<Trivia>& triviaBuffer);
 
     void scanBlockComment(SmallVector<Trivia>& triviaBuffer);
     void scanLineComment(SmallVector<Trivia>& triviaBuffer);
     void scanWhitespace(SmallVector<Trivia>& triviaBuffer);
     void scanIdentifier();
+    void scanDisabledRegion();
     void scanUnsignedNumber(uint64_t& value, int& digits);
     bool scanExponent(uint64_t& value, bool& negative);
 
@@ -6,7 +6,10 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <memory>
+
 #include "slang/numeric/VectorBuilder.h"
+#include "slang/parsing/DeferredBodyParser.h"
 #include "slang/parsing/ParserBase.h"
 #include "slang/parsing/Token.h"
 #include "slang/syntax/AllSyntax.h"
@@ -43,6 +46,24 @@ struct ParserOptions {
     /// The maximum depth of nested language constructs (statements, exceptions) before
     /// we give up for fear of stack overflow.
     uint32_t maxRecursionDepth = 1024;
+
+    /// If set to true, the digits of integer vector literals are checked for errors
+    /// but not converted into values; that happens on demand, the first time the
+    /// value is requested from the token. This saves time for tools that only look
+    /// at the shape of the syntax tree and never at literal values.
+    bool lazyIntegerLiterals = false;
+
+    /// If set to true, the bodies of modules, interfaces, programs, functions and tasks
+    /// are only skimmed to find where they end, and get parsed the first time something
+    /// asks for them (see DeferredBodyParser). Tools that only need declarations, or only
+    /// some of the bodies, can save most of the cost of parsing the rest this way.
+    /// Syntax errors in a body aren't reported until it has been parsed.
+    ///
+    /// A Compilation only parses the bodies of definitions and subroutines that it uses.
+    /// When it picks the top-level modules it counts a module as instantiated if its name
+    /// appears in an instantiation anywhere in a skimmed body, even inside a generate
+    /// block that would not be elaborated.
+    bool skimBodies = false;
 };
 
 /// Implements a full syntax parser for SystemVerilog.
@@ -50,9 +71,21 @@ class Parser : ParserBase {
 public:
     explicit Parser(Preprocessor& preprocessor, const Bag& options = {});
 
+    /// Creates a parser that reads from a list of tokens that have already been
+    /// preprocessed, instead of from a preprocessor.
+    Parser(span<const Token> tokens, BumpAllocator& alloc, Diagnostics& diagnostics,
+           const Bag& options = {});
+
     /// Parse a whole compilation unit.
     CompilationUnitSyntax& parseCompilationUnit();
 
+    /// Parses compilation unit members until reaching a token at or past @a location,
+    /// or the end of the input, and then consumes that token and returns it in
+    /// @a endToken. Any tokens skipped right before it are attached to the returned
+    /// token as trivia. If the members are nested too deeply to parse, returns an
+    /// empty list and an invalid @a endToken.
+    span<MemberSyntax*> parseMembersUntil(SourceLocation location, Token& endToken);
+
     /// Parse an expression / statement / module / class / name.
     /// These are mostly for testing; only use if you know that the
     /// source stream is currently looking at one of these.
@@ -75,6 +108,11 @@ public:
     /// Gets the EndOfFile token, if one has been consumed. Otherwise returns an empty token.
     Token getEOFToken();
 
+    /// Takes ownership of what's needed to parse the bodies skimmed by this parser,
+    /// which the caller must keep alive for as long as it uses the nodes it has parsed.
+    /// Returns null if nothing has been skimmed.
+    std::unique_ptr<DeferredBodyParser> takeDeferredBodies();
+
 private:
     ExpressionSyntax& parseMinTypMaxExpression();
     ExpressionSyntax& parsePrimaryExpression();
@@ -160,6 +198,7 @@ private:
     ModuleHeaderSyntax& parseModuleHeader();
     ParameterPortListSyntax* parseParameterPortList();
     ModuleDeclarationSyntax& parseModule(span<AttributeInstanceSyntax*> attributes);
+    span<MemberSyntax*> parseModuleMembers(TokenKind endKind, Token& end);
     MemberSyntax& parseModportSubroutinePortList(span<AttributeInstanceSyntax*> attributes);
     MemberSyntax& parseModportPort();
     ModportItemSyntax& parseModportItem();
@@ -239,6 +278,8 @@ private:
     bool isPlainPortName();
     bool scanDimensionList(uint32_t& index);
     bool scanQualifiedName(uint32_t& index);
+    span<Token> skimBody(TokenKind endKind, bool isBlockItems,
+                         DeferredBodyParser::SkimInfo& info);
 
     void errorIfAttributes(span<AttributeInstanceSyntax*> attributes, DiagCode code);
 
@@ -263,6 +304,8 @@ private:
     using ExpressionOptions = detail::ExpressionOptions;
 
     ExpressionSyntax& parseSubExpression(bitmask<ExpressionOptions> options, int precedence);
+    ExpressionSyntax& parseBinaryExpression(bitmask<ExpressionOptions>& options, int precedence,
+                                            bool& allowConditional);
     ExpressionSyntax& parsePrefixExpression(bitmask<ExpressionOptions> options, SyntaxKind opKind);
 
     template<bool (*IsEnd)(TokenKind)>
@@ -275,9 +318,14 @@ private:
     template<bool (*IsEnd)(TokenKind)>
     bool scanTypePart(uint32_t& index, TokenKind start, TokenKind end);
 
+    friend class DeferredBodyParser;
+
     SyntaxFactory factory;
     ParserOptions parseOptions;
 
+    // Created the first time a body is skimmed.
+    std::unique_ptr<DeferredBodyParser> deferredBodies;
+
     // Scratch space for building up integer vector literals.
     VectorBuilder vectorBuilder;
     size_t recursionDepth = 0;
@@ -14,6 +14,7 @@
 
 namespace slang {
 
+class BumpAllocator;
 class Preprocessor;
 
 /// Base class for the Parser, which contains helpers and language-agnostic parsing routines.
@@ -21,6 +22,7 @@ class Preprocessor;
 class ParserBase {
 protected:
     ParserBase(Preprocessor& preprocessor);
+    ParserBase(span<const Token> tokens, BumpAllocator& alloc, Diagnostics& diagnostics);
 
     Diagnostics& getDiagnostics();
     Diagnostic& addDiag(DiagCode code, SourceLocation location);
@@ -41,7 +43,7 @@ protected:
     /// Helper class that maintains a sliding window of tokens, with lookahead.
     class Window {
     public:
-        explicit Window(Preprocessor& source) : tokenSource(source) {
+        explicit Window(Preprocessor* source) : tokenSource(source) {
             capacity = 32;
             buffer = new Token[capacity];
         }
@@ -52,8 +54,13 @@ protected:
         Window(const Window&) = delete;
         Window& operator=(const Window&) = delete;
 
-        // the source of all tokens
-        Preprocessor& tokenSource;
+        // the source of all tokens; if null, tokens come from the replay list instead
+        Preprocessor* tokenSource;
+
+        // tokens that were read ahead of time, and what to return once they run out
+        span<const Token> replayTokens;
+        Token replayEnd;
+        span<const Token>::index_type replayIndex = 0;
 
         // a buffer of tokens for implementing lookahead
         Token* buffer = nullptr;
@@ -204,6 +211,7 @@ protected:
 private:
     void prependSkippedTokens(Token& node);
 
+    Diagnostics& diagnostics;
     Window window;
     SmallVectorSized<Token, 4> skippedTokens;
 };
@@ -7,10 +7,15 @@
 #pragma once
 
 #include <deque>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "slang/diagnostics/Diagnostics.h"
+#include "slang/parsing/ChunkedLexer.h"
+#include "slang/parsing/IncludePrefetcher.h"
 #include "slang/parsing/Lexer.h"
+#include "slang/parsing/TokenStreamCache.h"
 #include "slang/parsing/Token.h"
 #include "slang/syntax/SyntaxNode.h"
 #include "slang/text/SourceLocation.h"
@@ -44,6 +49,44 @@ struct PreprocessorOptions {
 
     /// A set of macro names to undefine at the start of file preprocessing.
     std::vector<std::string> undefines;
+
+    /// If set, files named by `include directives are loaded speculatively on this
+    /// thread pool as soon as the file containing them is pushed, so that they're
+    /// already in memory when the preprocessor gets to them. This must not be the
+    /// same pool that the preprocessor itself is running on.
+    ThreadPool* prefetchPool = nullptr;
+
+    /// If set, the preprocessor remembers which files are wrapped entirely in a classic
+    /// `ifndef / `define / `endif include guard, and later includes of such a file while
+    /// its guard macro is still defined are skipped without being lexed at all. The only
+    /// visible difference is that the (disabled) text of the skipped file doesn't show up
+    /// as trivia in the token stream, so this is off by default for tools that print it.
+    bool skipGuardedIncludes = false;
+
+    /// If set, source buffers bigger than twice @a lexChunkSize are split into chunks
+    /// that are lexed ahead of time in parallel on this thread pool (see ChunkedLexer).
+    /// This must not be the same pool that the preprocessor itself is running on.
+    ThreadPool* lexPool = nullptr;
+
+    /// The rough size of each chunk of a buffer lexed on @a lexPool.
+    size_t lexChunkSize = 8 * 1024 * 1024;
+
+    /// If set, the tokens of each file pulled in by an `include directive are kept in
+    /// this cache, and later includes of the same file (by this or any other preprocessor
+    /// sharing the cache) replay them instead of lexing the file again.
+    TokenStreamCache* tokenCache = nullptr;
+};
+
+/// A file that was opened by an `include directive.
+struct IncludedFile {
+    /// The buffer the file was loaded into.
+    SourceBuffer buffer;
+
+    /// The name of the file as written in the directive, without its delimiters.
+    string_view name;
+
+    /// Whether the name was written in angle brackets, as a system include.
+    bool isSystem = false;
 };
 
 /// Preprocessor - Interface between lexer and parser
@@ -96,6 +139,10 @@ public:
     /// will return TokenKind::Unknown.
     TokenKind getDefaultNetType() const { return defaultNetType; }
 
+    /// Gets every file opened by an `include directive so far, in the order they
+    /// were included, including ones that were skipped by an include guard.
+    span<const IncludedFile> getIncludedFiles() const { return includedFiles; }
+
     /// Gets the next token in the stream, after applying preprocessor rules.
     Token next();
 
@@ -103,10 +150,16 @@ public:
     BumpAllocator& getAllocator() const { return alloc; }
     Diagnostics& getDiagnostics() const { return diagnostics; }
 
+    /// Looks for a classic include guard in the given source text: the file must start
+    /// (after whitespace and comments) with `ifndef NAME followed by `define NAME, and the
+    /// matching `endif must be the last thing in the file other than whitespace and comments.
+    /// @return the name of the guard macro, or an empty string if the text isn't guarded.
+    static string_view findIncludeGuard(string_view text);
+
 private:
     // Internal methods to grab and handle the next token
     Token nextProcessed();
-    Token nextRaw();
+    Token nextRaw(bool disabledRegion = false);
 
     // directive handling methods
     Token handleDirectives(Token token);
@@ -127,6 +180,14 @@ private:
     Trivia handleEndKeywordsDirective(Token directive);
     Trivia createSimpleDirective(Token directive);
 
+    // Determines whether including the given buffer can be skipped because
+    // its include guard is already defined
+    bool isIncludeGuarded(SourceBuffer buffer);
+
+    // Pushes the lexer for an included file, replaying its tokens
+    // from the token cache if there is one
+    void pushInclude(SourceBuffer buffer);
+
     // Determines whether the else branch of a conditional directive should be taken
     bool shouldTakeElseBranch(SourceLocation location, bool isElseIf, string_view macroName);
 
@@ -253,8 +314,38 @@ private:
     PreprocessorOptions options;
     LexerOptions lexerOptions;
 
+    // An entry in the lexer stack: a plain lexer, one that lexes very large
+    // buffers ahead on the lex pool, or one replaying a cached include.
+    struct LexerEntry {
+        Lexer* lexer = nullptr;
+        ChunkedLexer* chunked = nullptr;
+        CachedLexer* cached = nullptr;
+
+        Token lex(KeywordVersion keywordVersion) {
+            if (chunked)
+                return chunked->lex(keywordVersion);
+            if (cached)
+                return cached->lex(keywordVersion);
+            return lexer->lex(keywordVersion);
+        }
+
+        Token lexDisabledRegion(KeywordVersion keywordVersion) {
+            if (chunked)
+                return chunked->lexDisabledRegion(keywordVersion);
+            if (cached)
+                return cached->lexDisabledRegion(keywordVersion);
+            return lexer->lexDisabledRegion(keywordVersion);
+        }
+    };
+
     // stack of active lexers; each `include pushes a new lexer
-    std::deque<Lexer*> lexerStack;
+    std::deque<LexerEntry> lexerStack;
+
+    // owns the chunked lexers in the lexer stack
+    std::vector<std::unique_ptr<ChunkedLexer>> chunkedLexers;
+
+    // loads include files in the background, if requested
+    std::unique_ptr<IncludePrefetcher> includePrefetcher;
 
     // keep track of nested processor branches (ifdef, ifndef, else, elsif, endif)
     std::deque<BranchEntry> branchStack;
@@ -262,6 +353,13 @@ private:
     // map from macro name to macro definition
     std::unordered_map<string_view, MacroDef> macros;
 
+    // map from the text of each included buffer to the name of its include guard
+    // macro, or an empty string if it doesn't have one
+    std::unordered_map<const char*, string_view> includeGuards;
+
+    // every file opened by an `include directive, in order
+    std::vector<IncludedFile> includedFiles;
+
     // list of expanded macro tokens to drain before continuing with active lexer
     SmallVectorSized<Token, 16> expandedTokens;
     Token* currentMacroToken = nullptr;
@@ -6,11 +6,12 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <mutex>
+
 #include "slang/numeric/SVInt.h"
 #include "slang/numeric/Time.h"
 #include "slang/text/SourceLocation.h"
 #include "slang/util/SmallVector.h"
-#include "slang/util/StringTable.h"
 #include "slang/util/Util.h"
 
 namespace slang {
@@ -127,47 +128,98 @@ static_assert(sizeof(Trivia) == 16);
 class Token {
 public:
     /// Heap-allocated info block.
-    struct Info {
+    ///
+    /// There's one of these for every token in the program, so it's kept compact:
+    /// text is stored as a pointer and 32-bit length instead of a full string_view,
+    /// and the kind-specific data is a tagged union. Numeric values are the only
+    /// large kind of data, so they live in a side allocation that only numeric
+    /// tokens pay for (and that copies of the info block share).
+    class Info {
+    public:
+        /// The digits of an integer vector literal that haven't been decoded yet.
+        /// The digits themselves are the token's raw text, and the base and sign
+        /// are stored in the numeric flags.
+        struct UndecodedInt {
+            /// Holds the value once it has been decoded. The width, sign and any
+            /// words the value needs are set up when the literal is parsed.
+            mutable SVIntStorage storage;
+
+            /// The size given for the literal, or zero if it was unsized.
+            bitwidth_t size;
+        };
+
         /// Numeric-related information.
         struct NumericLiteralInfo {
-            std::variant<logic_t, double, SVIntStorage> value;
+            std::variant<logic_t, double, SVIntStorage, UndecodedInt> value;
             NumericTokenFlags numericFlags;
-        };
-
-        /// Leading trivia.
-        span<slang::Trivia const> trivia;
 
-        /// The raw source span.
-        string_view rawText;
+            /// Guards decoding an UndecodedInt value, which happens at most once.
+            mutable std::once_flag decodeFlag;
+        };
 
         /// The original location in the source text (or a macro location
         /// if the token was generated during macro expansion).
         SourceLocation location;
 
-        /// Extra kind-specific data associated with the token.
-        /// string_view: The nice text of a string literal.
-        /// SyntaxKind: The kind of a directive token.
-        /// IdentifierType: The kind of an identifer token.
-        /// NumericLiteralInfo: Info for numeric tokens.
-        std::variant<string_view, SyntaxKind, IdentifierType, NumericLiteralInfo> extra;
-
-        /// Various token flags.
-        bitmask<TokenFlags> flags;
-
         Info() = default;
         Info(span<Trivia const> trivia, string_view rawText, SourceLocation location,
              bitmask<TokenFlags> flags = TokenFlags::None);
 
-        void setBit(logic_t value);
-        void setReal(double value);
-        void setInt(BumpAllocator& alloc, const SVInt& value);
-        void setNumFlags(LiteralBase base, bool isSigned);
-        void setTimeUnit(TimeUnit unit);
+        /// Leading trivia.
+        span<Trivia const> trivia() const { return { triviaPtr, triviaCount }; }
+
+        /// The raw source span.
+        string_view rawText() const { return { rawTextPtr, rawTextLength }; }
 
-        const string_view& stringText() const { return std::get<string_view>(extra); }
-        const SyntaxKind& directiveKind() const { return std::get<SyntaxKind>(extra); }
-        const IdentifierType& idType() const { return std::get<IdentifierType>(extra); }
-        const NumericLiteralInfo& numInfo() const { return std::get<NumericLiteralInfo>(extra); }
+        void setTrivia(span<Trivia const> trivia);
+        void setRawText(string_view text);
+
+        /// Setters for the extra kind-specific data associated with the token.
+        void setStringText(string_view text);
+        void setDirectiveKind(SyntaxKind kind);
+        void setIdType(IdentifierType type);
+        void setBit(BumpAllocator& alloc, logic_t value);
+        void setReal(BumpAllocator& alloc, double value);
+        void setInt(BumpAllocator& alloc, const SVInt& value);
+        void setUndecodedInt(BumpAllocator& alloc, LiteralBase base, bool isSigned,
+                             bitwidth_t size, bitwidth_t width, bool hasUnknown);
+        void setNumFlags(BumpAllocator& alloc, LiteralBase base, bool isSigned);
+        void setTimeUnit(BumpAllocator& alloc, TimeUnit unit);
+
+        /// The "nice" text of a string literal.
+        string_view stringText() const;
+
+        /// The kind of a directive token.
+        SyntaxKind directiveKind() const;
+
+        /// The kind of an identifier token.
+        IdentifierType idType() const;
+
+        /// Info for numeric tokens.
+        const NumericLiteralInfo& numInfo() const;
+
+    private:
+        enum class ExtraKind : uint8_t { None, StringText, Directive, Identifier, Numeric };
+
+        NumericLiteralInfo& getOrAddNumInfo(BumpAllocator& alloc);
+
+        const Trivia* triviaPtr = nullptr;
+        const char* rawTextPtr = nullptr;
+        union {
+            const char* stringTextPtr;
+            SyntaxKind directive;
+            IdentifierType identifier;
+            NumericLiteralInfo* numeric;
+        } extra = { nullptr };
+        uint32_t triviaCount = 0;
+        uint32_t rawTextLength = 0;
+        uint32_t stringTextLength = 0;
+        ExtraKind extraKind = ExtraKind::None;
+
+    public:
+        /// Various token flags. This comes last so that it packs in
+        /// alongside the other small fields.
+        bitmask<TokenFlags> flags;
     };
 
     /// The kind of the token; this is not in the info block because
@@ -182,7 +234,7 @@ public:
 
     SourceRange range() const;
     SourceLocation location() const { return info->location; }
-    span<Trivia const> trivia() const { return info->trivia; }
+    span<Trivia const> trivia() const { return info->trivia(); }
     const Info* getInfo() const { return info; }
 
     /// Value text is the "nice" lexed version of certain tokens;
@@ -197,6 +249,8 @@ public:
 
     /// Data accessors for specific kinds of tokens.
     /// These will generally assert if the kind is wrong.
+    /// Integer literals whose digits were left undecoded by the parser are
+    /// decoded by the first call here; later calls return the saved value.
     SVInt intValue() const;
     double realValue() const;
     logic_t bitValue() const;
@@ -218,6 +272,7 @@ public:
 private:
     const Info* info;
 };
+static_assert(sizeof(Token::Info) == 48);
 
 /// Different restricted sets of keywords that can be set using the
 /// `begin_keywords directive. The values of the enum correspond to indexes to
@@ -237,7 +292,10 @@ TokenKind getSystemKeywordKind(string_view text);
 string_view getTokenKindText(TokenKind kind);
 KeywordVersion getDefaultKeywordVersion();
 optional<KeywordVersion> getKeywordVersion(string_view text);
-const StringTable<TokenKind>* getKeywordTable(KeywordVersion version);
+
+/// Gets the kind of keyword that @a text represents in the given version of the
+/// language, or TokenKind::Unknown if it isn't a keyword in that version.
+TokenKind getKeywordKind(string_view text, KeywordVersion version);
 
 /// This checks all keywords, regardless of the current keyword table.  Should
 /// only be used when it is ok to get a false positive for a keyword that may
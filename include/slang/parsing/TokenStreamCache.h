@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------------
+// TokenStreamCache.h
+// Reuse of lexed tokens across includes of the same file.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <flat_hash_map.hpp>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "slang/parsing/Lexer.h"
+#include "slang/text/SourceManager.h"
+
+namespace slang {
+
+/// TokenStreamCache - Remembers the tokens lexed from included files.
+///
+/// Headers like macro libraries and typedef packages tend to be included into every
+/// compilation unit, often without include guards. The first time such a file is
+/// included its whole text is lexed and the tokens kept here; every include of it after
+/// that just replays those tokens with locations in the new include's buffer (see
+/// CachedLexer), so only preprocessing is repeated, not lexing.
+///
+/// Files that produce any lexer diagnostics aren't cached, so that their errors still get
+/// reported at each include the same as before.
+///
+/// The cache is safe to share between preprocessors on different threads. Each file is
+/// cached with the LexerOptions and keyword version of whoever included it first; includes
+/// that use different ones lex the file normally instead. Tokens handed out by replaying
+/// refer to memory owned by the cache, so it must outlive any syntax trees built from them.
+class TokenStreamCache {
+public:
+    /// The tokens of one file, lexed from start to end without any conditional
+    /// regions disabled.
+    struct Entry {
+        /// The tokens, with locations in the buffer the file was first lexed from.
+        std::vector<Token> tokens;
+
+        /// The keyword version the tokens were lexed with.
+        KeywordVersion keywordVersion;
+
+        /// The options the tokens were lexed with.
+        LexerOptions options;
+    };
+
+    TokenStreamCache() = default;
+
+    TokenStreamCache(const TokenStreamCache&) = delete;
+    TokenStreamCache& operator=(const TokenStreamCache&) = delete;
+
+    /// Gets the cached tokens for the file in @a buffer, lexing it with the given
+    /// @a keywordVersion and @a options first if this is the first time it's been seen.
+    /// Returns null if the file can't be cached, or was cached with a different
+    /// keyword version or options, in which case the caller should lex it normally.
+    const Entry* getOrAdd(SourceBuffer buffer, KeywordVersion keywordVersion,
+                          const LexerOptions& options);
+
+    /// Gets the number of files whose tokens have been cached.
+    size_t size() const;
+
+private:
+    static bool matches(const Entry* entry, KeywordVersion keywordVersion,
+                        const LexerOptions& options);
+
+    // Guards all of the state below.
+    mutable std::mutex mutex;
+
+    // Keyed by the text of each file, which all buffers for the same file share.
+    // A null entry marks a file that can't be cached.
+    flat_hash_map<const char*, std::unique_ptr<Entry>> entries;
+    BumpAllocator alloc;
+};
+
+/// CachedLexer - Replays the tokens of a TokenStreamCache entry as if they were being
+/// lexed from a new buffer of the same file.
+///
+/// The cached tokens assume that no conditional regions are disabled and that the
+/// keyword version doesn't change. When asked for anything else a real Lexer takes over
+/// from the last token handed out, until it lexes a token that starts at the same place
+/// as one of the cached tokens, after which replaying picks up again.
+class CachedLexer {
+public:
+    CachedLexer(const TokenStreamCache::Entry& entry, SourceBuffer buffer,
+                BumpAllocator& alloc, Diagnostics& diagnostics, LexerOptions options);
+
+    /// Gets the next token, as Lexer::lex does.
+    Token lex(KeywordVersion keywordVersion);
+
+    /// Gets the next token after an inactive region, as Lexer::lexDisabledRegion does.
+    Token lexDisabledRegion(KeywordVersion keywordVersion);
+
+private:
+    Token next(KeywordVersion keywordVersion, bool disabled);
+    void startSerial();
+    void tryResync(Token token);
+
+    const TokenStreamCache::Entry& entry;
+    SourceBuffer buffer;
+    BumpAllocator& alloc;
+    Diagnostics& diagnostics;
+    LexerOptions options;
+
+    size_t index = 0;
+
+    // The offset just past the last token handed out, which is where
+    // the real lexer needs to start if we fall back to it.
+    size_t lastEnd = 0;
+    Lexer* serialLexer = nullptr;
+};
+
+} // namespace slang
@@ -45,17 +45,30 @@ public:
 /// to form a node in the design hierarchy.
 class DefinitionSymbol : public Symbol, public Scope {
 public:
-    span<const ParameterSymbol* const> parameters;
     DefinitionKind definitionKind;
 
     DefinitionSymbol(Compilation& compilation, string_view name, SourceLocation loc,
                      DefinitionKind definitionKind);
 
+    /// Gets the parameters of the definition, from both its parameter port list and its body.
+    span<const ParameterSymbol* const> getParameters() const {
+        addSkimmedBody();
+        return parameters;
+    }
+
     const SymbolMap& getPortMap() const {
         ensureElaborated();
         return *portMap;
     }
 
+    /// Indicates whether every parameter of the definition has a default value.
+    bool hasAllDefaultedParams() const;
+
+    /// Indicates whether the parser skimmed the body of this definition (see
+    /// ParserOptions::skimBodies) and the body's members haven't been needed yet.
+    /// Looking at the members or parameters of the definition adds them.
+    bool hasSkimmedBody() const { return skimmedBody; }
+
     void toJson(json& j) const;
 
     static DefinitionSymbol& fromSyntax(Compilation& compilation,
@@ -63,7 +76,14 @@ public:
     static bool isKind(SymbolKind kind) { return kind == SymbolKind::Definition; }
 
 private:
+    friend class Scope;
+
+    void addSkimmedBody() const;
+    void addBodyMembers(const ModuleDeclarationSyntax& syntax);
+
+    span<const ParameterSymbol* const> parameters;
     SymbolMap* portMap;
+    mutable bool skimmedBody = false;
 };
 
 /// Base class for module, interface, and program instance symbols.
@@ -280,6 +280,10 @@ protected:
         getOrAddDeferredData().setPortConnections(connections);
     }
 
+    /// Makes sure the scope gets elaborated before its members are used, even if nothing
+    /// in it has been deferred yet.
+    void setNeedsElaboration() { getOrAddDeferredData(); }
+
     const Symbol* getLastMember() const { return lastMember; }
 
 private:
@@ -0,0 +1,56 @@
+//------------------------------------------------------------------------------
+// ParallelSyntaxTreeBuilder.h
+// Parses many source files at once on a thread pool.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "slang/syntax/SyntaxTree.h"
+
+namespace slang {
+
+/// ParallelSyntaxTreeBuilder - Builds syntax trees for a set of files concurrently.
+///
+/// Each file is parsed independently into its own SyntaxTree (with its own allocator)
+/// on a work-stealing thread pool. The resulting trees are always returned in the
+/// order their sources were added, regardless of which finished first, so the
+/// output is deterministic no matter how many threads are used.
+class ParallelSyntaxTreeBuilder {
+public:
+    /// Creates a new builder that loads sources from @a sourceManager and parses
+    /// them with the given @a options. A @a threadCount of zero means to use
+    /// one thread per hardware thread.
+    explicit ParallelSyntaxTreeBuilder(SourceManager& sourceManager, const Bag& options = {},
+                                       uint32_t threadCount = 0);
+
+    /// Adds a file to be loaded and parsed. If the file can't be loaded,
+    /// the corresponding entry in the result of @a build will be null.
+    void addFile(string_view path);
+
+    /// Adds an already loaded buffer to be parsed.
+    void addBuffer(const SourceBuffer& buffer);
+
+    /// Parses all of the added sources and returns the resulting syntax trees, in
+    /// the same order the sources were added. The builder is left empty afterward.
+    std::vector<std::shared_ptr<SyntaxTree>> build();
+
+private:
+    struct Source {
+        std::string path;
+        SourceBuffer buffer;
+    };
+
+    std::shared_ptr<SyntaxTree> parse(const Source& source) const;
+
+    SourceManager& sourceManager;
+    Bag options;
+    uint32_t threadCount;
+    std::vector<Source> sources;
+};
+
+} // namespace slang
@@ -121,6 +121,15 @@ public:
     /// Print the node and all of its children to a string.
     std::string toString() const;
 
+    /// Indicates whether the body of this node was skimmed instead of parsed
+    /// (see ParserOptions::skimBodies) and hasn't been parsed since.
+    bool isSkimmed() const { return skimmed; }
+
+    /// If the body of this node was skimmed, parses it now. Getting children through
+    /// the methods of this class does that automatically; code that reads the body
+    /// members of a declaration node directly needs to call this first.
+    void parseSkimmedBody() const;
+
     /// Get the first leaf token in this subtree.
     Token getFirstToken() const;
 
@@ -160,8 +169,22 @@ public:
 protected:
     explicit SyntaxNode(SyntaxKind kind) : kind(kind) {}
 
+    // A copy never has a skimmed body, since the saved tokens live only in the
+    // node the parser created. Copying happens when cloning, which gets the
+    // children through the original and so parses its body first.
+    SyntaxNode(const SyntaxNode& other) : parent(other.parent), kind(other.kind) {}
+    SyntaxNode& operator=(const SyntaxNode& other) {
+        parent = other.parent;
+        kind = other.kind;
+        return *this;
+    }
+
 private:
+    friend class DeferredBodyParser;
+
     ConstTokenOrSyntax getChild(uint32_t index) const;
+
+    bool skimmed = false;
 };
 
 class SyntaxListBase : public SyntaxNode {
@@ -0,0 +1,206 @@
+//------------------------------------------------------------------------------
+// SyntaxSerializer.h
+// Binary serialization of syntax trees.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <deque>
+#include <flat_hash_map.hpp>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "slang/parsing/Preprocessor.h"
+#include "slang/syntax/SyntaxNode.h"
+#include "slang/text/SourceManager.h"
+#include "slang/util/BumpAllocator.h"
+
+namespace slang {
+
+class Bag;
+class Diagnostic;
+class SyntaxTree;
+
+/// SyntaxSerializer - Writes syntax trees in the binary format used by cache files.
+///
+/// Most code should use SyntaxTree::writeCache instead of this. The format is compact
+/// rather than fast to access: nodes are written out in order with their children
+/// inline, integers are variable length, and text that comes from a source buffer is
+/// written as an offset into the buffer instead of being copied. Locations refer to
+/// a table of the buffers the tree uses, which records enough about each one (the
+/// path, a hash of the text and the include name of included files, the locations of
+/// macro expansions) to create them again when loading, and to notice if an included
+/// file has changed or an include would now find a different file.
+class SyntaxSerializer {
+public:
+    /// Serializes @a tree and appends the result to @a output. Returns false if the
+    /// tree can't be serialized; see SyntaxTree::writeCache for the requirements.
+    static bool serialize(SyntaxTree& tree, std::vector<char>& output);
+
+    /// Gets the key that SyntaxDeserializer checks serialized data against;
+    /// see SyntaxTree::getCacheKey.
+    static uint64_t getKey(const SourceBuffer& buffer, const Bag& options);
+
+private:
+    explicit SyntaxSerializer(const SourceManager& sourceManager);
+
+    uint32_t buffer(BufferID id);
+    void file(BufferID id, bool isMain);
+    void expansion(BufferID id);
+
+    void node(const SyntaxNode* node);
+    void children(const SyntaxNode& node);
+    void token(Token token);
+    void trivia(const Trivia& trivia);
+    void diagnostic(const Diagnostic& diag);
+    void location(SourceLocation location);
+    void string(string_view text);
+    void varint(uint64_t value);
+
+    const SourceManager& sourceManager;
+
+    // The include that found each of the tree's included files, keyed by its buffer.
+    flat_hash_map<uint32_t, const IncludedFile*> includes;
+
+    // The three sections of the output: text that isn't in any buffer, the buffer
+    // table, and the tree itself. Whichever one is being written is in @a out.
+    std::vector<char> strings;
+    std::vector<char> buffers;
+    std::vector<char> tree;
+    std::vector<char>* out = &tree;
+
+    // Index in the buffer table of each buffer written so far (starting at 1,
+    // since zero means no buffer), along with the extent of the text of each
+    // file buffer, keyed by where it starts, so that text in it can be written
+    // as an offset.
+    flat_hash_map<uint32_t, uint32_t> bufferIndices;
+    std::map<const char*, std::pair<const char*, uint32_t>> bufferTexts;
+
+    // Offsets of text already written to the strings section, and copies of
+    // any text written there that the tree doesn't own.
+    flat_hash_map<string_view, uint32_t> stringOffsets;
+    std::deque<std::string> ownedStrings;
+
+    // The buffer that the last text written to the tree section was in (or zero
+    // if it wasn't in one), the extent of that buffer, and where the text ended.
+    uint32_t lastSource = 0;
+    const char* lastSourceText = nullptr;
+    const char* lastSourceEnd = nullptr;
+    const char* lastEnd = nullptr;
+
+    uint32_t depth = 0;
+    bool ok = true;
+};
+
+/// SyntaxDeserializer - Reads syntax trees back from the format written by SyntaxSerializer.
+///
+/// Most code should use SyntaxTree::fromCache instead of this. Nodes are rebuilt in
+/// one pass through the data; all of their text points either into the buffers they
+/// came from or into the data itself, so the data has to stay alive as long as the
+/// tree does.
+class SyntaxDeserializer {
+public:
+    /// Thrown when the data being read is malformed.
+    struct CorruptDataException : public std::runtime_error {
+        using std::runtime_error::runtime_error;
+    };
+
+    /// A hash of the definitions of all syntax node types, which is part of the key.
+    /// This is generated along with the nodes, in AllSyntax.cpp.
+    static const uint64_t SchemaHash;
+
+    /// Loads a tree for @a buffer from serialized @a data, which is kept alive by
+    /// @a owner. Returns nullptr if the data was written for different text or
+    /// options, or if a file that got included while parsing it has changed.
+    /// Throws CorruptDataException if the data is malformed.
+    static std::shared_ptr<SyntaxTree> deserialize(std::shared_ptr<const char> owner,
+                                                   string_view data, const SourceBuffer& buffer,
+                                                   SourceManager& sourceManager,
+                                                   const Bag& options);
+
+private:
+    SyntaxDeserializer(string_view strings, BumpAllocator& alloc) :
+        strings(strings), alloc(alloc) {}
+
+    bool readBuffers(SourceManager& sourceManager, const SourceBuffer& mainBuffer);
+
+    SyntaxNode* readAnyNode();
+    SyntaxNode* createNode(SyntaxKind kind); // Note: implemented in AllSyntax.cpp
+    Token readToken();
+    Trivia readTrivia();
+    Diagnostic readDiagnostic();
+    SourceLocation readLocation();
+    string_view readString();
+    uint64_t readVarintSlow();
+    uint32_t readCount();
+
+    uint64_t readVarint() {
+        // Most values fit in a single byte.
+        if (ptr != end && !(*ptr & 0x80))
+            return (uint8_t)*ptr++;
+        return readVarintSlow();
+    }
+
+    template<typename T>
+    T* readOptionalNode() {
+        SyntaxNode* node = readAnyNode();
+        if (node && !T::isKind(node->kind))
+            throw CorruptDataException("Unexpected syntax kind");
+        return static_cast<T*>(node);
+    }
+
+    template<typename T>
+    T& readNode() {
+        T* node = readOptionalNode<T>();
+        if (!node)
+            throw CorruptDataException("Missing syntax node");
+        return *node;
+    }
+
+    template<typename T>
+    SyntaxList<T> readList() {
+        uint32_t count = readCount();
+        T** elements = (T**)alloc.allocate(sizeof(T*) * count, alignof(T*));
+        for (uint32_t i = 0; i < count; i++)
+            elements[i] = &readNode<T>();
+        return span<T*>(elements, count);
+    }
+
+    template<typename T>
+    SeparatedSyntaxList<T> readSeparatedList() {
+        uint32_t count = readCount();
+        auto elements = (TokenOrSyntax*)alloc.allocate(sizeof(TokenOrSyntax) * count,
+                                                       alignof(TokenOrSyntax));
+        for (uint32_t i = 0; i < count; i++) {
+            if (i % 2 == 0)
+                new (&elements[i]) TokenOrSyntax(&readNode<T>());
+            else
+                new (&elements[i]) TokenOrSyntax(readToken());
+        }
+        return span<TokenOrSyntax>(elements, count);
+    }
+
+    TokenList readTokenList();
+
+    string_view strings;
+    const char* ptr = nullptr;
+    const char* end = nullptr;
+    BumpAllocator& alloc;
+
+    // The buffers each index in the buffer table refers to, starting at 1,
+    // and which of them were included files.
+    std::vector<SourceBuffer> buffers;
+    std::vector<IncludedFile> includedFiles;
+
+    // Where the last text that was read came from; see SyntaxSerializer::string.
+    uint64_t lastSource = 0;
+    uint32_t lastOffset = 0;
+    uint32_t lastLength = 0;
+
+    uint32_t depth = 0;
+};
+
+} // namespace slang
@@ -17,6 +17,18 @@
 
 namespace slang {
 
+/// A replacement of a range of text in a source buffer; see SyntaxTree::fromEdits.
+struct TextEdit {
+    /// The offset in the original text of the first character to replace.
+    uint32_t offset = 0;
+
+    /// The number of characters to replace, or zero to just insert text.
+    uint32_t length = 0;
+
+    /// The text to put in their place.
+    string_view newText;
+};
+
 /// The SyntaxTree is the easiest way to interface with the lexer / preprocessor /
 /// parser stack. Give it some source text and it produces a parse tree.
 ///
@@ -64,8 +76,77 @@ public:
         return create(sourceManager, buffer, options, false);
     }
 
-    /// Gets any diagnostics generated while parsing.
-    Diagnostics& diagnostics() { return diagnosticsBuffer; }
+    /// Creates a syntax tree for the text of @a tree with the given edits applied. The
+    /// edits refer to offsets in the original text, and must be sorted by offset and not
+    /// overlap. The new text is put in a new buffer with the same name as the original,
+    /// using the same source manager and options. If there are no edits, returns @a tree.
+    ///
+    /// Top-level members that the edits don't touch aren't lexed or parsed again, so the
+    /// result matches parsing the new text from scratch, diagnostics included, while
+    /// sharing memory with @a tree, which the new tree keeps alive as its parent. Members
+    /// that end before the line of the first edit are shared as is: their locations stay
+    /// in the original buffer, which has the same text up to there and sorts before the
+    /// new one. Members after the edits are copied with their locations moved into the
+    /// new buffer. Reuse only happens at the granularity of top-level members; any member
+    /// an edit touches gets parsed again in full.
+    ///
+    /// @note Shared members are the same objects as in @a tree, so their parent pointers
+    /// still refer to the root of @a tree rather than the root of the new tree, and
+    /// walking up the parent pointers from one of them ends at the old root.
+    ///
+    /// The whole text gets reparsed if @a tree uses macros, includes, conditional
+    /// directives or anything else that carries preprocessor state from one part of the
+    /// text to another, or if any directive ends up in the text being reparsed. Since
+    /// copying members costs about as much as parsing them, it also gets reparsed if more
+    /// text follows the last edit than precedes the first one, unless the text is small.
+    static std::shared_ptr<SyntaxTree> fromEdits(const std::shared_ptr<SyntaxTree>& tree,
+                                                 span<const TextEdit> edits);
+
+    /// Gets a key for the result of parsing @a buffer with @a options, made up of a hash of
+    /// its text, the options that affect parsing, and the version of the cache format.
+    /// Cache files written by writeCache only get used for buffers with the same key, so
+    /// tools can use it to name them.
+    static uint64_t getCacheKey(const SourceBuffer& buffer, const Bag& options = {});
+
+    /// Loads the syntax tree for @a buffer from the cache file at @a cachePath, which must
+    /// have been written by writeCache. The file is memory mapped, and the tree points
+    /// into it and into the text of the buffers it came from instead of copying them.
+    ///
+    /// If the cache file doesn't exist, was written for different text or options (see
+    /// getCacheKey), or any file that was included while parsing has changed since, then
+    /// @a buffer gets parsed instead, and the result is written to @a cachePath for next
+    /// time. Included files are looked up again with the source manager's include
+    /// directories, so changing those so that an include finds a different file also
+    /// means parsing again.
+    static std::shared_ptr<SyntaxTree> fromCache(string_view cachePath, const SourceBuffer& buffer,
+                                                 SourceManager& sourceManager,
+                                                 const Bag& options = {});
+
+    /// Writes the tree to a cache file at @a path, in a compact binary form that fromCache
+    /// can load back. Skimmed bodies get parsed first. Returns false if the file couldn't
+    /// be written, or if the tree can't be cached: it has to have been parsed from a single
+    /// buffer, must not have any `line directives or failed includes, and any diagnostics
+    /// have to be from parsing.
+    bool writeCache(string_view path);
+
+    /// Indicates whether the tree was loaded from a cache file (see fromCache).
+    bool isFromCache() const { return cacheData != nullptr; }
+
+    /// Gets any diagnostics generated while parsing. If bodies were skimmed (see
+    /// ParserOptions::skimBodies), this only includes diagnostics from the ones that
+    /// have been parsed so far; call parseSkimmedBodies first to get all of them.
+    Diagnostics& diagnostics() {
+        if (deferredBodies)
+            deferredBodies->takeDiagnostics(diagnosticsBuffer);
+        return diagnosticsBuffer;
+    }
+
+    /// Parses any bodies that were skimmed (see ParserOptions::skimBodies)
+    /// and haven't been parsed yet.
+    void parseSkimmedBodies() {
+        if (deferredBodies)
+            deferredBodies->parseAll();
+    }
 
     /// Gets the allocator containing the memory for the parse tree.
     BumpAllocator& allocator() { return alloc; }
@@ -102,11 +183,16 @@ public:
     }
 
 private:
+    friend class SyntaxSerializer;
+    friend class SyntaxDeserializer;
+
     SyntaxTree(SyntaxNode* root, SourceManager& sourceManager, BumpAllocator&& alloc,
-               Diagnostics&& diagnostics, const Bag& options, Token eof) :
+               Diagnostics&& diagnostics, const Bag& options, Token eof,
+               std::unique_ptr<DeferredBodyParser> deferredBodies, SourceBuffer source) :
         rootNode(root),
         sourceMan(sourceManager), alloc(std::move(alloc)),
-        diagnosticsBuffer(std::move(diagnostics)), options_(options), eof(eof) {}
+        diagnosticsBuffer(std::move(diagnostics)), options_(options), eof(eof),
+        deferredBodies(std::move(deferredBodies)), source(source) {}
 
     static std::shared_ptr<SyntaxTree> create(SourceManager& sourceManager, SourceBuffer source,
                                               const Bag& options, bool guess) {
@@ -126,9 +212,13 @@ private:
                 return create(sourceManager, source, options, false);
         }
 
-        return std::shared_ptr<SyntaxTree>(new SyntaxTree(root, sourceManager, std::move(alloc),
-                                                          std::move(diagnostics), options,
-                                                          parser.getEOFToken()));
+        auto result = std::shared_ptr<SyntaxTree>(
+            new SyntaxTree(root, sourceManager, std::move(alloc), std::move(diagnostics), options,
+                           parser.getEOFToken(), parser.takeDeferredBodies(), source));
+
+        auto included = preprocessor.getIncludedFiles();
+        result->includedFiles.assign(included.begin(), included.end());
+        return result;
     }
 
     SyntaxNode* rootNode;
@@ -138,6 +228,22 @@ private:
     Bag options_;
     std::shared_ptr<SyntaxTree> parentTree;
     Token eof;
+    std::unique_ptr<DeferredBodyParser> deferredBodies;
+
+    // The buffer the tree was parsed from, if it was parsed from a single one.
+    SourceBuffer source;
+
+    // The files included while parsing the tree.
+    std::vector<IncludedFile> includedFiles;
+
+    // If the tree was made by fromEdits, the buffers of the earlier versions of its text
+    // that members shared with those trees still have locations in. The text at each of
+    // those locations is the same as in the tree's own buffer.
+    std::vector<BufferID> previousSources;
+
+    // If the tree was loaded from a cache file, the contents of that file,
+    // which some of the tree's text points into.
+    std::shared_ptr<const char> cacheData;
 };
 
 } // namespace slang
@@ -19,7 +19,15 @@ namespace slang {
 /// Use this type as a base class for syntax tree visitors. It will default to
 /// traversing all children of each node. Add implementations for any specific
 /// node types you want to handle.
-template<typename TDerived>
+///
+/// By default children are visited recursively, which can overflow the stack on very
+/// deep trees, like the ones for expressions with many thousands of operators that
+/// generated code sometimes has. If @a Iterative is true, the visitor instead keeps a
+/// stack of nodes still to be visited: visitDefault just pushes the children of the node
+/// onto it, and they get visited after the handler that called it returns. Nodes are
+/// still visited in the same order, but handlers can't do anything after visiting the
+/// children of their node, since those haven't been visited yet.
+template<typename TDerived, bool Iterative = false>
 class SyntaxVisitor {
     HAS_METHOD_TRAIT(handle);
 
@@ -33,14 +41,49 @@ public:
     }
 
     void visitDefault(const SyntaxNode& node) {
-        for (uint32_t i = 0; i < node.getChildCount(); i++) {
-            auto child = node.childNode(i);
-            if (child)
-                child->visit(*DERIVED);
-            else {
-                auto token = node.childToken(i);
-                if (token)
-                    DERIVED->visitToken(token);
+        if constexpr (Iterative) {
+            // Push the children in reverse so that they come off the stack in order.
+            size_t count = pending.size();
+            for (uint32_t i = node.getChildCount(); i > 0; i--) {
+                if (auto child = node.childNode(i - 1))
+                    pending.push_back(child);
+                else if (auto token = node.childToken(i - 1))
+                    pending.push_back(token);
+            }
+
+            // Only the outermost call does the visiting; handlers further down just
+            // add to the stack.
+            if (visiting || pending.size() == count)
+                return;
+
+            visiting = true;
+            try {
+                while (!pending.empty()) {
+                    auto child = pending.back();
+                    pending.pop_back();
+                    if (child.isNode())
+                        child.node()->visit(*DERIVED);
+                    else
+                        DERIVED->visitToken(child.token());
+                }
+            }
+            catch (...) {
+                pending.clear();
+                visiting = false;
+                throw;
+            }
+            visiting = false;
+        }
+        else {
+            for (uint32_t i = 0; i < node.getChildCount(); i++) {
+                auto child = node.childNode(i);
+                if (child)
+                    child->visit(*DERIVED);
+                else {
+                    auto token = node.childToken(i);
+                    if (token)
+                        DERIVED->visitToken(token);
+                }
             }
         }
     }
@@ -50,6 +93,10 @@ public:
 private:
     // This is to make things compile if the derived class doesn't provide an implementation.
     void visitToken(Token) {}
+
+    // Children still to be visited, in reverse order, when visiting iteratively.
+    std::vector<ConstTokenOrSyntax> pending;
+    bool visiting = false;
 };
 
 namespace detail {
@@ -71,8 +118,15 @@ std::shared_ptr<SyntaxTree> transformTree(
 
 } // namespace detail
 
-template<typename TDerived>
-class SyntaxRewriter : public SyntaxVisitor<TDerived> {
+/// Use this type as a base class for visitors that make changes to syntax trees; see
+/// SyntaxVisitor for what @a Iterative means.
+///
+/// The tree returned by transform() only copies the nodes on the path from each change
+/// up to the root. All other nodes are shared with the original tree, which is kept
+/// alive as the new tree's parent. That also means the parent pointers of shared nodes
+/// still refer to nodes in the original tree.
+template<typename TDerived, bool Iterative = false>
+class SyntaxRewriter : public SyntaxVisitor<TDerived, Iterative> {
 public:
     std::shared_ptr<SyntaxTree> transform(const std::shared_ptr<SyntaxTree>& tree) {
         sourceManager = &tree->sourceManager();
@@ -6,19 +6,45 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <atomic>
 #include <deque>
 #include <filesystem>
 #include <memory>
+#include <mutex>
 #include <set>
+#include <shared_mutex>
+#include <tuple>
 #include <unordered_map>
 
 #include "slang/text/SourceLocation.h"
+#include "slang/util/MappedFile.h"
 #include "slang/util/Util.h"
 
 namespace fs = std::filesystem;
 
 namespace slang {
 
+class ThreadPool;
+
+/// Counters that describe how effective the caches in a SourceManager have been.
+struct SourceManagerStats {
+    /// The number of header lookups that were answered by the include cache.
+    uint64_t includeCacheHits = 0;
+
+    /// The number of header lookups that had to search the include directories.
+    uint64_t includeCacheMisses = 0;
+
+    /// The number of file system probes the include cache avoided.
+    uint64_t probesSaved = 0;
+
+    /// The number of files loaded from disk whose contents turned out to be
+    /// identical to a file that was already loaded.
+    uint64_t duplicateFiles = 0;
+
+    /// The number of bytes of memory saved by sharing the contents of duplicate files.
+    uint64_t duplicateBytesSaved = 0;
+};
+
 /// Represents a source buffer; that is, the actual text of the source
 /// code along with an identifier for the buffer which potentially
 /// encodes its include stack.
@@ -35,10 +61,14 @@ struct SourceBuffer {
 /// locations in files and locations generated by macro expansion.
 /// See SourceLocation for more details.
 ///
-/// TODO: The methods in this class should be thread safe.
+/// All methods in this class are thread safe, so many preprocessors can share
+/// a single source manager while parsing in parallel. Buffer entries are never
+/// moved once created, so queries about a given buffer or location don't need
+/// to take a lock; loading files and tracking line information does.
 class SourceManager {
 public:
     SourceManager();
+    ~SourceManager();
     SourceManager(const SourceManager&) = delete;
     SourceManager& operator=(const SourceManager&) = delete;
 
@@ -140,12 +170,54 @@ public:
     /// Read in a header file from disk.
     SourceBuffer readHeader(string_view path, SourceLocation includedFrom, bool isSystemPath);
 
+    /// Loads a header file into the file and include caches ahead of time, looking for
+    /// it the same way readHeader would for an include in a file in @a directory, but
+    /// without creating a buffer for it. Returns the text of the file, which is empty
+    /// if it couldn't be found, and sets @a directory to the directory that contains
+    /// it so that the file's own includes can be prefetched in turn.
+    string_view prefetchHeader(string_view path, const fs::path*& directory, bool isSystemPath);
+
+    /// Gets the directory containing the file for the given buffer, or nullptr if the
+    /// buffer didn't come from a file on disk.
+    const fs::path* getDirectory(BufferID buffer) const;
+
     /// Adds a line directive at the given location.
     void addLineDirective(SourceLocation location, uint32_t lineNum, string_view name,
                           uint8_t level);
 
+    /// Sets whether files read from disk should be memory mapped instead of copied
+    /// into heap memory. Mapped files are backed by the OS page cache, which is shared
+    /// with any other processes reading the same files. Files that can't be mapped
+    /// fall back to being read normally. Note that modifying or truncating a file on
+    /// disk while it is mapped results in undefined behavior.
+    void setMemoryMapping(bool enabled) { useMemoryMapping = enabled; }
+
+    /// Gets whether files read from disk will be memory mapped.
+    bool isMemoryMapping() const { return useMemoryMapping; }
+
+    /// Gets counters describing how effective the source manager's caches have been.
+    SourceManagerStats getStats() const;
+
+    /// Sets whether line tables for files read from disk should be computed eagerly
+    /// on a background thread as soon as the file is loaded. Otherwise they are
+    /// computed the first time a line number is requested for the file, which
+    /// usually happens while reporting diagnostics.
+    void setEagerLineTables(bool enabled);
+
+    /// Gets whether line tables are computed eagerly for files read from disk.
+    bool isEagerLineTables() const;
+
 private:
-    uint32_t unnamedBufferCount = 0;
+    std::atomic<uint32_t> unnamedBufferCount = 0;
+    std::atomic<bool> useMemoryMapping = false;
+
+    // Worker used to build line tables in the background; only set if
+    // eager line tables have been requested.
+    std::unique_ptr<ThreadPool> lineTablePool;
+
+    // Protects everything that isn't a buffer entry: the file cache, include
+    // directories, and the line information stored in each FileData.
+    mutable std::shared_mutex mut;
 
     // Stores information specified in a `line directive, which alters the
     // line number and file name that we report in diagnostics.
@@ -159,17 +231,38 @@ private:
             name(std::move(fname)), lineInFile(lif), lineOfDirective(lod), level(level) {}
     };
 
-    // Stores actual file contents and metadata; only one per loaded file
+    // Stores the text of a file along with anything derived purely from that text.
+    // Files on disk that have identical contents share a single instance.
+    class FileContents {
+    public:
+        std::vector<char> mem;             // file contents, if read into memory
+        MappedFile mapping;                // file contents, if memory mapped
+        std::vector<uint32_t> lineOffsets; // cache of compute line offsets
+
+        explicit FileContents(std::vector<char>&& data) : mem(std::move(data)) {}
+        explicit FileContents(MappedFile&& mapping) : mapping(std::move(mapping)) {}
+
+        // Gets the actual text of the file, including the null terminator.
+        string_view text() const {
+            return mapping ? mapping.text() : string_view(mem.data(), mem.size());
+        }
+    };
+
+    // Stores file metadata; only one per loaded file
     class FileData {
     public:
         std::string name;                              // name of the file
-        std::vector<char> mem;                         // file contents
-        std::vector<uint32_t> lineOffsets;             // cache of compute line offsets
+        std::shared_ptr<FileContents> contents;        // actual contents of the file
         std::vector<LineDirectiveInfo> lineDirectives; // cache of line directives
         const fs::path* directory;                     // directory in which the file exists
 
-        FileData(const fs::path* directory, std::string name, std::vector<char>&& data) :
-            name(std::move(name)), mem(std::move(data)), directory(directory) {}
+        FileData(const fs::path* directory, std::string name,
+                 std::shared_ptr<FileContents> contents) :
+            name(std::move(name)),
+            contents(std::move(contents)), directory(directory) {}
+
+        // Gets the actual text of the file, including the null terminator.
+        string_view text() const { return contents->text(); }
 
         // Returns a pointer to the LineDirectiveInfo for the nearest enclosing
         // line directive of the given raw line number, or nullptr if there is none
@@ -194,32 +287,86 @@ private:
     // at the expansion site. Alternatively, if this token came from an argument,
     // originalLocation will point to the argument at the expansion site and
     // expansionLocation will point to the parameter inside the macro body.
+    //
+    // There is one of these for every macro expansion (and every use of an argument
+    // within one) so they're packed tightly: the end of the expansion range is stored
+    // as a length from the start, and the macro name is an index into a table of names.
     struct ExpansionInfo {
+        // Special values for macroName.
+        static constexpr uint32_t NoName = UINT32_MAX;
+        static constexpr uint32_t MacroArg = UINT32_MAX - 1;
+
+        // Special value for expansionLength, used when the end of the range can't be
+        // described as an offset from the start; the actual end is looked up in a
+        // side table instead.
+        static constexpr uint32_t FarEnd = UINT32_MAX;
+
         SourceLocation originalLoc;
         SourceLocation expansionStart;
-        SourceLocation expansionEnd;
-        bool isMacroArg = false;
-
-        string_view macroName;
+        uint32_t expansionLength = 0;
+        uint32_t macroName = NoName;
 
         ExpansionInfo() {}
         ExpansionInfo(SourceLocation originalLoc, SourceLocation expansionStart,
-                      SourceLocation expansionEnd, bool isMacroArg) :
+                      uint32_t expansionLength, uint32_t macroName) :
             originalLoc(originalLoc),
-            expansionStart(expansionStart), expansionEnd(expansionEnd), isMacroArg(isMacroArg) {}
+            expansionStart(expansionStart), expansionLength(expansionLength),
+            macroName(macroName) {}
 
-        ExpansionInfo(SourceLocation originalLoc, SourceLocation expansionStart,
-                      SourceLocation expansionEnd, string_view macroName) :
-            originalLoc(originalLoc),
-            expansionStart(expansionStart), expansionEnd(expansionEnd), macroName(macroName) {}
+        bool isMacroArg() const { return macroName == MacroArg; }
     };
 
-    // index from BufferID to buffer metadata
-    std::deque<std::variant<FileInfo, ExpansionInfo>> bufferEntries;
+    using BufferEntry = std::variant<FileInfo, ExpansionInfo>;
+    static_assert(sizeof(BufferEntry) <= 32);
+
+    // Index from BufferID to buffer metadata. Entries are stored in chunks that double
+    // in size each time we run out of room; existing chunks are never reallocated,
+    // which allows entries to be appended and read concurrently without locking.
+    static constexpr uint32_t FirstChunkBits = 8;
+    static constexpr uint32_t MaxEntryChunks = 33 - FirstChunkBits;
+    std::atomic<BufferEntry*> entryChunks[MaxEntryChunks] = {};
+    std::atomic<uint32_t> entryCount = 0;
+    std::mutex entryChunkMutex;
+
+    // Names of all expanded macros, indexed by ExpansionInfo::macroName, along with a
+    // map to look up the index of a given name. Names are copied so that they don't
+    // depend on the lifetime of whichever syntax tree first expanded the macro.
+    std::deque<std::string> macroNames;
+    std::unordered_map<string_view, uint32_t> macroNameIndices;
+
+    // End locations of expansion ranges that are too far from their start location
+    // to be stored inline in ExpansionInfo, keyed by the BufferID of the expansion.
+    std::unordered_map<uint32_t, SourceLocation> farExpansionEnds;
 
     // cache for file lookups; this holds on to the actual file data
     std::unordered_map<std::string, std::unique_ptr<FileData>> lookupCache;
 
+    // The result of resolving a header name relative to some including directory;
+    // file is null if the header couldn't be found. probes is the number of paths we
+    // had to check on disk to get that answer.
+    struct ResolvedInclude {
+        FileData* file;
+        uint32_t probes;
+    };
+
+    // Cache of header lookups, keyed on the name as written in the source, the
+    // directory of the file doing the include, and whether it was a system include.
+    // Misses are cached too, so probing dozens of include directories for a header
+    // only happens once per including directory.
+    std::unordered_map<std::tuple<std::string, const fs::path*, bool>, ResolvedInclude>
+        includeCache;
+
+    std::atomic<uint64_t> includeCacheHits = 0;
+    std::atomic<uint64_t> includeCacheMisses = 0;
+    std::atomic<uint64_t> probesSaved = 0;
+
+    // Contents of every file loaded from disk, keyed by a hash of the text, so that
+    // the same file reached via different paths is only stored once.
+    std::unordered_multimap<uint64_t, std::shared_ptr<FileContents>> contentCache;
+
+    std::atomic<uint64_t> duplicateFiles = 0;
+    std::atomic<uint64_t> duplicateBytesSaved = 0;
+
     // extra file data that came from programmatic buffers instead of a real file on disk
     std::deque<FileData> userFileBuffers;
 
@@ -230,17 +377,26 @@ private:
     // uniquified backing memory for directories
     std::set<fs::path> directories;
 
+    BufferID addBufferEntry(BufferEntry&& entry);
+    const BufferEntry& getBufferEntry(BufferID buffer) const;
+
     FileData* getFileData(BufferID buffer) const;
+    SourceLocation createExpansionLoc(SourceLocation originalLoc, SourceLocation expansionStart,
+                                      SourceLocation expansionEnd, uint32_t macroName);
+    uint32_t getMacroNameIndex(string_view name);
     SourceBuffer createBufferEntry(FileData* fd, SourceLocation includedFrom);
 
-    SourceBuffer openCached(const fs::path& fullPath, SourceLocation includedFrom);
-    SourceBuffer cacheBuffer(const fs::path& path, SourceLocation includedFrom,
-                             std::vector<char>&& buffer);
+    FileData* resolveHeader(string_view path, const fs::path* directory, bool isSystemPath);
+    FileData* openCached(const fs::path& fullPath);
+    FileData* cacheFile(const fs::path& path, std::shared_ptr<FileContents> contents);
 
-    // Get raw line number of a file location, ignoring any line directives
-    uint32_t getRawLineNumber(SourceLocation location) const;
+    // Get raw line number of a file location, ignoring any line directives.
+    // The caller must hold a lock on the mutex, which may be upgraded in order
+    // to compute line offsets for the file.
+    template<typename TLock>
+    uint32_t getRawLineNumber(SourceLocation location, TLock& lock) const;
 
-    static void computeLineOffsets(const std::vector<char>& buffer, std::vector<uint32_t>& offsets);
+    static void computeLineOffsets(string_view buffer, std::vector<uint32_t>& offsets);
 
     static bool readFile(const fs::path& path, std::vector<char>& buffer);
 };
@@ -48,6 +48,11 @@ public:
     /// The other allocator will be in a moved-from state after the call.
     void steal(BumpAllocator&& other);
 
+    /// Gets the total number of bytes handed out by the allocator so far, including
+    /// any padding needed for alignment. This walks every segment, so it's meant for
+    /// reporting memory usage rather than for calling on a hot path.
+    size_t getBytesAllocated() const;
+
 protected:
     // Allocations are tracked as a linked list of segments.
     struct Segment {
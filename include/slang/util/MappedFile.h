@@ -0,0 +1,54 @@
+//------------------------------------------------------------------------------
+// MappedFile.h
+// Read-only memory mapped files.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <filesystem>
+
+#include "slang/util/Util.h"
+
+namespace slang {
+
+/// MappedFile - Owns a read-only memory mapping of a file on disk.
+///
+/// Mapped files are backed by the OS page cache, which is shared with any other
+/// processes reading the same files. Modifying or truncating a file on disk while
+/// it is mapped results in undefined behavior.
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// Maps the file at the given path into memory. Returns an empty object if the
+    /// file can't be mapped, including on platforms that don't support mapping files,
+    /// so callers should be prepared to read the file normally instead.
+    ///
+    /// If @a nullTerminated is set, the mapped text includes a trailing null terminator
+    /// just past the end of the file. That comes for free from the OS zero filling the
+    /// last page of the mapping, so files that end exactly on a page boundary can't be
+    /// mapped this way.
+    static MappedFile open(const std::filesystem::path& path, bool nullTerminated);
+
+    /// Gets the text of the file, including the null terminator if one was requested.
+    string_view text() const { return string_view(data, size); }
+
+    explicit operator bool() const { return data != nullptr; }
+
+private:
+    MappedFile(const char* data, size_t size, size_t mappedSize) :
+        data(data), size(size), mappedSize(mappedSize) {}
+
+    const char* data = nullptr;
+    size_t size = 0;
+    size_t mappedSize = 0;
+};
+
+} // namespace slang
@@ -6,6 +6,11 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <utility>
+
 #include "slang/util/Util.h"
 
 namespace slang {
@@ -13,63 +18,191 @@ namespace slang {
 /// This class is a lookup table from string to value. It's optimized for
 /// a known fixed set of keywords.
 ///
-/// TODO: use an offline tool to make this a minimal perfect hash.
-template<typename T>
+/// The table is built at compile time (see @a makeStringTable) as a minimal perfect
+/// hash: there is exactly one slot per key. Each key's hash picks a bucket, and each
+/// bucket records where its keys live. Buckets holding more than one key store a
+/// displacement that was chosen so that all of their keys land in free slots; buckets
+/// holding a single key just store the index of the slot it was given. A lookup is
+/// then one hash of the key, one bucket load, and one string comparison, with no
+/// probing.
+template<typename T, size_t N>
 class StringTable {
 public:
-    StringTable(std::initializer_list<std::pair<string_view, T>> entries) {
-        // Give ourselves a bunch of room for entries to hash by using double
-        // the required number of entries. Also round up to power of two so that
-        // we can use bitwise AND instead of mod for wraparound.
-        capacity = (uint32_t)entries.size() * 2;
-        capacity = roundUpToPow2(capacity);
-        table = new Entry[capacity];
-
-        for (auto& entry : entries) {
-            size_t hc = std::hash<string_view>()(entry.first);
-            uint32_t index = hc & (capacity - 1);
-            while (table[index].hashCode != 0)
-                index = (index + 1) & (capacity - 1);
-
-            table[index].key = entry.first;
-            table[index].value = entry.second;
-            table[index].hashCode = hc;
+    constexpr explicit StringTable(const std::pair<string_view, T> (&entries)[N]) {
+        for (uint64_t s = 0; !tryBuild(entries, s); s++) {
+            if (s == MaxSeeds)
+                throw std::logic_error("Failed to build perfect hash table");
         }
     }
 
     bool lookup(string_view key, T& value) const {
-        size_t hc = std::hash<string_view>()(key);
-        uint32_t index = hc & (capacity - 1);
-        do {
-            if (table[index].hashCode == hc && table[index].key == key) {
-                value = table[index].value;
-                return true;
-            }
-            index = (index + 1) & (capacity - 1);
-        } while (table[index].hashCode != 0);
-
+        uint64_t hc = hash(key, seed);
+        const Entry& entry = slots[getSlot(hc, buckets[hc & (NumBuckets - 1)])];
+        if (entry.key == key) {
+            value = entry.value;
+            return true;
+        }
         return false;
     }
 
 private:
     struct Entry {
         string_view key;
-        size_t hashCode = 0;
-        T value;
+        T value{};
+    };
+
+    static constexpr size_t roundUpToPow2(size_t n) {
+        size_t result = 1;
+        while (result < n)
+            result <<= 1;
+        return result;
+    }
+
+    // About two keys per bucket keeps the table small while leaving plenty of
+    // single-key buckets to fill in whatever slots the bigger ones leave behind.
+    static constexpr size_t NumBuckets = roundUpToPow2(N / 2 + 1);
+    static constexpr uint64_t MaxSeeds = 64;
+
+    // Set in a bucket's value when it holds the slot index directly
+    // instead of a displacement.
+    static constexpr uint32_t Direct = 0x80000000u;
+
+    static constexpr uint64_t hash(string_view str, uint64_t seed) {
+        // FNV-1a, followed by a finalizer so that every bit depends on every character.
+        uint64_t h = 14695981039346656037ull ^ (seed * 0x9e3779b97f4a7c15ull);
+        for (char c : str) {
+            h ^= uint8_t(c);
+            h *= 1099511628211ull;
+        }
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    // The low bits of the hash pick the bucket; the high bits give each key a starting
+    // point and a step to be displaced by. That gets scaled down to a slot index with a
+    // multiply and shift, since N isn't generally a power of two.
+    static constexpr size_t getSlot(uint64_t hc, uint32_t value) {
+        if (value & Direct)
+            return value & ~Direct;
+
+        uint32_t start = uint32_t(hc >> 32);
+        uint32_t stride = uint32_t(hc >> 16) | 1;
+        return size_t((uint64_t(start + value * stride) * N) >> 32);
+    }
+
+    struct Key {
+        uint64_t hash = 0;
+        size_t index = 0;
     };
-    Entry* table;
-    uint32_t capacity;
-
-    static uint32_t roundUpToPow2(uint32_t n) {
-        n--;
-        n |= n >> 1;
-        n |= n >> 2;
-        n |= n >> 4;
-        n |= n >> 8;
-        n |= n >> 16;
-        n++;
-        return n;
+
+    constexpr bool tryBuild(const std::pair<string_view, T> (&entries)[N], uint64_t s) {
+        seed = s;
+        slots = {};
+        buckets = {};
+
+        // Scratch space uses plain arrays: every std::array access is a function call,
+        // and those count against the compiler's limit on constant evaluation steps.
+        uint64_t hashes[N]{};
+        size_t bucketStart[NumBuckets + 1]{};
+        for (size_t i = 0; i < N; i++) {
+            hashes[i] = hash(entries[i].first, seed);
+            bucketStart[(hashes[i] & (NumBuckets - 1)) + 1]++;
+        }
+        for (size_t b = 0; b < NumBuckets; b++)
+            bucketStart[b + 1] += bucketStart[b];
+
+        // Group the keys by bucket (a counting sort) so each bucket's keys are contiguous.
+        Key keys[N]{};
+        size_t fill[NumBuckets]{};
+        size_t maxFill = 0;
+        for (size_t i = 0; i < N; i++) {
+            size_t b = hashes[i] & (NumBuckets - 1);
+            keys[bucketStart[b] + fill[b]++] = { hashes[i], i };
+            maxFill = std::max(maxFill, fill[b]);
+        }
+
+        // Place the biggest buckets first, while there's the most room to do so.
+        // Single-key buckets are left for last and just take whatever is free.
+        bool used[N]{};
+        for (size_t size = maxFill; size > 1; size--) {
+            for (size_t b = 0; b < NumBuckets; b++) {
+                if (fill[b] == size && !placeBucket(entries, b, keys + bucketStart[b],
+                                                    keys + bucketStart[b + 1], used)) {
+                    return false;
+                }
+            }
+        }
+
+        size_t nextFree = 0;
+        for (size_t b = 0; b < NumBuckets; b++) {
+            if (fill[b] == 1) {
+                while (used[nextFree])
+                    nextFree++;
+
+                auto& entry = entries[keys[bucketStart[b]].index];
+                used[nextFree] = true;
+                slots[nextFree] = { entry.first, entry.second };
+                buckets[b] = uint32_t(nextFree) | Direct;
+            }
+        }
+        return true;
+    }
+
+    constexpr bool placeBucket(const std::pair<string_view, T> (&entries)[N], size_t bucket,
+                               const Key* begin, const Key* end, bool* used) {
+        // Two copies of the same key always share a bucket and a hash, and no displacement
+        // can ever separate them, so catch those here instead of exhausting every seed.
+        for (const Key* k = begin; k != end; k++) {
+            for (const Key* other = k + 1; other != end; other++) {
+                if (k->hash == other->hash &&
+                    entries[k->index].first == entries[other->index].first) {
+                    throw std::logic_error("Duplicate key in string table");
+                }
+            }
+        }
+
+        for (uint32_t d = 0; d < N * 4; d++) {
+            const Key* k = begin;
+            for (; k != end; k++) {
+                size_t slot = getSlot(k->hash, d);
+                if (used[slot])
+                    break;
+                used[slot] = true;
+            }
+
+            if (k == end) {
+                buckets[bucket] = d;
+                for (k = begin; k != end; k++) {
+                    auto& entry = entries[k->index];
+                    slots[getSlot(k->hash, d)] = { entry.first, entry.second };
+                }
+                return true;
+            }
+
+            // Undo the partial placement and try the next displacement.
+            while (k != begin) {
+                k--;
+                used[getSlot(k->hash, d)] = false;
+            }
+        }
+        return false;
     }
+
+    std::array<Entry, N> slots{};
+    std::array<uint32_t, NumBuckets> buckets{};
+    uint64_t seed = 0;
 };
 
-} // namespace slang
\ No newline at end of file
+/// Creates a StringTable from the given list of entries. This is meant
+/// to be used to initialize constexpr tables, so that all of the work
+/// happens at compile time.
+template<typename T, size_t N>
+constexpr StringTable<T, N> makeStringTable(const std::pair<string_view, T> (&entries)[N]) {
+    return StringTable<T, N>(entries);
+}
+
+} // namespace slang
@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+// ThreadPool.h
+// Lightweight work-stealing thread pool.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "slang/util/Util.h"
+
+namespace slang {
+
+/// ThreadPool - A fixed size pool of worker threads.
+///
+/// Each worker owns a queue of tasks; tasks pushed from inside a worker go to that
+/// worker's queue, and idle workers steal from the other queues when their own
+/// runs dry. This keeps load balanced when task sizes vary wildly (such as when
+/// parsing a mix of small and very large source files).
+class ThreadPool {
+public:
+    /// Creates the pool with the given number of threads. If @a threadCount is
+    /// zero the number of hardware threads is used instead.
+    explicit ThreadPool(uint32_t threadCount = 0);
+
+    /// Waits for all outstanding tasks to finish and then shuts down the workers.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Queues the given function for execution on one of the worker threads.
+    template<typename TFunc>
+    void push(TFunc&& func) {
+        pushTask(Task(std::forward<TFunc>(func)));
+    }
+
+    /// Blocks until all queued tasks have finished executing. If any task threw an
+    /// exception, the first one is rethrown here. Must not be called from inside a task.
+    void waitForAll();
+
+    /// Gets the number of worker threads in the pool.
+    uint32_t getThreadCount() const { return (uint32_t)threads.size(); }
+
+    /// Gets the default number of threads to use for a pool on this machine.
+    static uint32_t getDefaultThreadCount();
+
+private:
+    using Task = std::function<void()>;
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void pushTask(Task&& task);
+    bool tryPopTask(size_t index, Task& task);
+    void workerMain(size_t index);
+
+    std::vector<std::thread> threads;
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+
+    // Guards all of the bookkeeping state below.
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+    size_t queuedTasks = 0;
+    size_t pendingTasks = 0;
+    size_t nextQueue = 0;
+    std::exception_ptr firstException;
+    bool stopping = false;
+};
+
+} // namespace slang
@@ -1,6 +1,7 @@
 #!/usr/bin/env python
 # This script generates C++ source for parse tree syntax nodes from a data file.
 
+import hashlib
 import os
 
 class TypeInfo:
@@ -49,6 +50,8 @@ namespace slang {
 //------------------------------------------------------------------------------
 #include "slang/syntax/AllSyntax.h"
 
+#include "slang/syntax/SyntaxSerializer.h"
+
 // This file contains all parse tree syntax node generated definitions.
 // It is auto-generated by the syntax_gen.py script under the scripts/ directory.
 
@@ -204,6 +207,52 @@ namespace slang {
 			cppf.write('    return alloc.emplace<{}>(*this);\n'.format(k))
 			cppf.write('}\n\n')
 
+	# Write out a method to create nodes of each kind from the binary cache format.
+	# Members are read in the same order that getChild returns them, since that's
+	# how SyntaxSerializer writes them out.
+	inf.seek(0)
+	schema = hashlib.sha256(inf.read().encode('utf-8')).hexdigest()[:16]
+	cppf.write('const uint64_t SyntaxDeserializer::SchemaHash = 0x{}ull;\n\n'.format(schema))
+
+	cppf.write('SyntaxNode* SyntaxDeserializer::createNode(SyntaxKind kind) {\n')
+	cppf.write('    switch (kind) {\n')
+	for k,v in sorted(alltypes.items()):
+		if not v.final or k not in reverseKindmap:
+			continue
+
+		kinds = sorted(reverseKindmap[k])
+		for kind in kinds[:-1]:
+			cppf.write('        case SyntaxKind::{}:\n'.format(kind))
+		cppf.write('        case SyntaxKind::{}: {{\n'.format(kinds[-1]))
+
+		args = []
+		if v.constructorArgs.startswith('SyntaxKind kind'):
+			args.append('kind')
+
+		for m in v.combinedMembers:
+			if m[0] == 'token':
+				cppf.write('            Token {} = readToken();\n'.format(m[1]))
+			elif m[0] == 'TokenList':
+				cppf.write('            auto {} = readTokenList();\n'.format(m[1]))
+			elif m[0].startswith('SyntaxList<'):
+				cppf.write('            auto {} = readList<{}>();\n'.format(m[1], m[0][11:-1]))
+			elif m[0].startswith('SeparatedSyntaxList<'):
+				cppf.write('            auto {} = readSeparatedList<{}>();\n'.format(m[1], m[0][20:-1]))
+			elif m[1] in v.optionalMembers:
+				cppf.write('            auto {} = readOptionalNode<{}>();\n'.format(m[1], m[0]))
+			else:
+				cppf.write('            auto& {} = readNode<{}>();\n'.format(m[1], m[0]))
+			args.append(m[1])
+
+		cppf.write('            return alloc.emplace<{}>({});\n'.format(k, ', '.join(args)))
+		cppf.write('        }\n')
+
+	cppf.write('        default:\n')
+	cppf.write('            break;\n')
+	cppf.write('    }\n')
+	cppf.write('    throw CorruptDataException("Invalid syntax kind");\n')
+	cppf.write('}\n\n')
+
 	# Write out syntax factory methods
 	outf.write('class SyntaxFactory {\n')
 	outf.write('public:\n')
@@ -10,6 +10,7 @@
 
 #include "BuiltInSubroutines.h"
 
+#include "slang/parsing/DeferredBodyParser.h"
 #include "slang/symbols/ASTVisitor.h"
 #include "slang/syntax/SyntaxTree.h"
 
@@ -24,7 +25,19 @@ struct ElaborationVisitor : public ASTVisitor<ElaborationVisitor> {
 
     void handle(const RootSymbol& symbol) { visitDefault(symbol); }
     void handle(const CompilationUnitSymbol& symbol) { visitDefault(symbol); }
-    void handle(const DefinitionSymbol& symbol) { visitDefault(symbol); }
+    void handle(const DefinitionSymbol& symbol) {
+        // Definitions get marked as instantiated when their names are looked up. A body
+        // that the parser only skimmed doesn't need to be parsed for that; looking up
+        // the names it noted while skimming will do.
+        if (symbol.hasSkimmedBody()) {
+            if (auto info = DeferredBodyParser::getSkimInfo(*symbol.getSyntax())) {
+                for (auto name : info->instantiatedNames)
+                    symbol.getCompilation().getDefinition(name, symbol);
+                return;
+            }
+        }
+        visitDefault(symbol);
+    }
     void handle(const InstanceSymbol& symbol) { visitDefault(symbol); }
     void handle(const InstanceArraySymbol& symbol) { visitDefault(symbol); }
     void handle(const GenerateBlockSymbol& symbol) { visitDefault(symbol); }
@@ -201,14 +214,7 @@ const RootSymbol& Compilation::getRoot() {
             continue;
         }
 
-        bool allDefaulted = true;
-        for (auto param : definition->parameters) {
-            if (!param->getDeclaredType()->getInitializerSyntax()) {
-                allDefaulted = false;
-                break;
-            }
-        }
-        if (!allDefaulted)
+        if (!definition->hasAllDefaultedParams())
             continue;
 
         topDefinitions.append(definition);
@@ -334,9 +340,12 @@ const Diagnostics& Compilation::getParseDiagnostics() {
     if (cachedParseDiagnostics)
         return *cachedParseDiagnostics;
 
+    // Bodies that were skimmed and never needed still have to be checked for errors.
     cachedParseDiagnostics.emplace();
-    for (const auto& tree : syntaxTrees)
+    for (const auto& tree : syntaxTrees) {
+        tree->parseSkimmedBodies();
         cachedParseDiagnostics->appendRange(tree->diagnostics());
+    }
 
     if (sourceManager)
         cachedParseDiagnostics->sort(*sourceManager);
@@ -10,11 +10,10 @@
 
 namespace slang {
 
-const static StringTable<TimeUnit> strToUnit = {
+constexpr auto strToUnit = makeStringTable<TimeUnit>({
     { "s", TimeUnit::Seconds },       { "ms", TimeUnit::Milliseconds },
     { "us", TimeUnit::Microseconds }, { "ns", TimeUnit::Nanoseconds },
-    { "ps", TimeUnit::Picoseconds },  { "fs", TimeUnit::Femtoseconds }
-};
+    { "ps", TimeUnit::Picoseconds },  { "fs", TimeUnit::Femtoseconds } });
 
 bool suffixToTimeUnit(string_view timeSuffix, TimeUnit& unit) {
     return strToUnit.lookup(timeSuffix, unit);
@@ -120,12 +120,30 @@ void VectorBuilder::append(Token token) {
 }
 
 SVInt VectorBuilder::finish() {
-    if (!valid)
+    bitwidth_t width;
+    if (!computeWidth(width))
         return 0;
 
     if (digits.empty())
         digits.append(logic_t(0));
-    else if (literalBase == LiteralBase::Decimal) {
+
+    return SVInt::fromDigits(width, literalBase, signFlag, hasUnknown, digits);
+}
+
+bool VectorBuilder::check(bitwidth_t& width, bool& anyUnknown) {
+    anyUnknown = hasUnknown;
+    return computeWidth(width);
+}
+
+bool VectorBuilder::computeWidth(bitwidth_t& width) {
+    if (!valid)
+        return false;
+
+    width = sizeBits ? sizeBits : 32;
+    if (digits.empty())
+        return true;
+
+    if (literalBase == LiteralBase::Decimal) {
         if (!hasUnknown) {
             uint64_t value = 0;
             for (logic_t d : digits) {
@@ -133,57 +151,56 @@ SVInt VectorBuilder::finish() {
                 value += d.value;
                 if (value > UINT32_MAX) {
                     diagnostics.add(DiagCode::DecimalLiteralOverflow, firstLocation);
-                    return 0;
+                    return false;
                 }
             }
         }
+        return true;
     }
-    else {
-        uint32_t multiplier = 0;
-        switch (literalBase) {
-            case LiteralBase::Binary:
-                multiplier = 1;
-                break;
-            case LiteralBase::Octal:
-                multiplier = 3;
-                break;
-            case LiteralBase::Hex:
-                multiplier = 4;
-                break;
-            default:
-                THROW_UNREACHABLE;
-        }
-        // All of the digits in the number require `multiplier` bits, except for
-        // possibly the first (leading) digit. This one has leading zeros in it,
-        // so only requires clog2(d+1) bits. If the leading digit is unknown
-        // however, we go with the default multiplier amount.
-        bitwidth_t bits = 0;
-        if (digits.size() > 1)
-            bits = (digits.size() - 1) * multiplier;
-
-        if (digits[0].isUnknown())
-            bits += multiplier;
-        else
-            bits += clog2(digits[0].value + 1);
 
-        if (bits > sizeBits) {
-            if (bits > SVInt::MAX_BITS) {
-                diagnostics.add(DiagCode::VectorLiteralOverflow, firstLocation);
-                bits = SVInt::MAX_BITS;
-            }
-            if (sizeBits == 0) {
-                return SVInt::fromDigits(std::max(32u, bits), literalBase, signFlag, hasUnknown,
-                                         digits);
-            }
-            else {
-                // we should warn about overflow here, but the spec says it is valid and
-                // the literal gets truncated. Definitely a warning though.
-                diagnostics.add(DiagCode::VectorLiteralOverflow, firstLocation);
-            }
-        }
+    uint32_t multiplier = 0;
+    switch (literalBase) {
+        case LiteralBase::Binary:
+            multiplier = 1;
+            break;
+        case LiteralBase::Octal:
+            multiplier = 3;
+            break;
+        case LiteralBase::Hex:
+            multiplier = 4;
+            break;
+        default:
+            THROW_UNREACHABLE;
     }
 
-    return SVInt::fromDigits(sizeBits ? sizeBits : 32, literalBase, signFlag, hasUnknown, digits);
+    // All of the digits in the number require `multiplier` bits, except for
+    // possibly the first (leading) digit. This one has leading zeros in it,
+    // so only requires clog2(d+1) bits. If the leading digit is unknown
+    // however, we go with the default multiplier amount.
+    bitwidth_t bits = 0;
+    if (digits.size() > 1)
+        bits = (digits.size() - 1) * multiplier;
+
+    if (digits[0].isUnknown())
+        bits += multiplier;
+    else
+        bits += clog2(digits[0].value + 1);
+
+    if (bits > sizeBits) {
+        if (bits > SVInt::MAX_BITS) {
+            diagnostics.add(DiagCode::VectorLiteralOverflow, firstLocation);
+            bits = SVInt::MAX_BITS;
+        }
+        if (sizeBits == 0) {
+            width = std::max(32u, bits);
+        }
+        else {
+            // we should warn about overflow here, but the spec says it is valid and
+            // the literal gets truncated. Definitely a warning though.
+            diagnostics.add(DiagCode::VectorLiteralOverflow, firstLocation);
+        }
+    }
+    return true;
 }
 
 void VectorBuilder::addDigit(logic_t digit, int maxValue) {
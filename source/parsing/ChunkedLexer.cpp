@@ -0,0 +1,312 @@
+//------------------------------------------------------------------------------
+// ChunkedLexer.cpp
+// Parallel lexing of very large source buffers.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#include "slang/parsing/ChunkedLexer.h"
+
+#include "../text/CharInfo.h"
+#include "../text/CharScan.h"
+#include <algorithm>
+
+#include "slang/util/ThreadPool.h"
+
+namespace slang {
+
+// Checks whether two tokens lexed by different lexers are the same token of the source.
+static bool isSameToken(Token a, Token b) {
+    return a.kind == b.kind && a.location() == b.location() &&
+           a.rawText().length() == b.rawText().length();
+}
+
+ChunkedLexer::ChunkedLexer(SourceBuffer buffer, BumpAllocator& alloc, Diagnostics& diagnostics,
+                           LexerOptions options, KeywordVersion keywordVersion,
+                           ThreadPool& threadPool, size_t chunkSize) :
+    buffer(buffer),
+    alloc(alloc), diagnostics(diagnostics), options(options), keywordVersion(keywordVersion) {
+
+    SmallVectorSized<size_t, 64> boundaries;
+    findChunkBoundaries(buffer.data, chunkSize, boundaries);
+
+    for (size_t i = 0; i < boundaries.size(); i++) {
+        auto chunk = std::make_unique<Chunk>();
+        chunk->begin = boundaries[i];
+        chunk->end = i + 1 < boundaries.size() ? boundaries[i + 1] : buffer.data.size();
+        chunks.push_back(std::move(chunk));
+    }
+
+    pendingTasks = chunks.size();
+    for (auto& chunk : chunks)
+        threadPool.push([this, ptr = chunk.get()] { lexChunk(*ptr); });
+}
+
+ChunkedLexer::~ChunkedLexer() {
+    {
+        std::unique_lock lock(mutex);
+        chunkDone.wait(lock, [this] { return pendingTasks == 0; });
+    }
+
+    // Tokens we've handed out point into the chunk allocators,
+    // so their memory has to go to the caller's allocator.
+    for (auto& chunk : chunks)
+        alloc.steal(std::move(chunk->alloc));
+}
+
+Token ChunkedLexer::lex(KeywordVersion version) {
+    return next(version, false);
+}
+
+Token ChunkedLexer::lexDisabledRegion(KeywordVersion version) {
+    return next(version, true);
+}
+
+Token ChunkedLexer::next(KeywordVersion version, bool disabled) {
+    // The pre-lexed tokens are only good when lexing normally
+    // with the keyword version they were lexed with.
+    if (!serialLexer && (disabled || version != keywordVersion))
+        startSerial();
+    if (serialLexer)
+        return nextSerial(version, disabled);
+
+    Chunk& chunk = waitForChunk(currentChunk);
+
+    // A chunk that ends early hit the error limit (or failed to lex at all); the serial
+    // lexer gets to decide what happens, since the limit is meant for the whole buffer.
+    if (chunk.tokens.empty() ||
+        (chunk.tokens[currentIndex].kind == TokenKind::EndOfFile &&
+         currentChunk + 1 < chunks.size())) {
+        startSerial();
+        return nextSerial(version, disabled);
+    }
+
+    // Each chunk only counts its own errors, but the limit applies to all of them
+    // together (along with anything else reported so far), the same as it would when
+    // lexing serially. If this token's errors would go over it, let the serial lexer
+    // lex the token again, which reports them and stops at the limit itself.
+    if (diagnostics.size() + countDiagnostics(chunk, currentIndex) > options.maxErrors) {
+        startSerial();
+        return nextSerial(version, disabled);
+    }
+
+    Token token = chunk.tokens[currentIndex];
+    reportDiagnostics(chunk, currentIndex);
+    handedOut(token);
+
+    if (currentIndex + 1 < chunk.tokens.size()) {
+        currentIndex++;
+    }
+    else if (token.kind != TokenKind::EndOfFile) {
+        // That was the first token of the next chunk, which we take from this chunk
+        // because this copy has all of the trivia in front of it. The next chunk's
+        // lexer should have found the same token; if not, the boundary wasn't
+        // actually safe and we have to go on serially.
+        Chunk& nextChunk = waitForChunk(currentChunk + 1);
+        if (nextChunk.tokens.size() > 1 && isSameToken(nextChunk.tokens[0], token))
+            enterChunk(currentChunk + 1);
+        else
+            startSerial();
+    }
+    return token;
+}
+
+Token ChunkedLexer::nextSerial(KeywordVersion version, bool disabled) {
+    Token token = disabled ? serialLexer->lexDisabledRegion(version) : serialLexer->lex(version);
+    handedOut(token);
+
+    if (!disabled && version == keywordVersion)
+        tryResync(token);
+    return token;
+}
+
+void ChunkedLexer::startSerial() {
+    if (lastEnd == 0) {
+        serialLexer.reset(new Lexer(buffer, alloc, diagnostics, options));
+    }
+    else {
+        // Pick up right after the last token, the same as the original lexer would.
+        serialLexer.reset(new Lexer(buffer.id, buffer.data, buffer.data.data() + lastEnd,
+                                    alloc, diagnostics, options));
+        serialLexer->onNewLine = false;
+    }
+}
+
+void ChunkedLexer::tryResync(Token token) {
+    if (token.kind == TokenKind::EndOfFile)
+        return;
+
+    // Find the last chunk that starts at or before this token; if that's a later chunk
+    // than the one we left off in and it starts with this same token, it was lexed in
+    // exactly the state the serial lexer is in now.
+    size_t offset = token.location().offset();
+    auto first = chunks.begin() + ptrdiff_t(currentChunk) + 1;
+    auto it = std::upper_bound(first, chunks.end(), offset,
+                               [](size_t value, auto& chunk) { return value < chunk->begin; });
+    if (it == first)
+        return;
+
+    size_t index = size_t(it - chunks.begin()) - 1;
+    Chunk& chunk = waitForChunk(index);
+    if (chunk.tokens.size() < 2 || !isSameToken(chunk.tokens[0], token))
+        return;
+
+    enterChunk(index);
+    serialLexer.reset();
+}
+
+void ChunkedLexer::enterChunk(size_t index) {
+    // The chunk's first token has already been handed out, along with anything
+    // that was wrong with it, so carry on from the second.
+    Chunk& chunk = *chunks[index];
+    while (chunk.nextDiag < chunk.diagTokens.size() && chunk.diagTokens[chunk.nextDiag] == 0)
+        chunk.nextDiag++;
+
+    currentChunk = index;
+    currentIndex = 1;
+}
+
+void ChunkedLexer::lexChunk(Chunk& chunk) {
+    try {
+        Lexer lexer(buffer.id, buffer.data, buffer.data.data() + chunk.begin, chunk.alloc,
+                    chunk.diagnostics, options);
+
+        // Dense code averages around one token per six characters.
+        chunk.tokens.reserve((chunk.end - chunk.begin) / 6);
+        while (true) {
+            size_t diagCount = chunk.diagnostics.size();
+            Token token = lexer.lex(keywordVersion);
+            for (size_t i = diagCount; i < chunk.diagnostics.size(); i++)
+                chunk.diagTokens.push_back(chunk.tokens.size());
+
+            chunk.tokens.push_back(token);
+            if (token.kind == TokenKind::EndOfFile || token.location().offset() >= chunk.end)
+                break;
+        }
+    }
+    catch (...) {
+        // Leave the chunk empty so that it gets lexed serially instead.
+        chunk.tokens.clear();
+    }
+
+    std::unique_lock lock(mutex);
+    chunk.ready = true;
+    pendingTasks--;
+    chunkDone.notify_all();
+}
+
+ChunkedLexer::Chunk& ChunkedLexer::waitForChunk(size_t index) {
+    Chunk& chunk = *chunks[index];
+    std::unique_lock lock(mutex);
+    chunkDone.wait(lock, [&chunk] { return chunk.ready; });
+    return chunk;
+}
+
+void ChunkedLexer::reportDiagnostics(Chunk& chunk, size_t tokenIndex) {
+    while (chunk.nextDiag < chunk.diagTokens.size() &&
+           chunk.diagTokens[chunk.nextDiag] <= tokenIndex) {
+        diagnostics.append(chunk.diagnostics[chunk.nextDiag++]);
+    }
+}
+
+size_t ChunkedLexer::countDiagnostics(const Chunk& chunk, size_t tokenIndex) const {
+    size_t count = 0;
+    for (size_t i = chunk.nextDiag; i < chunk.diagTokens.size(); i++) {
+        if (chunk.diagTokens[i] > tokenIndex)
+            break;
+        count++;
+    }
+    return count;
+}
+
+void ChunkedLexer::handedOut(Token token) {
+    lastEnd = token.location().offset() + token.rawText().length();
+}
+
+void ChunkedLexer::findChunkBoundaries(string_view text, size_t chunkSize,
+                                       SmallVector<size_t>& results) {
+    results.append(0);
+
+    const char* begin = text.data();
+    const char* end = text.data() + text.size();
+    const char* ptr = begin;
+    const char* target = size_t(end - ptr) > chunkSize ? ptr + chunkSize : end;
+
+    auto skipNewline = [&] {
+        if (ptr != end && *ptr == '\r')
+            ptr++;
+        if (ptr != end && *ptr == '\n')
+            ptr++;
+    };
+
+    while (true) {
+        ptr = findFirst<ChunkBoundaryStop>(ptr, end);
+        if (ptr == end)
+            return;
+
+        switch (*ptr++) {
+            case '\n':
+                // Don't bother splitting off a last chunk much smaller than the others.
+                if (ptr >= target && size_t(end - ptr) > chunkSize / 2) {
+                    results.append(size_t(ptr - begin));
+                    target = ptr + chunkSize;
+                }
+                break;
+            case '/':
+                if (ptr != end && *ptr == '/') {
+                    // Line comments end at the line break, which we leave to be looked at.
+                    ptr = findFirst<LineCommentStop>(ptr, end);
+                    while (ptr != end && *ptr == '\0') {
+                        ptr++;
+                        ptr = findFirst<LineCommentStop>(ptr, end);
+                    }
+                }
+                else if (ptr != end && *ptr == '*') {
+                    ptr++;
+                    while (true) {
+                        ptr = findFirst<BlockCommentStop>(ptr, end);
+                        if (ptr == end)
+                            return;
+                        if (*ptr++ == '*' && ptr != end && *ptr == '/') {
+                            ptr++;
+                            break;
+                        }
+                    }
+                }
+                break;
+            case '"':
+                // Strings end at an unescaped line break, but can be continued
+                // onto the next line with a backslash.
+                while (ptr != end && *ptr != '"' && *ptr != '\n' && *ptr != '\r') {
+                    if (*ptr++ == '\\' && ptr != end) {
+                        if (*ptr == '\r' || *ptr == '\n')
+                            skipNewline();
+                        else
+                            ptr++;
+                    }
+                }
+                if (ptr != end && *ptr == '"')
+                    ptr++;
+                break;
+            case '\\':
+                // Either a line continuation or an escaped identifier, which
+                // can have comment and string delimiters in it.
+                if (ptr != end && (*ptr == '\r' || *ptr == '\n')) {
+                    skipNewline();
+                }
+                else {
+                    while (ptr != end && isPrintable(*ptr) && !isWhitespace(*ptr))
+                        ptr++;
+                }
+                break;
+            case '`':
+                // Macro quotes don't start strings.
+                if (ptr != end && *ptr == '"')
+                    ptr++;
+                else if (end - ptr >= 3 && string_view(ptr, 3) == "\\`\"")
+                    ptr += 3;
+                break;
+        }
+    }
+}
+
+} // namespace slang
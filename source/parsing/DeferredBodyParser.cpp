@@ -0,0 +1,112 @@
+//------------------------------------------------------------------------------
+// DeferredBodyParser.cpp
+// On-demand parsing of skimmed declaration bodies.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#include "slang/parsing/DeferredBodyParser.h"
+
+#include "slang/parsing/Parser.h"
+
+namespace slang {
+
+DeferredBodyParser::DeferredBodyParser(const ParserOptions& parserOptions) {
+    // Once a body has been asked for, there's nothing to gain
+    // from skimming the declarations nested inside it.
+    ParserOptions bodyOptions = parserOptions;
+    bodyOptions.skimBodies = false;
+    options.add(bodyOptions);
+}
+
+void DeferredBodyParser::parse(const SyntaxNode& node) {
+    // Skimmed nodes are only ever made by create(), so they're really Deferred
+    // nodes, and no node the parser makes is actually const.
+    auto& mutableNode = const_cast<SyntaxNode&>(node);
+    if (ModuleDeclarationSyntax::isKind(node.kind)) {
+        auto& decl = static_cast<Deferred<ModuleDeclarationSyntax>&>(
+            mutableNode.as<ModuleDeclarationSyntax>());
+        decl.owner.parseBody(decl, decl.body);
+    }
+    else {
+        auto& decl = static_cast<Deferred<FunctionDeclarationSyntax>&>(
+            mutableNode.as<FunctionDeclarationSyntax>());
+        decl.owner.parseBody(decl, decl.body);
+    }
+}
+
+const DeferredBodyParser::SkimInfo* DeferredBodyParser::getSkimInfo(const SyntaxNode& node) {
+    if (!node.isSkimmed())
+        return nullptr;
+
+    if (ModuleDeclarationSyntax::isKind(node.kind)) {
+        auto& decl = static_cast<const Deferred<ModuleDeclarationSyntax>&>(
+            node.as<ModuleDeclarationSyntax>());
+        return &decl.info;
+    }
+
+    auto& decl = static_cast<const Deferred<FunctionDeclarationSyntax>&>(
+        node.as<FunctionDeclarationSyntax>());
+    return &decl.info;
+}
+
+void DeferredBodyParser::parseAll() {
+    std::vector<SyntaxNode*> nodes;
+    {
+        std::unique_lock lock(mutex);
+        nodes = skimmedNodes;
+    }
+
+    for (auto node : nodes)
+        node->parseSkimmedBody();
+}
+
+void DeferredBodyParser::takeDiagnostics(Diagnostics& target) {
+    std::unique_lock lock(mutex);
+    target.appendRange(diagnostics);
+    diagnostics.clear();
+}
+
+void DeferredBodyParser::parseBody(SyntaxNode& node, span<const Token> body) {
+    std::unique_lock lock(mutex);
+    if (!node.skimmed)
+        return;
+
+    // The body ends with its end keyword, which the parser gives back to us with
+    // any tokens it had to skip just before it attached, the same as it would have
+    // done when parsing the body in the first place.
+    Parser parser(body, alloc, diagnostics, options);
+    if (ModuleDeclarationSyntax::isKind(node.kind)) {
+        auto& decl = node.as<ModuleDeclarationSyntax>();
+        try {
+            Token end;
+            decl.members = parser.parseModuleMembers(decl.endmodule.kind, end);
+            decl.endmodule = end;
+        }
+        catch (const Parser::RecursionException&) {
+            decl.members = nullptr;
+        }
+
+        decl.members.parent = &decl;
+        for (auto member : decl.members)
+            member->parent = &decl;
+    }
+    else {
+        auto& decl = node.as<FunctionDeclarationSyntax>();
+        try {
+            Token end;
+            decl.items = parser.parseBlockItems(decl.end.kind, end);
+            decl.end = end;
+        }
+        catch (const Parser::RecursionException&) {
+            decl.items = nullptr;
+        }
+
+        decl.items.parent = &decl;
+        for (auto item : decl.items)
+            item->parent = &decl;
+    }
+
+    node.skimmed = false;
+}
+
+} // namespace slang
@@ -0,0 +1,134 @@
+//------------------------------------------------------------------------------
+// IncludePrefetcher.cpp
+// Speculative background loading of included files.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#include "slang/parsing/IncludePrefetcher.h"
+
+#include "slang/util/ThreadPool.h"
+
+namespace slang {
+
+IncludePrefetcher::IncludePrefetcher(SourceManager& sourceManager, ThreadPool& threadPool) :
+    sourceManager(sourceManager), threadPool(threadPool) {
+}
+
+IncludePrefetcher::~IncludePrefetcher() {
+    std::unique_lock lock(mutex);
+    cancelled = true;
+    allDone.wait(lock, [this] { return pendingTasks == 0; });
+}
+
+void IncludePrefetcher::prefetch(SourceBuffer buffer) {
+    if (buffer)
+        scan(buffer.data, sourceManager.getDirectory(buffer.id));
+}
+
+void IncludePrefetcher::scan(string_view text, const fs::path* directory) {
+    // Only scan each distinct piece of text once; lots of files include the same headers.
+    {
+        std::unique_lock lock(mutex);
+        if (cancelled || !scannedBuffers.insert(text.data()).second)
+            return;
+    }
+
+    SmallVectorSized<IncludeName, 16> names;
+    findIncludes(text, names);
+    if (names.empty())
+        return;
+
+    {
+        std::unique_lock lock(mutex);
+        pendingTasks += names.size();
+    }
+
+    for (auto& name : names)
+        threadPool.push([this, directory, name] { load(directory, name); });
+}
+
+void IncludePrefetcher::load(const fs::path* directory, IncludeName name) {
+    bool skip;
+    {
+        std::unique_lock lock(mutex);
+        skip = cancelled;
+    }
+
+    // The lookup resolves the file and caches its contents in the source manager,
+    // which is the whole point; we then go looking for nested includes. No buffer
+    // gets created until the preprocessor actually includes the file.
+    if (!skip) {
+        string_view text = sourceManager.prefetchHeader(name.path, directory, name.isSystem);
+        if (!text.empty())
+            scan(text, directory);
+    }
+
+    std::unique_lock lock(mutex);
+    if (--pendingTasks == 0)
+        allDone.notify_all();
+}
+
+void IncludePrefetcher::findIncludes(string_view text, SmallVector<IncludeName>& results) {
+    static constexpr string_view directive = "`include";
+
+    const char* ptr = text.data();
+    const char* end = text.data() + text.size();
+    while (ptr != end) {
+        char c = *ptr++;
+        switch (c) {
+            case '/':
+                if (ptr != end && *ptr == '/') {
+                    while (ptr != end && *ptr != '\n' && *ptr != '\r')
+                        ptr++;
+                }
+                else if (ptr != end && *ptr == '*') {
+                    ptr++;
+                    while (ptr != end && !(*ptr == '*' && ptr + 1 != end && ptr[1] == '/'))
+                        ptr++;
+                    if (ptr != end)
+                        ptr += 2;
+                }
+                break;
+            case '"':
+                while (ptr != end && *ptr != '"' && *ptr != '\n' && *ptr != '\r') {
+                    if (*ptr == '\\' && ptr + 1 != end)
+                        ptr++;
+                    ptr++;
+                }
+                if (ptr != end && *ptr == '"')
+                    ptr++;
+                break;
+            case '`': {
+                if (size_t(end - ptr) < directive.size() - 1 ||
+                    string_view(ptr - 1, directive.size()) != directive) {
+                    break;
+                }
+
+                ptr += directive.size() - 1;
+                while (ptr != end && (*ptr == ' ' || *ptr == '\t'))
+                    ptr++;
+                if (ptr == end || (*ptr != '"' && *ptr != '<'))
+                    break;
+
+                // The file name has to be on the same line as the directive.
+                char close = *ptr == '"' ? '"' : '>';
+                const char* nameStart = ++ptr;
+                while (ptr != end && *ptr != close && *ptr != '\n' && *ptr != '\r')
+                    ptr++;
+
+                if (ptr != end && *ptr == close) {
+                    if (ptr != nameStart) {
+                        results.append(
+                            { string_view(nameStart, size_t(ptr - nameStart)), close == '>' });
+                    }
+                    ptr++;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+} // namespace slang
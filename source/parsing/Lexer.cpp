@@ -7,6 +7,7 @@
 #include "slang/parsing/Lexer.h"
 
 #include "../text/CharInfo.h"
+#include "../text/CharScan.h"
 #include <algorithm>
 #include <cmath>
 
@@ -62,6 +63,41 @@ inline double computeRealValue(uint64_t value, int decPoint, int digits, uint64_
     return result;
 }
 
+// Matches any character that can't continue an identifier.
+struct IdentifierStop {
+    static bool match(char c) { return !isIdentifierChar(c); }
+
+#if SLANG_HAS_SSE2
+    static uint32_t match(__m128i v) {
+        // Setting bit 5 folds upper case letters onto lower case ones without
+        // moving any other identifier characters into the letter range.
+        __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+        __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                       _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+        __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                                      _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+        __m128i symbol = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('_')),
+                                      _mm_cmpeq_epi8(v, _mm_set1_epi8('$')));
+        __m128i ident = _mm_or_si128(_mm_or_si128(letter, digit), symbol);
+        return ~(uint32_t)_mm_movemask_epi8(ident) & 0xffff;
+    }
+#endif
+
+#if SLANG_HAS_AVX2_DISPATCH
+    __attribute__((target("avx2"))) static uint32_t match(__m256i v) {
+        __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+        __m256i letter = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+                                          _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), lower));
+        __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('0' - 1)),
+                                         _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), v));
+        __m256i symbol = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('_')),
+                                         _mm256_cmpeq_epi8(v, _mm256_set1_epi8('$')));
+        __m256i ident = _mm256_or_si256(_mm256_or_si256(letter, digit), symbol);
+        return ~(uint32_t)_mm256_movemask_epi8(ident);
+    }
+#endif
+};
+
 SyntaxKind getDirectiveKind(string_view directive);
 
 Lexer::Lexer(SourceBuffer buffer, BumpAllocator& alloc, Diagnostics& diagnostics,
@@ -78,8 +114,9 @@ Lexer::Lexer(BufferID bufferId, string_view source, const char* startPtr, BumpAl
     ASSERT(count);
     ASSERT(sourceEnd[-1] == '\0');
 
-    // detect BOMs so we can give nice errors for invaild encoding
-    if (count >= 2) {
+    // detect BOMs so we can give nice errors for invaild encoding; they
+    // only mean anything at the very start of the buffer
+    if (count >= 2 && sourceBuffer == originalBegin) {
         const unsigned char* ubuf = reinterpret_cast<const unsigned char*>(sourceBuffer);
         if ((ubuf[0] == 0xFF && ubuf[1] == 0xFE) || (ubuf[0] == 0xFE && ubuf[1] == 0xFF)) {
             addDiag(DiagCode::UnicodeBOM, 0);
@@ -127,7 +164,7 @@ Token Lexer::concatenateTokens(BumpAllocator& alloc, Token left, Token right) {
 
     auto info = alloc.emplace<Token::Info>(*token.getInfo());
     info->location = location;
-    info->trivia = trivia;
+    info->setTrivia(trivia);
     return Token(token.kind, info);
 }
 
@@ -167,8 +204,8 @@ Token Lexer::stringify(BumpAllocator& alloc, SourceLocation location, span<Trivi
 
     auto info = alloc.emplace<Token::Info>(*token.getInfo());
     info->location = location;
-    info->trivia = trivia;
-    info->rawText = raw.substr(0, raw.length() - 1);
+    info->setTrivia(trivia);
+    info->setRawText(raw.substr(0, raw.length() - 1));
     return Token(token.kind, info);
 }
 
@@ -197,15 +234,43 @@ void Lexer::splitTokens(BumpAllocator& alloc, Diagnostics& diagnostics,
 }
 
 Token Lexer::lex(KeywordVersion keywordVersion) {
-    auto info = alloc.emplace<Token::Info>();
     SmallVectorSized<Trivia, 32> triviaBuffer;
+    return lex(triviaBuffer, keywordVersion);
+}
+
+Token Lexer::lexDisabledRegion(KeywordVersion keywordVersion) {
+    SmallVectorSized<Trivia, 32> triviaBuffer;
+    mark();
+    scanDisabledRegion();
+    if (lexemeLength()) {
+        // Leave the line break in front of the terminating directive to be lexed as
+        // normal trivia, the same as any other directive would have.
+        const char* end = sourceBuffer;
+        while (end != marker && isHorizontalWhitespace(end[-1]))
+            end--;
+        if (end != marker && isNewline(end[-1])) {
+            end--;
+            if (end != marker && *end == '\n' && end[-1] == '\r')
+                end--;
+            sourceBuffer = end;
+        }
+
+        onNewLine = false;
+        if (lexemeLength())
+            addTrivia(TriviaKind::DisabledText, triviaBuffer);
+    }
+    return lex(triviaBuffer, keywordVersion);
+}
+
+Token Lexer::lex(SmallVector<Trivia>& triviaBuffer, KeywordVersion keywordVersion) {
+    auto info = alloc.emplace<Token::Info>();
     lexTrivia(triviaBuffer);
 
     // lex the next token
     mark();
     TokenKind kind = lexToken(info, keywordVersion);
     onNewLine = false;
-    info->rawText = lexeme();
+    info->setRawText(lexeme());
 
     if (kind != TokenKind::EndOfFile && diagnostics.size() > options.maxErrors) {
         // Stop any further lexing by claiming to be at the end of the buffer.
@@ -215,7 +280,10 @@ Token Lexer::lex(KeywordVersion keywordVersion) {
         triviaBuffer.append(Trivia(TriviaKind::DisabledText, lexeme()));
         kind = TokenKind::EndOfFile;
     }
-    info->trivia = triviaBuffer.copy(alloc);
+    if (options.discardTrivia)
+        info->setTrivia(summarizeTrivia(triviaBuffer));
+    else
+        info->setTrivia(triviaBuffer.copy(alloc));
     return Token(kind, info);
 }
 
@@ -509,11 +577,11 @@ TokenKind Lexer::lexToken(Token::Info* info, KeywordVersion keywordVersion) {
             scanIdentifier();
 
             // might be a keyword
-            TokenKind kind;
-            if (getKeywordTable(keywordVersion)->lookup(lexeme(), kind))
+            TokenKind kind = getKeywordKind(lexeme(), keywordVersion);
+            if (kind != TokenKind::Unknown)
                 return kind;
 
-            info->extra = IdentifierType::Normal;
+            info->setIdType(IdentifierType::Normal);
             return TokenKind::Identifier;
         }
         case '[':
@@ -690,7 +758,7 @@ void Lexer::lexStringLiteral(Token::Info* info) {
         }
     }
 
-    info->extra = to_string_view(stringBuffer.copy(alloc));
+    info->setStringText(to_string_view(stringBuffer.copy(alloc)));
 }
 
 TokenKind Lexer::lexEscapeSequence(Token::Info* info) {
@@ -715,7 +783,7 @@ TokenKind Lexer::lexEscapeSequence(Token::Info* info) {
             break;
     }
 
-    info->extra = IdentifierType::Escaped;
+    info->setIdType(IdentifierType::Escaped);
     return TokenKind::Identifier;
 }
 
@@ -732,7 +800,7 @@ TokenKind Lexer::lexDollarSign(Token::Info* info) {
     if (kind != TokenKind::Unknown)
         return kind;
 
-    info->extra = IdentifierType::System;
+    info->setIdType(IdentifierType::System);
     return TokenKind::Identifier;
 }
 
@@ -741,7 +809,7 @@ TokenKind Lexer::lexDirective(Token::Info* info) {
         // Handle escaped macro names as well.
         TokenKind kind = lexEscapeSequence(info);
         if (kind == TokenKind::Identifier) {
-            info->extra = SyntaxKind::MacroUsage;
+            info->setDirectiveKind(SyntaxKind::MacroUsage);
             return TokenKind::Directive;
         }
         return TokenKind::Unknown;
@@ -754,12 +822,12 @@ TokenKind Lexer::lexDirective(Token::Info* info) {
     // if length is 1, we just have a grave character on its own, which is an error
     if (lexemeLength() == 1) {
         addDiag(DiagCode::MisplacedDirectiveChar, startingOffset);
-        info->extra = SyntaxKind::Unknown;
+        info->setDirectiveKind(SyntaxKind::Unknown);
         return TokenKind::Directive;
     }
 
-    info->extra = getDirectiveKind(lexeme().substr(1));
-    if (!onNewLine && std::get<SyntaxKind>(info->extra) == SyntaxKind::IncludeDirective)
+    info->setDirectiveKind(getDirectiveKind(lexeme().substr(1)));
+    if (!onNewLine && info->directiveKind() == SyntaxKind::IncludeDirective)
         addDiag(DiagCode::IncludeNotFirstOnLine, startingOffset);
 
     return TokenKind::Directive;
@@ -809,7 +877,7 @@ TokenKind Lexer::lexNumericLiteral(Token::Info* info) {
             else if (lexTimeLiteral(info))
                 result = TokenKind::TimeLiteral;
 
-            info->setReal(computeRealValue(value, decPoint, digits, exp, neg));
+            info->setReal(alloc, computeRealValue(value, decPoint, digits, exp, neg));
             return result;
         }
         case 'e':
@@ -820,7 +888,7 @@ TokenKind Lexer::lexNumericLiteral(Token::Info* info) {
             uint64_t exp;
             bool neg;
             if (scanExponent(exp, neg)) {
-                info->setReal(computeRealValue(value, digits, digits, exp, neg));
+                info->setReal(alloc, computeRealValue(value, digits, digits, exp, neg));
                 return TokenKind::RealLiteral;
             }
             break;
@@ -829,7 +897,7 @@ TokenKind Lexer::lexNumericLiteral(Token::Info* info) {
 
     if (lexTimeLiteral(info)) {
         // TODO: overflow?
-        info->setReal((double)value);
+        info->setReal(alloc, (double)value);
         return TokenKind::TimeLiteral;
     }
 
@@ -868,18 +936,18 @@ TokenKind Lexer::lexApostrophe(Token::Info* info) {
         case '0':
         case '1':
             advance();
-            info->setBit((logic_t)getDigitValue(c));
+            info->setBit(alloc, (logic_t)getDigitValue(c));
             return TokenKind::UnbasedUnsizedLiteral;
         case 'x':
         case 'X':
             advance();
-            info->setBit(logic_t::x);
+            info->setBit(alloc, logic_t::x);
             return TokenKind::UnbasedUnsizedLiteral;
         case 'Z':
         case 'z':
         case '?':
             advance();
-            info->setBit(logic_t::z);
+            info->setBit(alloc, logic_t::z);
             return TokenKind::UnbasedUnsizedLiteral;
 
         case 's':
@@ -903,27 +971,27 @@ bool Lexer::lexIntegerBase(Token::Info* info, bool isSigned) {
     LiteralBase base;
     if (literalBaseFromChar(peek(), base)) {
         advance();
-        info->setNumFlags(base, isSigned);
+        info->setNumFlags(alloc, base, isSigned);
         return true;
     }
     return false;
 }
 
 bool Lexer::lexTimeLiteral(Token::Info* info) {
-#define CASE(c, flag)                          \
-    case c:                                    \
-        if (peek(1) == 's') {                  \
-            advance(2);                        \
-            info->setTimeUnit(TimeUnit::flag); \
-            return true;                       \
-        }                                      \
+#define CASE(c, flag)                                 \
+    case c:                                           \
+        if (peek(1) == 's') {                         \
+            advance(2);                               \
+            info->setTimeUnit(alloc, TimeUnit::flag); \
+            return true;                              \
+        }                                             \
         break;
 
     // clang-format off
     switch (peek()) {
         case 's':
             advance();
-            info->setTimeUnit(TimeUnit::Seconds);
+            info->setTimeUnit(alloc, TimeUnit::Seconds);
             return true;
         CASE('m', Milliseconds);
         CASE('u', Microseconds);
@@ -938,6 +1006,39 @@ bool Lexer::lexTimeLiteral(Token::Info* info) {
     return false;
 }
 
+span<Trivia const> Lexer::summarizeTrivia(const SmallVector<Trivia>& triviaBuffer) {
+    static const Trivia space[] = { Trivia(TriviaKind::Whitespace, " ") };
+    static const Trivia newline[] = { Trivia(TriviaKind::EndOfLine, "\n") };
+
+    if (triviaBuffer.empty())
+        return {};
+
+    // The preprocessor only looks at trivia up to the first line break, to see
+    // whether a directive keeps going; past that point all that matters is that
+    // there was a line break at all.
+    for (const Trivia& trivia : triviaBuffer) {
+        switch (trivia.kind) {
+            case TriviaKind::LineComment:
+                // A line comment can end with a line continuation, which keeps a
+                // directive going, so the preprocessor needs to see the real trivia.
+                if (trivia.getRawText().back() == '\\')
+                    return triviaBuffer.copy(alloc);
+                return newline;
+            case TriviaKind::BlockComment:
+                // Block comments that span lines are diagnosed inside directives.
+                if (trivia.getRawText().find_first_of("\r\n") != std::string_view::npos)
+                    return triviaBuffer.copy(alloc);
+                break;
+            case TriviaKind::EndOfLine:
+            case TriviaKind::DisabledText:
+                return newline;
+            default:
+                break;
+        }
+    }
+    return space;
+}
+
 void Lexer::lexTrivia(SmallVector<Trivia>& triviaBuffer) {
     while (true) {
         mark();
@@ -983,12 +1084,112 @@ void Lexer::lexTrivia(SmallVector<Trivia>& triviaBuffer) {
 }
 
 void Lexer::scanIdentifier() {
+    sourceBuffer = findFirst<IdentifierStop>(sourceBuffer, sourceEnd);
+}
+
+void Lexer::scanDisabledRegion() {
+    // Nested conditionals are skipped whole. If the buffer ends inside of one we back
+    // up to its start so that the preprocessor can handle it (and whatever closes it
+    // in the including file) the normal way.
+    uint32_t depth = 0;
+    const char* nestedStart = nullptr;
+
     while (true) {
-        char c = peek();
-        if (isAlphaNumeric(c) || c == '_' || c == '$')
-            advance();
-        else
-            return;
+        switch (peek()) {
+            case '\0':
+                if (reallyAtEnd()) {
+                    if (depth)
+                        sourceBuffer = nestedStart;
+                    return;
+                }
+                advance();
+                break;
+            case '/':
+                if (peek(1) == '/') {
+                    advance(2);
+                    while (!isNewline(peek()) && !(peek() == '\0' && reallyAtEnd()))
+                        advance();
+                }
+                else if (peek(1) == '*') {
+                    advance(2);
+                    while (!(peek() == '*' && peek(1) == '/')) {
+                        if (peek() == '\0' && reallyAtEnd()) {
+                            addDiag(DiagCode::UnterminatedBlockComment, currentOffset());
+                            break;
+                        }
+                        advance();
+                    }
+                    if (!reallyAtEnd())
+                        advance(2);
+                }
+                else {
+                    advance();
+                }
+                break;
+            case '"':
+                advance();
+                while (true) {
+                    char c = peek();
+                    if (c == '"') {
+                        advance();
+                        break;
+                    }
+                    if (isNewline(c) || (c == '\0' && reallyAtEnd()))
+                        break;
+
+                    advance();
+                    if (c == '\\' && !reallyAtEnd()) {
+                        c = peek();
+                        advance();
+                        if (c == '\r')
+                            consume('\n');
+                    }
+                }
+                break;
+            case '\\':
+                // escaped identifiers run until the next whitespace
+                advance();
+                while (isPrintable(peek()) && !isWhitespace(peek()))
+                    advance();
+                break;
+            case '`': {
+                const char* directiveStart = sourceBuffer;
+                advance();
+                switch (peek()) {
+                    case '"':
+                    case '`':
+                        advance();
+                        break;
+                    case '\\':
+                        if (peek(1) == '`' && peek(2) == '"')
+                            advance(3);
+                        break;
+                    default: {
+                        const char* nameStart = sourceBuffer;
+                        scanIdentifier();
+
+                        string_view name(nameStart, size_t(sourceBuffer - nameStart));
+                        if (name == "ifdef" || name == "ifndef") {
+                            if (depth++ == 0)
+                                nestedStart = directiveStart;
+                        }
+                        else if (name == "else" || name == "elsif" || name == "endif") {
+                            if (depth == 0) {
+                                sourceBuffer = directiveStart;
+                                return;
+                            }
+                            if (name == "endif")
+                                depth--;
+                        }
+                        break;
+                    }
+                }
+                break;
+            }
+            default:
+                advance();
+                break;
+        }
     }
 }
 
@@ -1011,25 +1212,13 @@ void Lexer::scanUnsignedNumber(uint64_t& value, int& digits) {
 }
 
 void Lexer::scanWhitespace(SmallVector<Trivia>& triviaBuffer) {
-    bool done = false;
-    while (!done) {
-        switch (peek()) {
-            case ' ':
-            case '\t':
-            case '\v':
-            case '\f':
-                advance();
-                break;
-            default:
-                done = true;
-                break;
-        }
-    }
+    sourceBuffer = findFirst<NotHorizontalWhitespace>(sourceBuffer, sourceEnd);
     addTrivia(TriviaKind::Whitespace, triviaBuffer);
 }
 
 void Lexer::scanLineComment(SmallVector<Trivia>& triviaBuffer) {
     while (true) {
+        sourceBuffer = findFirst<LineCommentStop>(sourceBuffer, sourceEnd);
         char c = peek();
         if (isNewline(c))
             break;
@@ -1048,6 +1237,7 @@ void Lexer::scanLineComment(SmallVector<Trivia>& triviaBuffer) {
 
 void Lexer::scanBlockComment(SmallVector<Trivia>& triviaBuffer) {
     while (true) {
+        sourceBuffer = findFirst<BlockCommentStop>(sourceBuffer, sourceEnd);
         char c = peek();
         if (c == '\0') {
             if (reallyAtEnd()) {
@@ -6,16 +6,17 @@
 //------------------------------------------------------------------------------
 #include "slang/parsing/Token.h"
 #include "slang/syntax/SyntaxNode.h"
+#include "slang/util/StringTable.h"
 
 namespace slang {
 
 // clang-format off
-const static StringTable<TokenKind> systemIdentifierKeywords = {
+constexpr auto systemIdentifierKeywords = makeStringTable<TokenKind>({
     { "$root", TokenKind::RootSystemName },
     { "$unit", TokenKind::UnitSystemName }
-};
+});
 
-const static StringTable<SyntaxKind> directiveTable = {
+constexpr auto directiveTable = makeStringTable<SyntaxKind>({
     { "begin_keywords", SyntaxKind::BeginKeywordsDirective },
     { "celldefine", SyntaxKind::CellDefineDirective },
     { "default_nettype", SyntaxKind::DefaultNetTypeDirective },
@@ -36,9 +37,9 @@ const static StringTable<SyntaxKind> directiveTable = {
     { "unconnected_drive", SyntaxKind::UnconnectedDriveDirective },
     { "undef", SyntaxKind::UndefDirective },
     { "undefineall", SyntaxKind::UndefineAllDirective }
-};
+});
 
-const static StringTable<KeywordVersion> keywordVersionTable = {
+constexpr auto keywordVersionTable = makeStringTable<KeywordVersion>({
     { "1364-1995", KeywordVersion::v1364_1995 },
     { "1364-2001-noconfig", KeywordVersion::v1364_2001_noconfig },
     { "1364-2001", KeywordVersion::v1364_2001 },
@@ -47,7 +48,7 @@ const static StringTable<KeywordVersion> keywordVersionTable = {
     { "1800-2009", KeywordVersion::v1800_2009 },
     { "1800-2012", KeywordVersion::v1800_2012 },
     { "1800-2017", KeywordVersion::v1800_2017 }
-};
+});
 
 // Lists of keywords, separated by the specification in which they were first introduced
 #define KEYWORDS_1364_1995 \
@@ -159,7 +160,6 @@ const static StringTable<KeywordVersion> keywordVersionTable = {
     { "endgenerate", TokenKind::EndGenerateKeyword },\
     { "generate", TokenKind::GenerateKeyword },\
     { "genvar", TokenKind::GenVarKeyword },\
-    { "ifnone", TokenKind::IfNoneKeyword },\
     { "localparam", TokenKind::LocalParamKeyword },\
     { "noshowcancelled", TokenKind::NoShowCancelledKeyword },\
     { "pulsestyle_ondetect", TokenKind::PulseStyleOnDetectKeyword },\
@@ -315,43 +315,47 @@ const static StringTable<KeywordVersion> keywordVersionTable = {
 
 // We maintain a separate table of keywords for all the various specifications,
 // to allow for easy switching between them when requested
-const static StringTable<TokenKind> allKeywords[8] =
-{ { // IEEE 1364-1995
+constexpr auto keywords1364_1995 = makeStringTable<TokenKind>({
     KEYWORDS_1364_1995
-}, { // IEEE 1364-2001-noconfig
+});
+
+constexpr auto keywords1364_2001_noconfig = makeStringTable<TokenKind>({
     KEYWORDS_1364_1995,
     NEWKEYWORDS_1364_2001_noconfig
-}, { // IEEE 1364-2001
+});
+
+constexpr auto keywords1364_2001 = makeStringTable<TokenKind>({
     KEYWORDS_1364_1995,
     NEWKEYWORDS_1364_2001_noconfig,
     NEWKEYWORDS_1364_2001
-}, { // IEEE 1364-2005
+});
+
+constexpr auto keywords1364_2005 = makeStringTable<TokenKind>({
     KEYWORDS_1364_1995,
     NEWKEYWORDS_1364_2001_noconfig,
     NEWKEYWORDS_1364_2001,
     NEWKEYWORDS_1364_2005
-}, { // IEEE 1800-2005
+});
+
+constexpr auto keywords1800_2005 = makeStringTable<TokenKind>({
     KEYWORDS_1364_1995,
     NEWKEYWORDS_1364_2001_noconfig,
     NEWKEYWORDS_1364_2001,
     NEWKEYWORDS_1364_2005,
     NEWKEYWORDS_1800_2005
-}, { // IEEE 1800-2009
+});
+
+constexpr auto keywords1800_2009 = makeStringTable<TokenKind>({
     KEYWORDS_1364_1995,
     NEWKEYWORDS_1364_2001_noconfig,
     NEWKEYWORDS_1364_2001,
     NEWKEYWORDS_1364_2005,
     NEWKEYWORDS_1800_2005,
     NEWKEYWORDS_1800_2009
-}, { // IEEE 1800-2012
-    KEYWORDS_1364_1995,
-    NEWKEYWORDS_1364_2001_noconfig,
-    NEWKEYWORDS_1364_2001,
-    NEWKEYWORDS_1364_2005,
-    NEWKEYWORDS_1800_2005,
-    NEWKEYWORDS_1800_2009,
-    NEWKEYWORDS_1800_2012
-}, { // IEEE 1800-2017
+});
+
+// IEEE 1800-2017 didn't add any new keywords, so it shares this one.
+constexpr auto keywords1800_2012 = makeStringTable<TokenKind>({
     KEYWORDS_1364_1995,
     NEWKEYWORDS_1364_2001_noconfig,
     NEWKEYWORDS_1364_2001,
@@ -359,7 +363,7 @@ const static StringTable<TokenKind> allKeywords[8] =
     NEWKEYWORDS_1800_2005,
     NEWKEYWORDS_1800_2009,
     NEWKEYWORDS_1800_2012
-} };
+});
 
 // clang-format on
 bool isKeyword(TokenKind kind) {
@@ -644,8 +648,34 @@ optional<KeywordVersion> getKeywordVersion(string_view text) {
     return std::nullopt;
 }
 
-const StringTable<TokenKind>* getKeywordTable(KeywordVersion version) {
-    return &allKeywords[(uint8_t)version];
+TokenKind getKeywordKind(string_view text, KeywordVersion version) {
+    TokenKind kind;
+    bool found = false;
+    switch (version) {
+        case KeywordVersion::v1364_1995:
+            found = keywords1364_1995.lookup(text, kind);
+            break;
+        case KeywordVersion::v1364_2001_noconfig:
+            found = keywords1364_2001_noconfig.lookup(text, kind);
+            break;
+        case KeywordVersion::v1364_2001:
+            found = keywords1364_2001.lookup(text, kind);
+            break;
+        case KeywordVersion::v1364_2005:
+            found = keywords1364_2005.lookup(text, kind);
+            break;
+        case KeywordVersion::v1800_2005:
+            found = keywords1800_2005.lookup(text, kind);
+            break;
+        case KeywordVersion::v1800_2009:
+            found = keywords1800_2009.lookup(text, kind);
+            break;
+        case KeywordVersion::v1800_2012:
+        case KeywordVersion::v1800_2017:
+            found = keywords1800_2012.lookup(text, kind);
+            break;
+    }
+    return found ? kind : TokenKind::Unknown;
 }
 
 // clang-format off
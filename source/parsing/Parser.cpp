@@ -15,6 +15,13 @@ Parser::Parser(Preprocessor& preprocessor, const Bag& options) :
     parseOptions(options.getOrDefault<ParserOptions>()), vectorBuilder(getDiagnostics()) {
 }
 
+Parser::Parser(span<const Token> tokens, BumpAllocator& alloc, Diagnostics& diagnostics,
+               const Bag& options) :
+    ParserBase::ParserBase(tokens, alloc, diagnostics),
+    factory(alloc), parseOptions(options.getOrDefault<ParserOptions>()),
+    vectorBuilder(getDiagnostics()) {
+}
+
 CompilationUnitSyntax& Parser::parseCompilationUnit() {
     try {
         auto members = parseMemberList<MemberSyntax>(TokenKind::EndOfFile, eofToken,
@@ -26,6 +33,36 @@ CompilationUnitSyntax& Parser::parseCompilationUnit() {
     }
 }
 
+span<MemberSyntax*> Parser::parseMembersUntil(SourceLocation location, Token& endToken) {
+    try {
+        SmallVectorSized<MemberSyntax*, 16> members;
+        bool error = false;
+
+        while (true) {
+            auto next = peek();
+            if (next.kind == TokenKind::EndOfFile || !(next.location() < location))
+                break;
+
+            auto member = parseMember();
+            if (!member) {
+                skipToken(error ? std::nullopt : std::make_optional(DiagCode::ExpectedMember));
+                error = true;
+            }
+            else {
+                members.append(member);
+                error = false;
+            }
+        }
+
+        endToken = consume();
+        return members.copy(alloc);
+    }
+    catch (const RecursionException&) {
+        endToken = Token();
+        return {};
+    }
+}
+
 SyntaxNode& Parser::parseGuess() {
     // First try to parse as an instantiation
     if (isHierarchyInstantiation())
@@ -77,6 +114,10 @@ Token Parser::getEOFToken() {
     return Token();
 }
 
+std::unique_ptr<DeferredBodyParser> Parser::takeDeferredBodies() {
+    return std::move(deferredBodies);
+}
+
 ModuleDeclarationSyntax& Parser::parseModule() {
     return parseModule(parseAttributes());
 }
@@ -84,15 +125,30 @@ ModuleDeclarationSyntax& Parser::parseModule() {
 ModuleDeclarationSyntax& Parser::parseModule(span<AttributeInstanceSyntax*> attributes) {
     auto& header = parseModuleHeader();
     auto endKind = getModuleEndKind(header.moduleKeyword.kind);
+    auto declKind = getModuleDeclarationKind(header.moduleKeyword.kind);
+
+    // Packages are always parsed, since everything that uses them needs their contents.
+    if (parseOptions.skimBodies && declKind != SyntaxKind::PackageDeclaration) {
+        DeferredBodyParser::SkimInfo info;
+        auto body = skimBody(endKind, false, info);
+        if (!body.empty()) {
+            Token endmodule = body[body.size() - 1];
+            return deferredBodies->create<ModuleDeclarationSyntax>(
+                alloc, body, info, declKind, attributes, header, nullptr, endmodule,
+                parseNamedBlockClause());
+        }
+    }
 
     Token endmodule;
-    auto members =
-        parseMemberList<MemberSyntax>(endKind, endmodule, [this]() { return parseMember(); });
-    return factory.moduleDeclaration(getModuleDeclarationKind(header.moduleKeyword.kind),
-                                     attributes, header, members, endmodule,
+    auto members = parseModuleMembers(endKind, endmodule);
+    return factory.moduleDeclaration(declKind, attributes, header, members, endmodule,
                                      parseNamedBlockClause());
 }
 
+span<MemberSyntax*> Parser::parseModuleMembers(TokenKind endKind, Token& end) {
+    return parseMemberList<MemberSyntax>(endKind, end, [this]() { return parseMember(); });
+}
+
 ClassDeclarationSyntax& Parser::parseClass() {
     auto attributes = parseAttributes();
 
@@ -741,6 +797,18 @@ FunctionDeclarationSyntax& Parser::parseFunctionDeclaration(
     Token end;
     auto& prototype = parseFunctionPrototype();
     auto semi = expect(TokenKind::Semicolon);
+
+    if (parseOptions.skimBodies) {
+        DeferredBodyParser::SkimInfo info;
+        auto body = skimBody(endKind, true, info);
+        if (!body.empty()) {
+            end = body[body.size() - 1];
+            return deferredBodies->create<FunctionDeclarationSyntax>(
+                alloc, body, info, functionKind, attributes, prototype, semi, nullptr, end,
+                parseNamedBlockClause());
+        }
+    }
+
     auto items = parseBlockItems(endKind, end);
     auto endBlockName = parseNamedBlockClause();
 
@@ -2394,6 +2462,166 @@ bool Parser::scanQualifiedName(uint32_t& index) {
     return true;
 }
 
+// Gets the token that ends a block started by the given token, for the kinds
+// of blocks that skimming keeps track of, or Unknown for any other token.
+static TokenKind getSkimmedBlockEnd(TokenKind kind) {
+    switch (kind) {
+        case TokenKind::BeginKeyword:
+            return TokenKind::EndKeyword;
+        case TokenKind::ForkKeyword:
+            return TokenKind::JoinKeyword;
+        case TokenKind::CaseKeyword:
+        case TokenKind::CaseXKeyword:
+        case TokenKind::CaseZKeyword:
+        case TokenKind::RandCaseKeyword:
+            return TokenKind::EndCaseKeyword;
+        case TokenKind::GenerateKeyword:
+            return TokenKind::EndGenerateKeyword;
+        case TokenKind::OpenBrace:
+        case TokenKind::ApostropheOpenBrace:
+            return TokenKind::CloseBrace;
+        case TokenKind::CoverGroupKeyword:
+            return TokenKind::EndGroupKeyword;
+        case TokenKind::ClassKeyword:
+            return TokenKind::EndClassKeyword;
+        case TokenKind::ModuleKeyword:
+        case TokenKind::MacromoduleKeyword:
+            return TokenKind::EndModuleKeyword;
+        case TokenKind::ProgramKeyword:
+            return TokenKind::EndProgramKeyword;
+        case TokenKind::InterfaceKeyword:
+            return TokenKind::EndInterfaceKeyword;
+        default:
+            return TokenKind::Unknown;
+    }
+}
+
+static bool isSkimmedBlockEnd(TokenKind kind) {
+    switch (kind) {
+        case TokenKind::EndKeyword:
+        case TokenKind::JoinKeyword:
+        case TokenKind::EndCaseKeyword:
+        case TokenKind::EndGenerateKeyword:
+        case TokenKind::CloseBrace:
+        case TokenKind::EndGroupKeyword:
+        case TokenKind::EndClassKeyword:
+        case TokenKind::EndModuleKeyword:
+        case TokenKind::EndProgramKeyword:
+        case TokenKind::EndInterfaceKeyword:
+            return true;
+        default:
+            return false;
+    }
+}
+
+span<Token> Parser::skimBody(TokenKind endKind, bool isBlockItems,
+                             DeferredBodyParser::SkimInfo& info) {
+    // Look ahead for the end keyword, keeping track of nested blocks. Every block
+    // that the parser reads up to its own end token has to be closed within the body,
+    // or else parsing it could stop somewhere other than where we think the body ends;
+    // in that case, or if anything else looks off, leave the body to be parsed normally.
+    // A list of block items stops at any end keyword, so the first one has to be ours.
+    SmallVectorSized<TokenKind, 16> blocks;
+    SmallVectorSized<string_view, 8> instantiatedNames;
+    TokenKind prev = TokenKind::Semicolon;
+    bool inForwardDecl = false;
+    uint32_t count = 0;
+
+    while (true) {
+        TokenKind kind = peek(count).kind;
+        if (kind == TokenKind::JoinAnyKeyword || kind == TokenKind::JoinNoneKeyword)
+            kind = TokenKind::JoinKeyword;
+
+        TokenKind blockEnd = getSkimmedBlockEnd(kind);
+        switch (kind) {
+            case TokenKind::EndOfFile:
+                return {};
+            case TokenKind::Semicolon:
+                inForwardDecl = false;
+                break;
+            case TokenKind::TypedefKeyword:
+            case TokenKind::ExternKeyword:
+                // Forward typedefs and extern declarations name classes
+                // and modules without having bodies.
+                inForwardDecl = true;
+                break;
+            case TokenKind::ForkKeyword:
+                if (prev == TokenKind::WaitKeyword || prev == TokenKind::DisableKeyword)
+                    blockEnd = TokenKind::Unknown;
+                break;
+            case TokenKind::Identifier: {
+                // Note anything that starts like an instantiation: a name followed by
+                // parameter assignments, or by an instance name and its ports or dimensions.
+                // This doesn't need to be exact, as long as no instantiation is missed.
+                TokenKind next = peek(count + 1).kind;
+                if (!isBlockItems &&
+                    (next == TokenKind::Hash ||
+                     (next == TokenKind::Identifier &&
+                      (peek(count + 2).kind == TokenKind::OpenParenthesis ||
+                       peek(count + 2).kind == TokenKind::OpenBracket)))) {
+                    instantiatedNames.append(peek(count).valueText());
+                }
+                break;
+            }
+            case TokenKind::ClassKeyword:
+            case TokenKind::ModuleKeyword:
+            case TokenKind::MacromoduleKeyword:
+            case TokenKind::ProgramKeyword:
+                if (inForwardDecl)
+                    blockEnd = TokenKind::Unknown;
+                break;
+            case TokenKind::InterfaceKeyword:
+                // Virtual interface types, interface ports, and interface classes
+                // (which are tracked by their class keyword) don't end in endinterface.
+                if (inForwardDecl || prev == TokenKind::VirtualKeyword ||
+                    prev == TokenKind::OpenParenthesis || prev == TokenKind::Comma ||
+                    peek(count + 1).kind == TokenKind::ClassKeyword) {
+                    blockEnd = TokenKind::Unknown;
+                }
+                break;
+            default:
+                break;
+        }
+
+        if (blockEnd != TokenKind::Unknown) {
+            blocks.append(blockEnd);
+            if (blockEnd == TokenKind::EndModuleKeyword ||
+                blockEnd == TokenKind::EndInterfaceKeyword ||
+                blockEnd == TokenKind::EndProgramKeyword) {
+                info.hasNestedDefinitions = true;
+            }
+        }
+        else if (!blocks.empty()) {
+            if (kind == blocks.back())
+                blocks.pop();
+            else if (isSkimmedBlockEnd(kind))
+                return {};
+        }
+        else if (isBlockItems ? isEndKeyword(kind) : kind == endKind) {
+            if (kind != endKind)
+                return {};
+            break;
+        }
+        else if (isSkimmedBlockEnd(kind)) {
+            return {};
+        }
+
+        prev = kind;
+        count++;
+    }
+
+    if (!deferredBodies)
+        deferredBodies = std::make_unique<DeferredBodyParser>(parseOptions);
+
+    // Take the tokens, including the end keyword.
+    SmallVectorSized<Token, 64> tokens(count + 1);
+    for (uint32_t i = 0; i <= count; i++)
+        tokens.append(consume());
+
+    info.instantiatedNames = instantiatedNames.copy(alloc);
+    return tokens.copy(alloc);
+}
+
 void Parser::errorIfAttributes(span<AttributeInstanceSyntax*> attributes, DiagCode code) {
     if (!attributes.empty())
         addDiag(code, peek().location());
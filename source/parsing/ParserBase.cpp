@@ -12,7 +12,23 @@
 namespace slang {
 
 ParserBase::ParserBase(Preprocessor& preprocessor) :
-    alloc(preprocessor.getAllocator()), window(preprocessor) {
+    alloc(preprocessor.getAllocator()), diagnostics(preprocessor.getDiagnostics()),
+    window(&preprocessor) {
+}
+
+ParserBase::ParserBase(span<const Token> tokens, BumpAllocator& alloc, Diagnostics& diagnostics) :
+    alloc(alloc), diagnostics(diagnostics), window(nullptr) {
+
+    // Anything that looks past the end of the list sees the end of the file,
+    // right after the last token.
+    SourceLocation endLoc;
+    if (!tokens.empty()) {
+        Token last = tokens[tokens.size() - 1];
+        endLoc = last.location() + last.rawText().length();
+    }
+
+    window.replayTokens = tokens;
+    window.replayEnd = Token::createMissing(alloc, TokenKind::EndOfFile, endLoc);
 }
 
 void ParserBase::prependSkippedTokens(Token& token) {
@@ -25,7 +41,7 @@ void ParserBase::prependSkippedTokens(Token& token) {
 }
 
 Diagnostics& ParserBase::getDiagnostics() {
-    return window.tokenSource.getDiagnostics();
+    return diagnostics;
 }
 
 Diagnostic& ParserBase::addDiag(DiagCode code, SourceLocation location) {
@@ -117,7 +133,12 @@ void ParserBase::Window::addNew() {
             buffer = newBuffer;
         }
     }
-    buffer[count] = tokenSource.next();
+    if (tokenSource)
+        buffer[count] = tokenSource->next();
+    else if (replayIndex < replayTokens.size())
+        buffer[count] = replayTokens[replayIndex++];
+    else
+        buffer[count] = replayEnd;
     count++;
 }
 
@@ -29,6 +29,64 @@ ExpressionSyntax& Parser::parseMinTypMaxExpression() {
 ExpressionSyntax& Parser::parseSubExpression(bitmask<ExpressionOptions> options, int precedence) {
     auto dg = setDepthGuard();
 
+    bool allowConditional;
+    ExpressionSyntax* expr = &parseBinaryExpression(options, precedence, allowConditional);
+
+    // can't nest pattern matching expressions
+    if (!allowConditional || !(options & ExpressionOptions::AllowPatternMatch))
+        return *expr;
+
+    // if we see the matches keyword or &&& we're in a pattern conditional predicate
+    // if we see a question mark, we were in a simple conditional predicate (at the precedence
+    // level one beneath logical-or)
+    //
+    // The last operand of a conditional operator can itself be a conditional, so chains of
+    // them (a ? b : c ? d : ...) nest to the right. Rather than recursing for each one, which
+    // runs into the depth limit on long chains in generated code, collect the leading parts
+    // here and build the nodes from the innermost one out once the chain ends.
+    struct PendingConditional {
+        ConditionalPredicateSyntax* predicate;
+        Token question;
+        span<AttributeInstanceSyntax*> attributes;
+        ExpressionSyntax* left;
+        Token colon;
+    };
+    SmallVectorSized<PendingConditional, 4> pending;
+
+    auto logicalOrPrecedence = getPrecedence(SyntaxKind::LogicalOrExpression);
+    while (allowConditional) {
+        auto current = peek();
+        if (current.kind != TokenKind::MatchesKeyword && current.kind != TokenKind::TripleAnd &&
+            (current.kind != TokenKind::Question || precedence >= logicalOrPrecedence)) {
+            break;
+        }
+
+        PendingConditional conditional;
+        conditional.predicate =
+            &parseConditionalPredicate(*expr, TokenKind::Question, conditional.question);
+        conditional.attributes = parseAttributes();
+        conditional.left = &parseSubExpression(options, logicalOrPrecedence - 1);
+        conditional.colon = expect(TokenKind::Colon);
+        pending.append(conditional);
+
+        precedence = logicalOrPrecedence - 1;
+        expr = &parseBinaryExpression(options, precedence, allowConditional);
+    }
+
+    for (size_t i = pending.size(); i > 0; i--) {
+        auto& conditional = pending[i - 1];
+        expr = &factory.conditionalExpression(*conditional.predicate, conditional.question,
+                                              conditional.attributes, *conditional.left,
+                                              conditional.colon, *expr);
+    }
+    return *expr;
+}
+
+ExpressionSyntax& Parser::parseBinaryExpression(bitmask<ExpressionOptions>& options,
+                                                int precedence, bool& allowConditional) {
+    // Expressions that start with these keywords can't be followed by a conditional operator.
+    allowConditional = false;
+
     auto current = peek();
     if (current.kind == TokenKind::NewKeyword)
         return parseNewExpression(nullptr);
@@ -97,26 +155,7 @@ ExpressionSyntax& Parser::parseSubExpression(bitmask<ExpressionOptions> options,
         }
     }
 
-    // can't nest pattern matching expressions
-    if (options & ExpressionOptions::AllowPatternMatch) {
-        // if we see the matches keyword or &&& we're in a pattern conditional predicate
-        // if we see a question mark, we were in a simple conditional predicate (at the precedence
-        // level one beneath logical-or)
-        auto logicalOrPrecedence = getPrecedence(SyntaxKind::LogicalOrExpression);
-        if (current.kind == TokenKind::MatchesKeyword || current.kind == TokenKind::TripleAnd ||
-            (current.kind == TokenKind::Question && precedence < logicalOrPrecedence)) {
-
-            Token question;
-            auto& predicate =
-                parseConditionalPredicate(*leftOperand, TokenKind::Question, question);
-            auto attributes = parseAttributes();
-            auto& left = parseSubExpression(options, logicalOrPrecedence - 1);
-            auto colon = expect(TokenKind::Colon);
-            auto& right = parseSubExpression(options, logicalOrPrecedence - 1);
-            leftOperand =
-                &factory.conditionalExpression(predicate, question, attributes, left, colon, right);
-        }
-    }
+    allowConditional = true;
     return *leftOperand;
 }
 
@@ -322,7 +361,24 @@ ExpressionSyntax& Parser::parseIntegerExpression() {
     string_view rawText = count == 1 ? first.rawText() : to_string_view(text.copy(alloc));
 
     auto info = alloc.emplace<Token::Info>(first.trivia(), rawText, first.location());
-    info->setInt(alloc, vectorBuilder.finish());
+
+    // Decimal digits split across tokens follow different rules depending on where
+    // the split falls, so those can't be decoded again later from the joined text.
+    if (parseOptions.lazyIntegerLiterals &&
+        (baseFlags.base() != LiteralBase::Decimal || count == 1)) {
+        bitwidth_t width;
+        bool hasUnknown;
+        if (vectorBuilder.check(width, hasUnknown)) {
+            info->setUndecodedInt(alloc, baseFlags.base(), baseFlags.isSigned(), sizeBits, width,
+                                  hasUnknown);
+        }
+        else {
+            info->setInt(alloc, SVInt(0));
+        }
+    }
+    else {
+        info->setInt(alloc, vectorBuilder.finish());
+    }
 
     return factory.integerVectorExpression(sizeToken, baseToken,
                                            Token(TokenKind::IntegerLiteral, info));
@@ -10,6 +10,8 @@
 #include "slang/text/SourceManager.h"
 #include "slang/util/BumpAllocator.h"
 
+#include "../text/CharInfo.h"
+
 namespace {
 
 using namespace slang;
@@ -59,6 +61,101 @@ bool isOnSameLine(Token token) {
     return true;
 }
 
+// A tiny raw text scanner used to look for include guards without having to
+// run the full lexer over a file.
+struct GuardScanner {
+    const char* ptr;
+    const char* end;
+
+    bool atEnd() const { return ptr == end; }
+    bool startsWith(char a, char b) const { return ptr + 1 < end && ptr[0] == a && ptr[1] == b; }
+
+    void skipLineComment() {
+        while (ptr != end && !isNewline(*ptr))
+            ptr++;
+    }
+
+    bool skipBlockComment() {
+        for (ptr += 2; ptr != end; ptr++) {
+            if (startsWith('*', '/')) {
+                ptr += 2;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Skips over whitespace and comments; returns false for an unterminated block comment.
+    bool skipTrivia() {
+        while (ptr != end) {
+            if (isWhitespace(*ptr))
+                ptr++;
+            else if (startsWith('/', '/'))
+                skipLineComment();
+            else if (startsWith('/', '*')) {
+                if (!skipBlockComment())
+                    return false;
+            }
+            else
+                break;
+        }
+        return true;
+    }
+
+    void skipString() {
+        for (ptr++; ptr != end && *ptr != '"' && !isNewline(*ptr); ptr++) {
+            if (*ptr == '\\' && ptr + 1 != end)
+                ptr++;
+        }
+        if (ptr != end && *ptr == '"')
+            ptr++;
+    }
+
+    // Skips the rest of a macro definition, including any escaped newlines.
+    void skipDefineBody() {
+        while (ptr != end && !isNewline(*ptr)) {
+            if (*ptr == '\\' && ptr + 1 != end) {
+                ptr += 2;
+                if (ptr[-1] == '\r' && ptr != end && *ptr == '\n')
+                    ptr++;
+            }
+            else if (startsWith('/', '/'))
+                skipLineComment();
+            else if (startsWith('/', '*')) {
+                if (!skipBlockComment())
+                    return;
+            }
+            else if (*ptr == '"')
+                skipString();
+            else
+                ptr++;
+        }
+    }
+
+    string_view word() {
+        const char* start = ptr;
+        while (ptr != end && isIdentifierChar(*ptr))
+            ptr++;
+        return string_view(start, size_t(ptr - start));
+    }
+
+    // Reads the macro name following a directive, which must be on the same line.
+    string_view macroName() {
+        while (ptr != end && isHorizontalWhitespace(*ptr))
+            ptr++;
+        if (ptr == end || isDecimalDigit(*ptr) || *ptr == '$')
+            return {};
+        return word();
+    }
+
+    bool expectDirective(string_view name) {
+        if (!skipTrivia() || ptr == end || *ptr != '`')
+            return false;
+        ptr++;
+        return word() == name;
+    }
+};
+
 } // namespace
 
 namespace slang {
@@ -74,6 +171,11 @@ Preprocessor::Preprocessor(SourceManager& sourceManager, BumpAllocator& alloc,
     resetAllDirectives();
     undefineAll();
 
+    if (options.prefetchPool) {
+        includePrefetcher =
+            std::make_unique<IncludePrefetcher>(sourceManager, *options.prefetchPool);
+    }
+
     for (std::string& predef : options.predefines) {
         // Find location of equals sign to indicate start of body.
         // If there is no equals sign, predefine to a value of 1.
@@ -98,8 +200,36 @@ void Preprocessor::pushSource(SourceBuffer buffer) {
     ASSERT(lexerStack.size() < options.maxIncludeDepth);
     ASSERT(buffer.id);
 
-    auto lexer = alloc.emplace<Lexer>(buffer, alloc, diagnostics, lexerOptions);
-    lexerStack.push_back(lexer);
+    if (options.lexPool && buffer.data.size() > options.lexChunkSize * 2) {
+        auto& chunked = chunkedLexers.emplace_back(std::make_unique<ChunkedLexer>(
+            buffer, alloc, diagnostics, lexerOptions, keywordVersionStack.back(),
+            *options.lexPool, options.lexChunkSize));
+        lexerStack.push_back({ nullptr, chunked.get(), nullptr });
+    }
+    else {
+        auto lexer = alloc.emplace<Lexer>(buffer, alloc, diagnostics, lexerOptions);
+        lexerStack.push_back({ lexer, nullptr, nullptr });
+    }
+
+    if (includePrefetcher)
+        includePrefetcher->prefetch(buffer);
+}
+
+void Preprocessor::pushInclude(SourceBuffer buffer) {
+    const TokenStreamCache::Entry* entry = nullptr;
+    if (options.tokenCache)
+        entry = options.tokenCache->getOrAdd(buffer, keywordVersionStack.back(), lexerOptions);
+
+    if (!entry) {
+        pushSource(buffer);
+        return;
+    }
+
+    auto cached = alloc.emplace<CachedLexer>(*entry, buffer, alloc, diagnostics, lexerOptions);
+    lexerStack.push_back({ nullptr, nullptr, cached });
+
+    if (includePrefetcher)
+        includePrefetcher->prefetch(buffer);
 }
 
 void Preprocessor::predefine(string_view definition, string_view fileName) {
@@ -272,7 +402,7 @@ Token Preprocessor::handleDirectives(Token token) {
     }
 }
 
-Token Preprocessor::nextRaw() {
+Token Preprocessor::nextRaw(bool disabledRegion) {
     // it's possible we have a token buffered from looking ahead when handling a directive
     if (currentToken)
         return std::exchange(currentToken, Token());
@@ -294,7 +424,8 @@ Token Preprocessor::nextRaw() {
     // Pull the next token from the active source.
     // This is the common case.
     auto& source = lexerStack.back();
-    auto token = source->lex(keywordVersionStack.back());
+    auto token = disabledRegion ? source.lexDisabledRegion(keywordVersionStack.back())
+                                : source.lex(keywordVersionStack.back());
     if (token.kind != TokenKind::EndOfFile)
         return token;
 
@@ -317,7 +448,7 @@ Token Preprocessor::nextRaw() {
 
     while (true) {
         auto& nextSource = lexerStack.back();
-        token = nextSource->lex(keywordVersionStack.back());
+        token = nextSource.lex(keywordVersionStack.back());
         appendTrivia(token);
         if (token.kind != TokenKind::EndOfFile)
             break;
@@ -401,10 +532,13 @@ Trivia Preprocessor::handleIncludeDirective(Token directive) {
         SourceBuffer buffer = sourceManager.readHeader(path, directive.location(), isSystem);
         if (!buffer.id)
             addDiag(DiagCode::CouldNotOpenIncludeFile, fileName.location());
-        else if (lexerStack.size() >= options.maxIncludeDepth)
-            addDiag(DiagCode::ExceededMaxIncludeDepth, fileName.location());
-        else
-            pushSource(buffer);
+        else {
+            includedFiles.push_back({ buffer, path, isSystem });
+            if (lexerStack.size() >= options.maxIncludeDepth)
+                addDiag(DiagCode::ExceededMaxIncludeDepth, fileName.location());
+            else if (!isIncludeGuarded(buffer))
+                pushInclude(buffer);
+        }
     }
 
     auto syntax = alloc.emplace<IncludeDirectiveSyntax>(directive, fileName);
@@ -538,6 +672,84 @@ Trivia Preprocessor::handleElseDirective(Token directive) {
     return parseBranchDirective(directive, Token(), take);
 }
 
+bool Preprocessor::isIncludeGuarded(SourceBuffer buffer) {
+    if (!options.skipGuardedIncludes)
+        return false;
+
+    // Identical files share their text, so keying on the pointer lets us
+    // recognize the same header no matter what path it was included by.
+    auto it = includeGuards.find(buffer.data.data());
+    if (it == includeGuards.end())
+        it = includeGuards.emplace(buffer.data.data(), findIncludeGuard(buffer.data)).first;
+
+    string_view guard = it->second;
+    return !guard.empty() && macros.find(guard) != macros.end();
+}
+
+string_view Preprocessor::findIncludeGuard(string_view text) {
+    // Source buffers are null terminated; don't count that as part of the text.
+    if (!text.empty() && text.back() == '\0')
+        text.remove_suffix(1);
+
+    GuardScanner scanner{ text.data(), text.data() + text.size() };
+    if (!scanner.expectDirective("ifndef"))
+        return {};
+
+    string_view name = scanner.macroName();
+    if (name.empty() || !scanner.expectDirective("define") || scanner.macroName() != name)
+        return {};
+
+    // A parenthesis right after the name would make this a function-like macro.
+    if (!scanner.atEnd() && *scanner.ptr == '(')
+        return {};
+    scanner.skipDefineBody();
+
+    // Look for the matching `endif, keeping track of nested conditionals. Any `else
+    // or `elsif at the top level means the file has content outside of the guard.
+    uint32_t depth = 1;
+    while (!scanner.atEnd()) {
+        char c = *scanner.ptr;
+        if (c == '"') {
+            scanner.skipString();
+        }
+        else if (c == '/' && (scanner.startsWith('/', '/') || scanner.startsWith('/', '*'))) {
+            if (!scanner.skipTrivia())
+                return {};
+        }
+        else if (c == '\\') {
+            // Escaped identifiers run until the next whitespace.
+            while (!scanner.atEnd() && !isWhitespace(*scanner.ptr))
+                scanner.ptr++;
+        }
+        else if (c == '`') {
+            scanner.ptr++;
+            string_view directive = scanner.word();
+            if (directive == "ifdef" || directive == "ifndef") {
+                depth++;
+            }
+            else if (directive == "else" || directive == "elsif") {
+                if (depth == 1)
+                    return {};
+            }
+            else if (directive == "endif") {
+                if (--depth == 0) {
+                    if (!scanner.skipTrivia() || !scanner.atEnd())
+                        return {};
+                    return name;
+                }
+            }
+            else if (directive == "define") {
+                scanner.skipDefineBody();
+            }
+        }
+        else {
+            scanner.ptr++;
+        }
+    }
+
+    return {};
+}
+
 bool Preprocessor::shouldTakeElseBranch(SourceLocation location, bool isElseIf,
                                         string_view macroName) {
     // empty stack is an error
@@ -571,9 +783,11 @@ bool Preprocessor::shouldTakeElseBranch(SourceLocation location, bool isElseIf,
 Trivia Preprocessor::parseBranchDirective(Token directive, Token condition, bool taken) {
     scratchTokenBuffer.clear();
     if (!taken) {
-        // skip over everything until we find another conditional compilation directive
+        // Skip over everything until we find another conditional compilation directive.
+        // Text coming straight from a source file gets skipped by the lexer in one go
+        // and shows up as DisabledText trivia on the directive that ends the region.
         while (true) {
-            auto token = nextRaw();
+            auto token = nextRaw(/* disabledRegion */ true);
 
             // EoF or conditional directive stops the skipping process
             bool done = false;
@@ -658,7 +872,7 @@ bool Preprocessor::expectTimescaleSpecifier(Token& value, Token& unit,
                                        token.location() + numText.length(), token.getInfo()->flags);
 
         unit = Token(TokenKind::Identifier, unitInfo);
-        unitInfo->extra = IdentifierType::Normal;
+        unitInfo->setIdType(IdentifierType::Normal);
 
         consume();
         if (!success)
@@ -986,7 +1200,7 @@ bool Preprocessor::applyMacroOps(span<Token const> tokens, SmallVector<Token>& d
             if (offset != std::string_view::npos) {
                 // Split the token, finish the stringification.
                 auto splitInfo = alloc.emplace<Token::Info>(*newToken.getInfo());
-                splitInfo->rawText = splitInfo->rawText.substr(0, offset);
+                splitInfo->setRawText(splitInfo->rawText().substr(0, offset));
                 stringifyBuffer.append(Token(TokenKind::Identifier, splitInfo));
 
                 dest.append(Lexer::stringify(alloc, stringify.location(), stringify.trivia(),
@@ -1288,8 +1502,8 @@ bool Preprocessor::expandIntrinsic(MacroIntrinsic intrinsic, MacroExpansion& exp
         case MacroIntrinsic::File: {
             string_view fileName = sourceManager.getFileName(loc);
             text.appendRange(fileName);
-            info->extra = fileName;
-            info->rawText = to_string_view(text.copy(alloc));
+            info->setStringText(fileName);
+            info->setRawText(to_string_view(text.copy(alloc)));
 
             expansion.append(Token(TokenKind::StringLiteral, info), loc);
             break;
@@ -1298,7 +1512,7 @@ bool Preprocessor::expandIntrinsic(MacroIntrinsic intrinsic, MacroExpansion& exp
             uint32_t lineNum = sourceManager.getLineNumber(loc);
             text.appendRange(std::to_string(lineNum)); // not the most efficient, but whatever
             info->setInt(alloc, lineNum);
-            info->rawText = to_string_view(text.copy(alloc));
+            info->setRawText(to_string_view(text.copy(alloc)));
 
             expansion.append(Token(TokenKind::IntegerLiteral, info), loc);
             break;
@@ -7,6 +7,7 @@
 #include "slang/parsing/Token.h"
 
 #include "slang/diagnostics/Diagnostics.h"
+#include "slang/numeric/VectorBuilder.h"
 #include "slang/syntax/AllSyntax.h"
 #include "slang/syntax/SyntaxPrinter.h"
 #include "slang/util/BumpAllocator.h"
@@ -98,30 +99,50 @@ span<Token const> Trivia::getSkippedTokens() const {
 
 Token::Info::Info(span<Trivia const> trivia, string_view rawText, SourceLocation location,
                   bitmask<TokenFlags> flags) :
-    trivia(trivia),
-    rawText(rawText), location(location), flags(flags) {
+    location(location),
+    flags(flags) {
+    setTrivia(trivia);
+    setRawText(rawText);
 }
 
-void Token::Info::setBit(logic_t value) {
-    NumericLiteralInfo* target = std::get_if<NumericLiteralInfo>(&extra);
-    if (target)
-        target->value = value;
-    else {
-        NumericLiteralInfo numInfo;
-        numInfo.value = value;
-        extra = numInfo;
-    }
+void Token::Info::setTrivia(span<Trivia const> trivia) {
+    triviaPtr = trivia.data();
+    triviaCount = (uint32_t)trivia.size();
 }
 
-void Token::Info::setReal(double value) {
-    NumericLiteralInfo* target = std::get_if<NumericLiteralInfo>(&extra);
-    if (target)
-        target->value = value;
-    else {
-        NumericLiteralInfo numInfo;
-        numInfo.value = value;
-        extra = numInfo;
-    }
+void Token::Info::setRawText(string_view text) {
+    rawTextPtr = text.data();
+    rawTextLength = (uint32_t)text.length();
+}
+
+void Token::Info::setStringText(string_view text) {
+    extra.stringTextPtr = text.data();
+    stringTextLength = (uint32_t)text.length();
+    extraKind = ExtraKind::StringText;
+}
+
+void Token::Info::setDirectiveKind(SyntaxKind kind) {
+    extra.directive = kind;
+    extraKind = ExtraKind::Directive;
+}
+
+void Token::Info::setIdType(IdentifierType type) {
+    extra.identifier = type;
+    extraKind = ExtraKind::Identifier;
+}
+
+// The number of words of storage an SVInt with the given shape uses.
+static uint32_t getNumWords(bitwidth_t width, bool hasUnknown) {
+    uint32_t words = (width + 63) / 64;
+    return hasUnknown ? words * 2 : words;
+}
+
+void Token::Info::setBit(BumpAllocator& alloc, logic_t value) {
+    getOrAddNumInfo(alloc).value = value;
+}
+
+void Token::Info::setReal(BumpAllocator& alloc, double value) {
+    getOrAddNumInfo(alloc).value = value;
 }
 
 void Token::Info::setInt(BumpAllocator& alloc, const SVInt& value) {
@@ -134,36 +155,62 @@ void Token::Info::setInt(BumpAllocator& alloc, const SVInt& value) {
         memcpy(storage.pVal, value.getRawData(), sizeof(uint64_t) * value.getNumWords());
     }
 
-    NumericLiteralInfo* target = std::get_if<NumericLiteralInfo>(&extra);
-    if (target)
-        target->value = storage;
-    else {
-        NumericLiteralInfo numInfo;
-        numInfo.value = storage;
-        extra = numInfo;
-    }
+    getOrAddNumInfo(alloc).value = storage;
 }
 
-void Token::Info::setNumFlags(LiteralBase base, bool isSigned) {
-    NumericLiteralInfo* target = std::get_if<NumericLiteralInfo>(&extra);
-    if (target)
-        target->numericFlags.set(base, isSigned);
-    else {
-        NumericLiteralInfo numInfo;
-        numInfo.numericFlags.set(base, isSigned);
-        extra = numInfo;
-    }
+void Token::Info::setUndecodedInt(BumpAllocator& alloc, LiteralBase base, bool isSigned,
+                                  bitwidth_t size, bitwidth_t width, bool hasUnknown) {
+    // Tokens have no allocator of their own to use later, so any words the
+    // value will need get allocated now, while there is one.
+    SVIntStorage storage(width, isSigned, hasUnknown);
+    uint32_t words = getNumWords(width, hasUnknown);
+    if (words > 1)
+        storage.pVal = (uint64_t*)alloc.allocate(sizeof(uint64_t) * words, alignof(uint64_t));
+
+    NumericLiteralInfo& numInfo = getOrAddNumInfo(alloc);
+    numInfo.value = UndecodedInt{ storage, size };
+    numInfo.numericFlags.set(base, isSigned);
 }
 
-void Token::Info::setTimeUnit(TimeUnit unit) {
-    NumericLiteralInfo* target = std::get_if<NumericLiteralInfo>(&extra);
-    if (target)
-        target->numericFlags.set(unit);
-    else {
-        NumericLiteralInfo numInfo;
-        numInfo.numericFlags.set(unit);
-        extra = numInfo;
+void Token::Info::setNumFlags(BumpAllocator& alloc, LiteralBase base, bool isSigned) {
+    getOrAddNumInfo(alloc).numericFlags.set(base, isSigned);
+}
+
+void Token::Info::setTimeUnit(BumpAllocator& alloc, TimeUnit unit) {
+    getOrAddNumInfo(alloc).numericFlags.set(unit);
+}
+
+Token::Info::NumericLiteralInfo& Token::Info::getOrAddNumInfo(BumpAllocator& alloc) {
+    if (extraKind != ExtraKind::Numeric) {
+        extra.numeric = alloc.emplace<NumericLiteralInfo>();
+        extraKind = ExtraKind::Numeric;
     }
+    return *extra.numeric;
+}
+
+string_view Token::Info::stringText() const {
+    if (extraKind != ExtraKind::StringText)
+        return "";
+    return { extra.stringTextPtr, stringTextLength };
+}
+
+SyntaxKind Token::Info::directiveKind() const {
+    if (extraKind != ExtraKind::Directive)
+        return SyntaxKind::Unknown;
+    return extra.directive;
+}
+
+IdentifierType Token::Info::idType() const {
+    if (extraKind != ExtraKind::Identifier)
+        return IdentifierType::Unknown;
+    return extra.identifier;
+}
+
+const Token::Info::NumericLiteralInfo& Token::Info::numInfo() const {
+    static const NumericLiteralInfo empty;
+    if (extraKind == ExtraKind::Numeric && extra.numeric)
+        return *extra.numeric;
+    return empty;
 }
 
 Token::Token() : kind(TokenKind::Unknown), info(nullptr) {
@@ -179,10 +226,10 @@ string_view Token::valueText() const {
             switch (identifierType()) {
                 case IdentifierType::Normal:
                 case IdentifierType::System:
-                    return info->rawText;
+                    return info->rawText();
                 case IdentifierType::Escaped:
                     // strip off leading backslash
-                    return info->rawText.substr(1);
+                    return info->rawText().substr(1);
                 case IdentifierType::Unknown:
                     // unknown tokens don't have value text
                     return "";
@@ -193,7 +240,7 @@ string_view Token::valueText() const {
         case TokenKind::IncludeFileName:
         case TokenKind::Directive:
         case TokenKind::MacroUsage:
-            return info->rawText;
+            return info->rawText();
         default:
             return getTokenKindText(kind);
     }
@@ -220,7 +267,7 @@ string_view Token::rawText() const {
             case TokenKind::MacroUsage:
             case TokenKind::EmptyMacroArgument:
             case TokenKind::LineContinuation:
-                return info->rawText;
+                return info->rawText();
             case TokenKind::EndOfFile:
                 return "";
             default:
@@ -239,7 +286,31 @@ std::string Token::toString() const {
 
 SVInt Token::intValue() const {
     ASSERT(kind == TokenKind::IntegerLiteral);
-    return std::get<SVIntStorage>(info->numInfo().value);
+    auto& numInfo = info->numInfo();
+    if (auto undecoded = std::get_if<Info::UndecodedInt>(&numInfo.value)) {
+        std::call_once(numInfo.decodeFlag, [&] {
+            // The parser already checked the digits and reported any problems
+            // with them, so there's nothing more to say about them here.
+            Diagnostics unused;
+            VectorBuilder builder(unused);
+            builder.start(numInfo.numericFlags.base(), undecoded->size,
+                          numInfo.numericFlags.isSigned(), location());
+            builder.append(*this);
+            const SVInt value = builder.finish();
+
+            // The value can come out with fewer words than were set aside for it,
+            // when all of its unknown digits get truncated away.
+            SVIntStorage& storage = undecoded->storage;
+            ASSERT(value.getNumWords() <= getNumWords(storage.bitWidth, storage.unknownFlag));
+            storage.unknownFlag = value.hasUnknown();
+            if (value.isSingleWord())
+                storage.val = *value.getRawData();
+            else
+                memcpy(storage.pVal, value.getRawData(), sizeof(uint64_t) * value.getNumWords());
+        });
+        return undecoded->storage;
+    }
+    return std::get<SVIntStorage>(numInfo.value);
 }
 
 double Token::realValue() const {
@@ -270,7 +341,7 @@ SyntaxKind Token::directiveKind() const {
 
 Token Token::withTrivia(BumpAllocator& alloc, span<Trivia const> trivia) const {
     auto newInfo = alloc.emplace<Info>(*info);
-    newInfo->trivia = trivia;
+    newInfo->setTrivia(trivia);
     return Token(kind, newInfo);
 }
 
@@ -287,30 +358,30 @@ Token Token::createMissing(BumpAllocator& alloc, TokenKind kind, SourceLocation
 
     switch (kind) {
         case TokenKind::Identifier:
-            info->extra = IdentifierType::Unknown;
+            info->setIdType(IdentifierType::Unknown);
             break;
         case TokenKind::IncludeFileName:
         case TokenKind::StringLiteral:
-            info->extra = string_view("");
+            info->setStringText("");
             break;
         case TokenKind::Directive:
         case TokenKind::MacroUsage:
-            info->extra = SyntaxKind::Unknown;
+            info->setDirectiveKind(SyntaxKind::Unknown);
             break;
         case TokenKind::IntegerLiteral:
             info->setInt(alloc, 0);
             break;
         case TokenKind::IntegerBase:
-            info->setNumFlags(LiteralBase::Decimal, false);
+            info->setNumFlags(alloc, LiteralBase::Decimal, false);
             break;
         case TokenKind::UnbasedUnsizedLiteral:
-            info->setBit(logic_t::x);
+            info->setBit(alloc, logic_t::x);
             break;
         case TokenKind::RealLiteral:
-            info->setReal(0.0);
+            info->setReal(alloc, 0.0);
             break;
         case TokenKind::TimeLiteral:
-            info->setTimeUnit(TimeUnit::Seconds);
+            info->setTimeUnit(alloc, TimeUnit::Seconds);
             break;
         default:
             break;
@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------------
+// TokenStreamCache.cpp
+// Reuse of lexed tokens across includes of the same file.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#include "slang/parsing/TokenStreamCache.h"
+
+#include <algorithm>
+
+namespace slang {
+
+const TokenStreamCache::Entry* TokenStreamCache::getOrAdd(SourceBuffer buffer,
+                                                          KeywordVersion keywordVersion,
+                                                          const LexerOptions& options) {
+    const char* key = buffer.data.data();
+    {
+        std::unique_lock lock(mutex);
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            const Entry* entry = it->second.get();
+            return matches(entry, keywordVersion, options) ? entry : nullptr;
+        }
+    }
+
+    // Lex without holding the lock; if another thread gets there first
+    // we just throw away our copy.
+    auto entry = std::make_unique<Entry>();
+    entry->keywordVersion = keywordVersion;
+    entry->options = options;
+
+    BumpAllocator lexAlloc;
+    Diagnostics diagnostics;
+    Lexer lexer(buffer, lexAlloc, diagnostics, options);
+    while (true) {
+        Token token = lexer.lex(keywordVersion);
+        entry->tokens.push_back(token);
+        if (token.kind == TokenKind::EndOfFile)
+            break;
+    }
+
+    if (!diagnostics.empty())
+        entry.reset();
+
+    std::unique_lock lock(mutex);
+    auto [it, inserted] = entries.emplace(key, std::move(entry));
+    if (inserted && it->second)
+        alloc.steal(std::move(lexAlloc));
+
+    const Entry* result = it->second.get();
+    return matches(result, keywordVersion, options) ? result : nullptr;
+}
+
+bool TokenStreamCache::matches(const Entry* entry, KeywordVersion keywordVersion,
+                               const LexerOptions& options) {
+    // Tokens lexed with other options might not be the ones the caller's
+    // own lexer would produce, e.g. they might keep trivia it discards.
+    return entry && entry->keywordVersion == keywordVersion &&
+           entry->options.discardTrivia == options.discardTrivia &&
+           entry->options.maxErrors == options.maxErrors;
+}
+
+size_t TokenStreamCache::size() const {
+    std::unique_lock lock(mutex);
+    return (size_t)std::count_if(entries.begin(), entries.end(),
+                                 [](auto& pair) { return pair.second != nullptr; });
+}
+
+CachedLexer::CachedLexer(const TokenStreamCache::Entry& entry, SourceBuffer buffer,
+                         BumpAllocator& alloc, Diagnostics& diagnostics, LexerOptions options) :
+    entry(entry),
+    buffer(buffer), alloc(alloc), diagnostics(diagnostics), options(options) {
+}
+
+Token CachedLexer::lex(KeywordVersion keywordVersion) {
+    return next(keywordVersion, false);
+}
+
+Token CachedLexer::lexDisabledRegion(KeywordVersion keywordVersion) {
+    return next(keywordVersion, true);
+}
+
+Token CachedLexer::next(KeywordVersion keywordVersion, bool disabled) {
+    if (!serialLexer && (disabled || keywordVersion != entry.keywordVersion))
+        startSerial();
+
+    Token token;
+    if (serialLexer) {
+        token = disabled ? serialLexer->lexDisabledRegion(keywordVersion)
+                         : serialLexer->lex(keywordVersion);
+        if (!disabled && keywordVersion == entry.keywordVersion)
+            tryResync(token);
+    }
+    else {
+        // Keep handing out the end of file token once we get there.
+        Token cached = entry.tokens[index];
+        token = cached.withLocation(alloc, SourceLocation(buffer.id, cached.location().offset()));
+        if (index + 1 < entry.tokens.size())
+            index++;
+    }
+
+    lastEnd = token.location().offset() + token.rawText().length();
+    return token;
+}
+
+void CachedLexer::startSerial() {
+    // Lexers are allocated without ever being destroyed, like the ones the
+    // preprocessor makes itself; they don't own anything.
+    auto mem = alloc.allocate(sizeof(Lexer), alignof(Lexer));
+    if (lastEnd == 0) {
+        serialLexer = new (mem) Lexer(buffer, alloc, diagnostics, options);
+    }
+    else {
+        // Pick up right after the last token, the same as the original lexer would.
+        serialLexer = new (mem) Lexer(buffer.id, buffer.data, buffer.data.data() + lastEnd,
+                                      alloc, diagnostics, options);
+        serialLexer->onNewLine = false;
+    }
+}
+
+void CachedLexer::tryResync(Token token) {
+    if (token.kind == TokenKind::EndOfFile)
+        return;
+
+    // If this token is one of the cached ones, the real lexer is now in the same
+    // state the cache was lexed in, so everything after it will match too.
+    uint32_t offset = token.location().offset();
+    auto it = std::lower_bound(
+        entry.tokens.begin(), entry.tokens.end(), offset,
+        [](Token cached, uint32_t value) { return cached.location().offset() < value; });
+
+    if (it != entry.tokens.end() && it->location().offset() == offset && it->kind == token.kind &&
+        it->rawText().length() == token.rawText().length()) {
+        index = size_t(it - entry.tokens.begin()) + 1;
+        serialLexer = nullptr;
+    }
+}
+
+} // namespace slang
@@ -9,6 +9,7 @@
 #include <nlohmann/json.hpp>
 
 #include "slang/compilation/Compilation.h"
+#include "slang/parsing/DeferredBodyParser.h"
 #include "slang/util/StackContainer.h"
 
 namespace slang {
@@ -63,26 +64,72 @@ DefinitionSymbol& DefinitionSymbol::fromSyntax(Compilation& compilation,
     if (syntax.header->ports)
         result->addMembers(*syntax.header->ports);
 
+    result->parameters = parameters.copy(compilation);
+
+    // If the parser skimmed the body, leave it be until something needs its members.
+    // Nested definitions have to be known up front, though, for finding the top modules.
+    auto skimInfo = DeferredBodyParser::getSkimInfo(syntax);
+    if (skimInfo && !skimInfo->hasNestedDefinitions) {
+        result->skimmedBody = true;
+        result->setNeedsElaboration();
+    }
+    else {
+        result->addBodyMembers(syntax);
+    }
+
+    return *result;
+}
+
+bool DefinitionSymbol::hasAllDefaultedParams() const {
+    // Parameters declared in the body are required to have defaults,
+    // so a skimmed body doesn't need to be parsed to check them.
+    for (auto param : parameters) {
+        if (!param->getDeclaredType()->getInitializerSyntax())
+            return false;
+    }
+    return true;
+}
+
+void DefinitionSymbol::addSkimmedBody() const {
+    if (!skimmedBody)
+        return;
+
+    // Adding the body's members happens in logically const scenarios, the same as
+    // elaborating deferred members does.
+    skimmedBody = false;
+    const_cast<DefinitionSymbol*>(this)->addBodyMembers(
+        getSyntax()->as<ModuleDeclarationSyntax>());
+}
+
+void DefinitionSymbol::addBodyMembers(const ModuleDeclarationSyntax& syntax) {
+    syntax.parseSkimmedBody();
+
+    SmallVectorSized<const ParameterSymbol*, 8> bodyParams;
+    bool hasPortParams = syntax.header->parameters;
     for (auto member : syntax.members) {
         if (member->kind != SyntaxKind::ParameterDeclarationStatement)
-            result->addMembers(*member);
+            addMembers(*member);
         else {
             auto declaration = member->as<ParameterDeclarationStatementSyntax>().parameter;
             bool isLocal =
                 hasPortParams || declaration->keyword.kind == TokenKind::LocalParamKeyword;
 
             SmallVectorSized<ParameterSymbol*, 8> params;
-            ParameterSymbol::fromSyntax(compilation, *declaration, isLocal, false, params);
+            ParameterSymbol::fromSyntax(getCompilation(), *declaration, isLocal, false, params);
 
             for (auto param : params) {
-                parameters.append(param);
-                result->addMember(*param);
+                bodyParams.append(param);
+                addMember(*param);
             }
         }
     }
 
-    result->parameters = parameters.copy(compilation);
-    return *result;
+    if (!bodyParams.empty()) {
+        SmallVectorSized<const ParameterSymbol*, 8> allParams;
+        allParams.appendRange(parameters);
+        allParams.appendRange(bodyParams);
+        parameters = allParams.copy(getCompilation());
+    }
 }
 
 void DefinitionSymbol::toJson(json& j) const {
@@ -203,7 +250,7 @@ void InstanceSymbol::fromSyntax(Compilation& compilation,
         // For each parameter assignment we have, match it up to a real parameter
         if (orderedAssignments) {
             uint32_t orderedIndex = 0;
-            for (auto param : definition->parameters) {
+            for (auto param : definition->getParameters()) {
                 if (orderedIndex >= orderedParams.size())
                     break;
 
@@ -224,7 +271,7 @@ void InstanceSymbol::fromSyntax(Compilation& compilation,
         }
         else {
             // Otherwise handle named assignments.
-            for (auto param : definition->parameters) {
+            for (auto param : definition->getParameters()) {
                 auto it = namedParams.find(param->name);
                 if (it == namedParams.end())
                     continue;
@@ -264,7 +311,7 @@ void InstanceSymbol::fromSyntax(Compilation& compilation,
 
     // Determine values for all parameters now so that they can be shared between instances.
     SmallVectorSized<const Expression*, 8> overrides;
-    for (auto param : definition->parameters) {
+    for (auto param : definition->getParameters()) {
         if (auto it = paramOverrides.find(param->name); it != paramOverrides.end()) {
             auto declared = param->getDeclaredType();
             auto typeSyntax = declared->getTypeSyntax();
@@ -324,10 +371,11 @@ void InstanceSymbol::populate(const HierarchicalInstanceSyntax* instanceSyntax,
                               span<const Expression* const> parameterOverides) {
     // Add all port parameters as members first.
     Compilation& comp = getCompilation();
-    auto paramIt = definition.parameters.begin();
+    auto parameters = definition.getParameters();
+    auto paramIt = parameters.begin();
     auto overrideIt = parameterOverides.begin();
 
-    while (paramIt != definition.parameters.end()) {
+    while (paramIt != parameters.end()) {
         auto original = *paramIt;
         if (!original->isPortParam())
             break;
@@ -359,7 +407,7 @@ void InstanceSymbol::populate(const HierarchicalInstanceSyntax* instanceSyntax,
             for (auto declarator :
                  member->as<ParameterDeclarationStatementSyntax>().parameter->declarators) {
 
-                ASSERT(paramIt != definition.parameters.end());
+                ASSERT(paramIt != parameters.end());
                 ASSERT(overrideIt != parameterOverides.end());
                 ASSERT(declarator->name.valueText() == (*paramIt)->name);
 
@@ -376,7 +424,7 @@ ModuleInstanceSymbol& ModuleInstanceSymbol::instantiate(Compilation& compilation
                                                         SourceLocation loc,
                                                         const DefinitionSymbol& definition) {
     SmallVectorSized<const Expression*, 8> overrides;
-    for (auto param : definition.parameters) {
+    for (auto param : definition.getParameters()) {
         (void)param;
         overrides.emplace(nullptr);
     }
@@ -440,6 +440,12 @@ Symbol::Index Scope::getInsertionIndex(const Symbol& at) const {
 
 void Scope::elaborate() const {
     ASSERT(deferredMemberIndex != DeferredMemberIndex::Invalid);
+
+    // A definition whose body the parser skimmed adds the body's members first,
+    // since they can have deferred members of their own.
+    if (thisSym->kind == SymbolKind::Definition)
+        thisSym->as<DefinitionSymbol>().addSkimmedBody();
+
     auto deferredData = compilation.getOrAddDeferredData(deferredMemberIndex);
     deferredMemberIndex = DeferredMemberIndex::Invalid;
 
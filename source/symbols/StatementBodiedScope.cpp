@@ -23,11 +23,16 @@ void StatementBodiedScope::setBody(const SyntaxList<SyntaxNode>& newSyntax) {
 
 void StatementBodiedScope::bindBody() {
     ASSERT(sourceSyntax);
-    if (sourceSyntax->kind == SyntaxKind::SyntaxList)
+    if (sourceSyntax->kind == SyntaxKind::SyntaxList) {
+        // The list might be the items of a subroutine whose body the parser skimmed.
+        if (sourceSyntax->parent)
+            sourceSyntax->parent->parseSkimmedBody();
         setBody(&bindStatementList(*(const SyntaxList<SyntaxNode>*)sourceSyntax));
-    else
+    }
+    else {
         setBody(&bindStatement(sourceSyntax->as<StatementSyntax>(),
                                BindContext(*this, LookupLocation::max)));
+    }
 }
 
 Statement& StatementBodiedScope::bindStatement(const StatementSyntax& syntax,
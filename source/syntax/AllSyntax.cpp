@@ -6,6 +6,8 @@
 //------------------------------------------------------------------------------
 #include "slang/syntax/AllSyntax.h"
 
+#include "slang/syntax/SyntaxSerializer.h"
+
 // This file contains all parse tree syntax node generated definitions.
 // It is auto-generated by the syntax_gen.py script under the scripts/ directory.
 
@@ -10791,6 +10793,1865 @@ WithFunctionSampleSyntax* WithFunctionSampleSyntax::clone(BumpAllocator& alloc)
     return alloc.emplace<WithFunctionSampleSyntax>(*this);
 }
 
+const uint64_t SyntaxDeserializer::SchemaHash = 0x787658fca463e570ull;
+
+SyntaxNode* SyntaxDeserializer::createNode(SyntaxKind kind) {
+    switch (kind) {
+        case SyntaxKind::ActionBlock: {
+            auto statement = readOptionalNode<StatementSyntax>();
+            auto elseClause = readOptionalNode<ElseClauseSyntax>();
+            return alloc.emplace<ActionBlockSyntax>(statement, elseClause);
+        }
+        case SyntaxKind::AnsiPortList: {
+            Token openParen = readToken();
+            auto ports = readSeparatedList<MemberSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<AnsiPortListSyntax>(openParen, ports, closeParen);
+        }
+        case SyntaxKind::ArgumentList: {
+            Token openParen = readToken();
+            auto parameters = readSeparatedList<ArgumentSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<ArgumentListSyntax>(openParen, parameters, closeParen);
+        }
+        case SyntaxKind::AssertionItemPortList: {
+            Token openParen = readToken();
+            auto ports = readSeparatedList<AssertionItemPortSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<AssertionItemPortListSyntax>(openParen, ports, closeParen);
+        }
+        case SyntaxKind::AssertionItemPort: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token local = readToken();
+            Token direction = readToken();
+            auto& type = readNode<DataTypeSyntax>();
+            auto& declarator = readNode<VariableDeclaratorSyntax>();
+            return alloc.emplace<AssertionItemPortSyntax>(attributes, local, direction, type, declarator);
+        }
+        case SyntaxKind::AssignmentPatternExpression: {
+            auto type = readOptionalNode<DataTypeSyntax>();
+            auto& pattern = readNode<AssignmentPatternSyntax>();
+            return alloc.emplace<AssignmentPatternExpressionSyntax>(type, pattern);
+        }
+        case SyntaxKind::AssignmentPatternItem: {
+            auto& key = readNode<ExpressionSyntax>();
+            Token colon = readToken();
+            auto& expr = readNode<ExpressionSyntax>();
+            return alloc.emplace<AssignmentPatternItemSyntax>(key, colon, expr);
+        }
+        case SyntaxKind::AttributeInstance: {
+            Token openParen = readToken();
+            auto specs = readSeparatedList<AttributeSpecSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<AttributeInstanceSyntax>(openParen, specs, closeParen);
+        }
+        case SyntaxKind::AttributeSpec: {
+            Token name = readToken();
+            auto value = readOptionalNode<EqualsValueClauseSyntax>();
+            return alloc.emplace<AttributeSpecSyntax>(name, value);
+        }
+        case SyntaxKind::BadExpression: {
+            auto& expr = readNode<ExpressionSyntax>();
+            return alloc.emplace<BadExpressionSyntax>(expr);
+        }
+        case SyntaxKind::BeginKeywordsDirective: {
+            Token directive = readToken();
+            Token versionSpecifier = readToken();
+            return alloc.emplace<BeginKeywordsDirectiveSyntax>(directive, versionSpecifier);
+        }
+        case SyntaxKind::BinaryBlockEventExpression: {
+            auto& left = readNode<BlockEventExpressionSyntax>();
+            Token orKeyword = readToken();
+            auto& right = readNode<BlockEventExpressionSyntax>();
+            return alloc.emplace<BinaryBlockEventExpressionSyntax>(left, orKeyword, right);
+        }
+        case SyntaxKind::BinaryEventExpression: {
+            auto& left = readNode<EventExpressionSyntax>();
+            Token operatorToken = readToken();
+            auto& right = readNode<EventExpressionSyntax>();
+            return alloc.emplace<BinaryEventExpressionSyntax>(left, operatorToken, right);
+        }
+        case SyntaxKind::AddAssignmentExpression:
+        case SyntaxKind::AddExpression:
+        case SyntaxKind::AndAssignmentExpression:
+        case SyntaxKind::AndSequenceExpression:
+        case SyntaxKind::ArithmeticLeftShiftAssignmentExpression:
+        case SyntaxKind::ArithmeticRightShiftAssignmentExpression:
+        case SyntaxKind::ArithmeticShiftLeftExpression:
+        case SyntaxKind::ArithmeticShiftRightExpression:
+        case SyntaxKind::AssignmentExpression:
+        case SyntaxKind::BinaryAndExpression:
+        case SyntaxKind::BinaryOrExpression:
+        case SyntaxKind::BinarySequenceDelayExpression:
+        case SyntaxKind::BinaryXnorExpression:
+        case SyntaxKind::BinaryXorExpression:
+        case SyntaxKind::CaseEqualityExpression:
+        case SyntaxKind::CaseInequalityExpression:
+        case SyntaxKind::DivideAssignmentExpression:
+        case SyntaxKind::DivideExpression:
+        case SyntaxKind::EqualityExpression:
+        case SyntaxKind::GreaterThanEqualExpression:
+        case SyntaxKind::GreaterThanExpression:
+        case SyntaxKind::IffPropertyExpression:
+        case SyntaxKind::ImpliesPropertyExpression:
+        case SyntaxKind::InequalityExpression:
+        case SyntaxKind::IntersectSequenceExpression:
+        case SyntaxKind::LessThanEqualExpression:
+        case SyntaxKind::LessThanExpression:
+        case SyntaxKind::LogicalAndExpression:
+        case SyntaxKind::LogicalEquivalenceExpression:
+        case SyntaxKind::LogicalImplicationExpression:
+        case SyntaxKind::LogicalLeftShiftAssignmentExpression:
+        case SyntaxKind::LogicalOrExpression:
+        case SyntaxKind::LogicalRightShiftAssignmentExpression:
+        case SyntaxKind::LogicalShiftLeftExpression:
+        case SyntaxKind::LogicalShiftRightExpression:
+        case SyntaxKind::ModAssignmentExpression:
+        case SyntaxKind::ModExpression:
+        case SyntaxKind::MultiplyAssignmentExpression:
+        case SyntaxKind::MultiplyExpression:
+        case SyntaxKind::NonOverlappedFollowedByPropertyExpression:
+        case SyntaxKind::NonOverlappedImplicationPropertyExpression:
+        case SyntaxKind::NonblockingAssignmentExpression:
+        case SyntaxKind::OrAssignmentExpression:
+        case SyntaxKind::OrSequenceExpression:
+        case SyntaxKind::OverlappedFollowedByPropertyExpression:
+        case SyntaxKind::OverlappedImplicationPropertyExpression:
+        case SyntaxKind::PowerExpression:
+        case SyntaxKind::SUntilPropertyExpression:
+        case SyntaxKind::SUntilWithPropertyExpression:
+        case SyntaxKind::SubtractAssignmentExpression:
+        case SyntaxKind::SubtractExpression:
+        case SyntaxKind::ThroughoutSequenceExpression:
+        case SyntaxKind::UntilPropertyExpression:
+        case SyntaxKind::UntilWithPropertyExpression:
+        case SyntaxKind::WildcardEqualityExpression:
+        case SyntaxKind::WildcardInequalityExpression:
+        case SyntaxKind::WithinSequenceExpression:
+        case SyntaxKind::XorAssignmentExpression: {
+            auto& left = readNode<ExpressionSyntax>();
+            Token operatorToken = readToken();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto& right = readNode<ExpressionSyntax>();
+            return alloc.emplace<BinaryExpressionSyntax>(kind, left, operatorToken, attributes, right);
+        }
+        case SyntaxKind::BitSelect: {
+            auto& expr = readNode<ExpressionSyntax>();
+            return alloc.emplace<BitSelectSyntax>(expr);
+        }
+        case SyntaxKind::BlockCoverageEvent: {
+            Token atat = readToken();
+            Token openParen = readToken();
+            auto& expr = readNode<BlockEventExpressionSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<BlockCoverageEventSyntax>(atat, openParen, expr, closeParen);
+        }
+        case SyntaxKind::ParallelBlockStatement:
+        case SyntaxKind::SequentialBlockStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token begin = readToken();
+            auto blockName = readOptionalNode<NamedBlockClauseSyntax>();
+            auto items = readList<SyntaxNode>();
+            Token end = readToken();
+            auto endBlockName = readOptionalNode<NamedBlockClauseSyntax>();
+            return alloc.emplace<BlockStatementSyntax>(kind, label, attributes, begin, blockName, items, end, endBlockName);
+        }
+        case SyntaxKind::CaseGenerate: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token keyword = readToken();
+            Token openParen = readToken();
+            auto& condition = readNode<ExpressionSyntax>();
+            Token closeParen = readToken();
+            auto items = readList<CaseItemSyntax>();
+            Token endCase = readToken();
+            return alloc.emplace<CaseGenerateSyntax>(attributes, keyword, openParen, condition, closeParen, items, endCase);
+        }
+        case SyntaxKind::CaseStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token uniqueOrPriority = readToken();
+            Token caseKeyword = readToken();
+            Token openParen = readToken();
+            auto& expr = readNode<ExpressionSyntax>();
+            Token closeParen = readToken();
+            Token matchesOrInside = readToken();
+            auto items = readList<CaseItemSyntax>();
+            Token endcase = readToken();
+            return alloc.emplace<CaseStatementSyntax>(label, attributes, uniqueOrPriority, caseKeyword, openParen, expr, closeParen, matchesOrInside, items, endcase);
+        }
+        case SyntaxKind::CastExpression: {
+            auto& left = readNode<ExpressionSyntax>();
+            Token apostrophe = readToken();
+            auto& right = readNode<ParenthesizedExpressionSyntax>();
+            return alloc.emplace<CastExpressionSyntax>(left, apostrophe, right);
+        }
+        case SyntaxKind::ChargeStrength: {
+            Token openParen = readToken();
+            Token strength = readToken();
+            Token closeParen = readToken();
+            return alloc.emplace<ChargeStrengthSyntax>(openParen, strength, closeParen);
+        }
+        case SyntaxKind::ClassDeclaration: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token virtualOrInterface = readToken();
+            Token classKeyword = readToken();
+            Token lifetime = readToken();
+            Token name = readToken();
+            auto parameters = readOptionalNode<ParameterPortListSyntax>();
+            auto extendsClause = readOptionalNode<ExtendsClauseSyntax>();
+            auto implementsClause = readOptionalNode<ImplementsClauseSyntax>();
+            Token semi = readToken();
+            auto items = readList<MemberSyntax>();
+            Token endClass = readToken();
+            auto endBlockName = readOptionalNode<NamedBlockClauseSyntax>();
+            return alloc.emplace<ClassDeclarationSyntax>(attributes, virtualOrInterface, classKeyword, lifetime, name, parameters, extendsClause, implementsClause, semi, items, endClass, endBlockName);
+        }
+        case SyntaxKind::ClassMethodDeclaration: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto qualifiers = readTokenList();
+            auto& declaration = readNode<FunctionDeclarationSyntax>();
+            return alloc.emplace<ClassMethodDeclarationSyntax>(attributes, qualifiers, declaration);
+        }
+        case SyntaxKind::ClassMethodPrototype: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto qualifiers = readTokenList();
+            auto& prototype = readNode<FunctionPrototypeSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<ClassMethodPrototypeSyntax>(attributes, qualifiers, prototype, semi);
+        }
+        case SyntaxKind::ClassName: {
+            Token identifier = readToken();
+            auto& parameters = readNode<ParameterValueAssignmentSyntax>();
+            return alloc.emplace<ClassNameSyntax>(identifier, parameters);
+        }
+        case SyntaxKind::ClassPropertyDeclaration: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto qualifiers = readTokenList();
+            auto& declaration = readNode<MemberSyntax>();
+            return alloc.emplace<ClassPropertyDeclarationSyntax>(attributes, qualifiers, declaration);
+        }
+        case SyntaxKind::ClassScope: {
+            auto& left = readNode<NameSyntax>();
+            Token separator = readToken();
+            return alloc.emplace<ClassScopeSyntax>(left, separator);
+        }
+        case SyntaxKind::ClockingDeclaration: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token globalOrDefault = readToken();
+            Token clocking = readToken();
+            Token blockName = readToken();
+            Token at = readToken();
+            auto event = readOptionalNode<ParenthesizedEventExpressionSyntax>();
+            Token eventIdentifier = readToken();
+            Token semi = readToken();
+            auto items = readList<ClockingItemSyntax>();
+            Token endClocking = readToken();
+            auto endBlockName = readOptionalNode<NamedBlockClauseSyntax>();
+            return alloc.emplace<ClockingDeclarationSyntax>(attributes, globalOrDefault, clocking, blockName, at, event, eventIdentifier, semi, items, endClocking, endBlockName);
+        }
+        case SyntaxKind::ClockingDirection: {
+            Token input = readToken();
+            auto inputSkew = readOptionalNode<ClockingSkewSyntax>();
+            Token output = readToken();
+            auto ouputSkew = readOptionalNode<ClockingSkewSyntax>();
+            Token inout = readToken();
+            return alloc.emplace<ClockingDirectionSyntax>(input, inputSkew, output, ouputSkew, inout);
+        }
+        case SyntaxKind::ClockingItem: {
+            Token defaultKeyword = readToken();
+            auto direction = readOptionalNode<ClockingDirectionSyntax>();
+            auto assignments = readSeparatedList<AttributeSpecSyntax>();
+            Token semi = readToken();
+            auto declaration = readOptionalNode<MemberSyntax>();
+            return alloc.emplace<ClockingItemSyntax>(defaultKeyword, direction, assignments, semi, declaration);
+        }
+        case SyntaxKind::ClockingSkew: {
+            Token edge = readToken();
+            Token hash = readToken();
+            auto value = readOptionalNode<ExpressionSyntax>();
+            return alloc.emplace<ClockingSkewSyntax>(edge, hash, value);
+        }
+        case SyntaxKind::ColonExpressionClause: {
+            Token colon = readToken();
+            auto& expr = readNode<ExpressionSyntax>();
+            return alloc.emplace<ColonExpressionClauseSyntax>(colon, expr);
+        }
+        case SyntaxKind::CompilationUnit: {
+            auto members = readList<MemberSyntax>();
+            Token endOfFile = readToken();
+            return alloc.emplace<CompilationUnitSyntax>(members, endOfFile);
+        }
+        case SyntaxKind::ConcatenationExpression: {
+            Token openBrace = readToken();
+            auto expressions = readSeparatedList<ExpressionSyntax>();
+            Token closeBrace = readToken();
+            return alloc.emplace<ConcatenationExpressionSyntax>(openBrace, expressions, closeBrace);
+        }
+        case SyntaxKind::ConcurrentAssertionMember: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto& statement = readNode<ConcurrentAssertionStatementSyntax>();
+            return alloc.emplace<ConcurrentAssertionMemberSyntax>(attributes, statement);
+        }
+        case SyntaxKind::AssertPropertyStatement:
+        case SyntaxKind::AssumePropertyStatement:
+        case SyntaxKind::CoverPropertyStatement:
+        case SyntaxKind::CoverSequenceStatement:
+        case SyntaxKind::ExpectPropertyStatement:
+        case SyntaxKind::RestrictPropertyStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token keyword = readToken();
+            Token propertyOrSequence = readToken();
+            Token openParen = readToken();
+            auto& propertySpec = readNode<PropertySpecSyntax>();
+            Token closeParen = readToken();
+            auto& action = readNode<ActionBlockSyntax>();
+            return alloc.emplace<ConcurrentAssertionStatementSyntax>(kind, label, attributes, keyword, propertyOrSequence, openParen, propertySpec, closeParen, action);
+        }
+        case SyntaxKind::ElsIfDirective:
+        case SyntaxKind::IfDefDirective:
+        case SyntaxKind::IfNDefDirective: {
+            Token directive = readToken();
+            Token name = readToken();
+            auto disabledTokens = readTokenList();
+            return alloc.emplace<ConditionalBranchDirectiveSyntax>(kind, directive, name, disabledTokens);
+        }
+        case SyntaxKind::ConditionalConstraint: {
+            Token ifKeyword = readToken();
+            Token openParen = readToken();
+            auto& condition = readNode<ExpressionSyntax>();
+            Token closeParen = readToken();
+            auto& constraints = readNode<ConstraintItemSyntax>();
+            auto elseClause = readOptionalNode<ElseConstraintClauseSyntax>();
+            return alloc.emplace<ConditionalConstraintSyntax>(ifKeyword, openParen, condition, closeParen, constraints, elseClause);
+        }
+        case SyntaxKind::ConditionalExpression: {
+            auto& predicate = readNode<ConditionalPredicateSyntax>();
+            Token question = readToken();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto& left = readNode<ExpressionSyntax>();
+            Token colon = readToken();
+            auto& right = readNode<ExpressionSyntax>();
+            return alloc.emplace<ConditionalExpressionSyntax>(predicate, question, attributes, left, colon, right);
+        }
+        case SyntaxKind::ConditionalPattern: {
+            auto& expr = readNode<ExpressionSyntax>();
+            auto matchesClause = readOptionalNode<MatchesClauseSyntax>();
+            return alloc.emplace<ConditionalPatternSyntax>(expr, matchesClause);
+        }
+        case SyntaxKind::ConditionalPredicate: {
+            auto conditions = readSeparatedList<ConditionalPatternSyntax>();
+            return alloc.emplace<ConditionalPredicateSyntax>(conditions);
+        }
+        case SyntaxKind::ConditionalStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token uniqueOrPriority = readToken();
+            Token ifKeyword = readToken();
+            Token openParen = readToken();
+            auto& predicate = readNode<ConditionalPredicateSyntax>();
+            Token closeParen = readToken();
+            auto& statement = readNode<StatementSyntax>();
+            auto elseClause = readOptionalNode<ElseClauseSyntax>();
+            return alloc.emplace<ConditionalStatementSyntax>(label, attributes, uniqueOrPriority, ifKeyword, openParen, predicate, closeParen, statement, elseClause);
+        }
+        case SyntaxKind::ConstraintBlock: {
+            Token openBrace = readToken();
+            auto items = readList<ConstraintItemSyntax>();
+            Token closeBrace = readToken();
+            return alloc.emplace<ConstraintBlockSyntax>(openBrace, items, closeBrace);
+        }
+        case SyntaxKind::ConstraintDeclaration: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto qualifiers = readTokenList();
+            Token keyword = readToken();
+            Token name = readToken();
+            auto& block = readNode<ConstraintBlockSyntax>();
+            return alloc.emplace<ConstraintDeclarationSyntax>(attributes, qualifiers, keyword, name, block);
+        }
+        case SyntaxKind::ConstraintPrototype: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto qualifiers = readTokenList();
+            Token keyword = readToken();
+            Token name = readToken();
+            Token semi = readToken();
+            return alloc.emplace<ConstraintPrototypeSyntax>(attributes, qualifiers, keyword, name, semi);
+        }
+        case SyntaxKind::ContinuousAssign: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token assign = readToken();
+            auto assignments = readSeparatedList<ExpressionSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<ContinuousAssignSyntax>(attributes, assign, assignments, semi);
+        }
+        case SyntaxKind::CoverageBins: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token wildcard = readToken();
+            Token keyword = readToken();
+            Token name = readToken();
+            auto selector = readOptionalNode<ElementSelectSyntax>();
+            Token equals = readToken();
+            auto& initializer = readNode<CoverageBinInitializerSyntax>();
+            auto iff = readOptionalNode<IffClauseSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<CoverageBinsSyntax>(attributes, wildcard, keyword, name, selector, equals, initializer, iff, semi);
+        }
+        case SyntaxKind::CoverageOption: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token option = readToken();
+            Token dot = readToken();
+            Token name = readToken();
+            Token equals = readToken();
+            auto& expr = readNode<ExpressionSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<CoverageOptionSyntax>(attributes, option, dot, name, equals, expr, semi);
+        }
+        case SyntaxKind::CovergroupDeclaration: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token covergroup = readToken();
+            Token name = readToken();
+            auto portList = readOptionalNode<AnsiPortListSyntax>();
+            auto event = readOptionalNode<SyntaxNode>();
+            Token semi = readToken();
+            auto members = readList<MemberSyntax>();
+            Token endgroup = readToken();
+            auto endBlockName = readOptionalNode<NamedBlockClauseSyntax>();
+            return alloc.emplace<CovergroupDeclarationSyntax>(attributes, covergroup, name, portList, event, semi, members, endgroup, endBlockName);
+        }
+        case SyntaxKind::Coverpoint: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto type = readOptionalNode<DataTypeSyntax>();
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            Token coverpoint = readToken();
+            auto& expr = readNode<ExpressionSyntax>();
+            Token openBrace = readToken();
+            auto members = readList<MemberSyntax>();
+            Token closeBrace = readToken();
+            Token emptySemi = readToken();
+            return alloc.emplace<CoverpointSyntax>(attributes, type, label, coverpoint, expr, openBrace, members, closeBrace, emptySemi);
+        }
+        case SyntaxKind::DPIImportExport: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token keyword = readToken();
+            Token stringLiteral = readToken();
+            Token property = readToken();
+            Token name = readToken();
+            Token equals = readToken();
+            auto& method = readNode<FunctionPrototypeSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<DPIImportExportSyntax>(attributes, keyword, stringLiteral, property, name, equals, method, semi);
+        }
+        case SyntaxKind::DataDeclaration: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto modifiers = readTokenList();
+            auto& type = readNode<DataTypeSyntax>();
+            auto declarators = readSeparatedList<VariableDeclaratorSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<DataDeclarationSyntax>(attributes, modifiers, type, declarators, semi);
+        }
+        case SyntaxKind::DefParamAssignment: {
+            auto& name = readNode<NameSyntax>();
+            auto setter = readOptionalNode<EqualsValueClauseSyntax>();
+            return alloc.emplace<DefParamAssignmentSyntax>(name, setter);
+        }
+        case SyntaxKind::DefParam: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token defparam = readToken();
+            auto assignments = readSeparatedList<DefParamAssignmentSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<DefParamSyntax>(attributes, defparam, assignments, semi);
+        }
+        case SyntaxKind::DefaultCaseItem: {
+            Token defaultKeyword = readToken();
+            Token colon = readToken();
+            auto& clause = readNode<SyntaxNode>();
+            return alloc.emplace<DefaultCaseItemSyntax>(defaultKeyword, colon, clause);
+        }
+        case SyntaxKind::DefaultCoverageBinInitializer: {
+            Token defaultKeyword = readToken();
+            Token sequenceKeyword = readToken();
+            return alloc.emplace<DefaultCoverageBinInitializerSyntax>(defaultKeyword, sequenceKeyword);
+        }
+        case SyntaxKind::DefaultNetTypeDirective: {
+            Token directive = readToken();
+            Token netType = readToken();
+            return alloc.emplace<DefaultNetTypeDirectiveSyntax>(directive, netType);
+        }
+        case SyntaxKind::DeferredAssertion: {
+            Token hash = readToken();
+            Token zero = readToken();
+            Token finalKeyword = readToken();
+            return alloc.emplace<DeferredAssertionSyntax>(hash, zero, finalKeyword);
+        }
+        case SyntaxKind::DefineDirective: {
+            Token directive = readToken();
+            Token name = readToken();
+            auto formalArguments = readOptionalNode<MacroFormalArgumentListSyntax>();
+            auto body = readTokenList();
+            return alloc.emplace<DefineDirectiveSyntax>(directive, name, formalArguments, body);
+        }
+        case SyntaxKind::CycleDelay:
+        case SyntaxKind::DelayControl: {
+            Token hash = readToken();
+            auto& delayValue = readNode<ExpressionSyntax>();
+            return alloc.emplace<DelaySyntax>(kind, hash, delayValue);
+        }
+        case SyntaxKind::DisableConstraint: {
+            Token disable = readToken();
+            Token soft = readToken();
+            auto& name = readNode<NameSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<DisableConstraintSyntax>(disable, soft, name, semi);
+        }
+        case SyntaxKind::DisableForkStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token disable = readToken();
+            Token fork = readToken();
+            Token semi = readToken();
+            return alloc.emplace<DisableForkStatementSyntax>(label, attributes, disable, fork, semi);
+        }
+        case SyntaxKind::DisableIff: {
+            Token disable = readToken();
+            Token iff = readToken();
+            Token openParen = readToken();
+            auto& expr = readNode<ExpressionSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<DisableIffSyntax>(disable, iff, openParen, expr, closeParen);
+        }
+        case SyntaxKind::DisableStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token disable = readToken();
+            auto& name = readNode<NameSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<DisableStatementSyntax>(label, attributes, disable, name, semi);
+        }
+        case SyntaxKind::DistConstraintList: {
+            Token dist = readToken();
+            Token openBrace = readToken();
+            auto items = readSeparatedList<DistItemSyntax>();
+            Token closeBrace = readToken();
+            return alloc.emplace<DistConstraintListSyntax>(dist, openBrace, items, closeBrace);
+        }
+        case SyntaxKind::DistItem: {
+            auto& range = readNode<ExpressionSyntax>();
+            auto weight = readOptionalNode<DistWeightSyntax>();
+            return alloc.emplace<DistItemSyntax>(range, weight);
+        }
+        case SyntaxKind::DistWeight: {
+            Token op = readToken();
+            auto& expr = readNode<ExpressionSyntax>();
+            return alloc.emplace<DistWeightSyntax>(op, expr);
+        }
+        case SyntaxKind::DividerClause: {
+            Token divide = readToken();
+            Token value = readToken();
+            return alloc.emplace<DividerClauseSyntax>(divide, value);
+        }
+        case SyntaxKind::DoWhileStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token doKeyword = readToken();
+            auto& statement = readNode<StatementSyntax>();
+            Token whileKeyword = readToken();
+            Token openParen = readToken();
+            auto& expr = readNode<ExpressionSyntax>();
+            Token closeParen = readToken();
+            Token semi = readToken();
+            return alloc.emplace<DoWhileStatementSyntax>(label, attributes, doKeyword, statement, whileKeyword, openParen, expr, closeParen, semi);
+        }
+        case SyntaxKind::DotMemberClause: {
+            Token dot = readToken();
+            Token member = readToken();
+            return alloc.emplace<DotMemberClauseSyntax>(dot, member);
+        }
+        case SyntaxKind::DriveStrength: {
+            Token openParen = readToken();
+            Token strength0 = readToken();
+            Token comma = readToken();
+            Token strength1 = readToken();
+            Token closeParen = readToken();
+            return alloc.emplace<DriveStrengthSyntax>(openParen, strength0, comma, strength1, closeParen);
+        }
+        case SyntaxKind::ElementSelectExpression: {
+            auto& left = readNode<ExpressionSyntax>();
+            auto& select = readNode<ElementSelectSyntax>();
+            return alloc.emplace<ElementSelectExpressionSyntax>(left, select);
+        }
+        case SyntaxKind::ElementSelect: {
+            Token openBracket = readToken();
+            auto selector = readOptionalNode<SelectorSyntax>();
+            Token closeBracket = readToken();
+            return alloc.emplace<ElementSelectSyntax>(openBracket, selector, closeBracket);
+        }
+        case SyntaxKind::ElseClause: {
+            Token elseKeyword = readToken();
+            auto& clause = readNode<SyntaxNode>();
+            return alloc.emplace<ElseClauseSyntax>(elseKeyword, clause);
+        }
+        case SyntaxKind::ElseConstraintClause: {
+            Token elseKeyword = readToken();
+            auto& constraints = readNode<ConstraintItemSyntax>();
+            return alloc.emplace<ElseConstraintClauseSyntax>(elseKeyword, constraints);
+        }
+        case SyntaxKind::EmptyArgument: {
+            return alloc.emplace<EmptyArgumentSyntax>();
+        }
+        case SyntaxKind::EmptyIdentifierName: {
+            return alloc.emplace<EmptyIdentifierNameSyntax>();
+        }
+        case SyntaxKind::EmptyMember: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto qualifiers = readTokenList();
+            Token semi = readToken();
+            return alloc.emplace<EmptyMemberSyntax>(attributes, qualifiers, semi);
+        }
+        case SyntaxKind::EmptyQueueExpression: {
+            Token openBrace = readToken();
+            Token closeBrace = readToken();
+            return alloc.emplace<EmptyQueueExpressionSyntax>(openBrace, closeBrace);
+        }
+        case SyntaxKind::EmptyStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token semicolon = readToken();
+            return alloc.emplace<EmptyStatementSyntax>(label, attributes, semicolon);
+        }
+        case SyntaxKind::EnumType: {
+            Token keyword = readToken();
+            auto baseType = readOptionalNode<DataTypeSyntax>();
+            Token openBrace = readToken();
+            auto members = readSeparatedList<VariableDeclaratorSyntax>();
+            Token closeBrace = readToken();
+            auto dimensions = readList<VariableDimensionSyntax>();
+            return alloc.emplace<EnumTypeSyntax>(keyword, baseType, openBrace, members, closeBrace, dimensions);
+        }
+        case SyntaxKind::EqualsValueClause: {
+            Token equals = readToken();
+            auto& expr = readNode<ExpressionSyntax>();
+            return alloc.emplace<EqualsValueClauseSyntax>(equals, expr);
+        }
+        case SyntaxKind::EventControl: {
+            Token at = readToken();
+            auto& eventName = readNode<NameSyntax>();
+            return alloc.emplace<EventControlSyntax>(at, eventName);
+        }
+        case SyntaxKind::EventControlWithExpression: {
+            Token at = readToken();
+            auto& expr = readNode<EventExpressionSyntax>();
+            return alloc.emplace<EventControlWithExpressionSyntax>(at, expr);
+        }
+        case SyntaxKind::BlockingEventTriggerStatement:
+        case SyntaxKind::NonblockingEventTriggerStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token trigger = readToken();
+            auto timing = readOptionalNode<TimingControlSyntax>();
+            auto& name = readNode<NameSyntax>();
+            return alloc.emplace<EventTriggerStatementSyntax>(kind, label, attributes, trigger, timing, name);
+        }
+        case SyntaxKind::ExplicitAnsiPort: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token direction = readToken();
+            Token dot = readToken();
+            Token name = readToken();
+            Token openParen = readToken();
+            auto expr = readOptionalNode<ExpressionSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<ExplicitAnsiPortSyntax>(attributes, direction, dot, name, openParen, expr, closeParen);
+        }
+        case SyntaxKind::ExplicitNonAnsiPort: {
+            Token dot = readToken();
+            Token name = readToken();
+            Token openParen = readToken();
+            auto expr = readOptionalNode<PortExpressionSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<ExplicitNonAnsiPortSyntax>(dot, name, openParen, expr, closeParen);
+        }
+        case SyntaxKind::ExpressionConstraint: {
+            Token soft = readToken();
+            auto& expr = readNode<ExpressionSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<ExpressionConstraintSyntax>(soft, expr, semi);
+        }
+        case SyntaxKind::ExpressionCoverageBinInitializer: {
+            auto& expr = readNode<ExpressionSyntax>();
+            auto withClause = readOptionalNode<WithClauseSyntax>();
+            return alloc.emplace<ExpressionCoverageBinInitializerSyntax>(expr, withClause);
+        }
+        case SyntaxKind::ExpressionOrDist: {
+            auto& expr = readNode<ExpressionSyntax>();
+            auto& distribution = readNode<DistConstraintListSyntax>();
+            return alloc.emplace<ExpressionOrDistSyntax>(expr, distribution);
+        }
+        case SyntaxKind::ExpressionPattern: {
+            auto& expr = readNode<ExpressionSyntax>();
+            return alloc.emplace<ExpressionPatternSyntax>(expr);
+        }
+        case SyntaxKind::ExpressionStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto& expr = readNode<ExpressionSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<ExpressionStatementSyntax>(label, attributes, expr, semi);
+        }
+        case SyntaxKind::ExtendsClause: {
+            Token keyword = readToken();
+            auto& baseName = readNode<NameSyntax>();
+            auto arguments = readOptionalNode<ArgumentListSyntax>();
+            return alloc.emplace<ExtendsClauseSyntax>(keyword, baseName, arguments);
+        }
+        case SyntaxKind::ExternModule: {
+            Token externKeyword = readToken();
+            auto& header = readNode<ModuleHeaderSyntax>();
+            return alloc.emplace<ExternModuleSyntax>(externKeyword, header);
+        }
+        case SyntaxKind::ForLoopStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token forKeyword = readToken();
+            Token openParen = readToken();
+            auto initializers = readSeparatedList<SyntaxNode>();
+            Token semi1 = readToken();
+            auto& stopExpr = readNode<ExpressionSyntax>();
+            Token semi2 = readToken();
+            auto steps = readSeparatedList<ExpressionSyntax>();
+            Token closeParen = readToken();
+            auto& statement = readNode<StatementSyntax>();
+            return alloc.emplace<ForLoopStatementSyntax>(label, attributes, forKeyword, openParen, initializers, semi1, stopExpr, semi2, steps, closeParen, statement);
+        }
+        case SyntaxKind::ForVariableDeclaration: {
+            Token varKeyword = readToken();
+            auto& type = readNode<DataTypeSyntax>();
+            auto& declarator = readNode<VariableDeclaratorSyntax>();
+            return alloc.emplace<ForVariableDeclarationSyntax>(varKeyword, type, declarator);
+        }
+        case SyntaxKind::ForeachLoopList: {
+            Token openParen = readToken();
+            auto& arrayName = readNode<NameSyntax>();
+            Token openBracket = readToken();
+            auto loopVariables = readSeparatedList<NameSyntax>();
+            Token closeBracket = readToken();
+            Token closeParen = readToken();
+            return alloc.emplace<ForeachLoopListSyntax>(openParen, arrayName, openBracket, loopVariables, closeBracket, closeParen);
+        }
+        case SyntaxKind::ForeachLoopStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token keyword = readToken();
+            auto& loopList = readNode<ForeachLoopListSyntax>();
+            auto& statement = readNode<StatementSyntax>();
+            return alloc.emplace<ForeachLoopStatementSyntax>(label, attributes, keyword, loopList, statement);
+        }
+        case SyntaxKind::ForeverStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token foreverKeyword = readToken();
+            auto& statement = readNode<StatementSyntax>();
+            return alloc.emplace<ForeverStatementSyntax>(label, attributes, foreverKeyword, statement);
+        }
+        case SyntaxKind::ForwardInterfaceClassTypedefDeclaration: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token typedefKeyword = readToken();
+            Token interfaceKeyword = readToken();
+            Token classKeyword = readToken();
+            Token name = readToken();
+            Token semi = readToken();
+            return alloc.emplace<ForwardInterfaceClassTypedefDeclarationSyntax>(attributes, typedefKeyword, interfaceKeyword, classKeyword, name, semi);
+        }
+        case SyntaxKind::ForwardTypedefDeclaration: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token typedefKeyword = readToken();
+            Token keyword = readToken();
+            Token name = readToken();
+            Token semi = readToken();
+            return alloc.emplace<ForwardTypedefDeclarationSyntax>(attributes, typedefKeyword, keyword, name, semi);
+        }
+        case SyntaxKind::FunctionDeclaration:
+        case SyntaxKind::TaskDeclaration: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto& prototype = readNode<FunctionPrototypeSyntax>();
+            Token semi = readToken();
+            auto items = readList<SyntaxNode>();
+            Token end = readToken();
+            auto endBlockName = readOptionalNode<NamedBlockClauseSyntax>();
+            return alloc.emplace<FunctionDeclarationSyntax>(kind, attributes, prototype, semi, items, end, endBlockName);
+        }
+        case SyntaxKind::FunctionPortList: {
+            Token openParen = readToken();
+            auto ports = readSeparatedList<FunctionPortSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<FunctionPortListSyntax>(openParen, ports, closeParen);
+        }
+        case SyntaxKind::FunctionPort: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token constKeyword = readToken();
+            Token direction = readToken();
+            Token varKeyword = readToken();
+            auto dataType = readOptionalNode<DataTypeSyntax>();
+            auto& declarator = readNode<VariableDeclaratorSyntax>();
+            return alloc.emplace<FunctionPortSyntax>(attributes, constKeyword, direction, varKeyword, dataType, declarator);
+        }
+        case SyntaxKind::FunctionPrototype: {
+            Token keyword = readToken();
+            Token lifetime = readToken();
+            auto returnType = readOptionalNode<DataTypeSyntax>();
+            auto& name = readNode<NameSyntax>();
+            auto portList = readOptionalNode<FunctionPortListSyntax>();
+            return alloc.emplace<FunctionPrototypeSyntax>(keyword, lifetime, returnType, name, portList);
+        }
+        case SyntaxKind::GenerateBlock: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            Token begin = readToken();
+            auto beginName = readOptionalNode<NamedBlockClauseSyntax>();
+            auto members = readList<MemberSyntax>();
+            Token end = readToken();
+            auto endName = readOptionalNode<NamedBlockClauseSyntax>();
+            return alloc.emplace<GenerateBlockSyntax>(attributes, label, begin, beginName, members, end, endName);
+        }
+        case SyntaxKind::GenerateRegion: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token keyword = readToken();
+            auto members = readList<MemberSyntax>();
+            Token endgenerate = readToken();
+            return alloc.emplace<GenerateRegionSyntax>(attributes, keyword, members, endgenerate);
+        }
+        case SyntaxKind::GenvarDeclaration: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token keyword = readToken();
+            auto identifiers = readSeparatedList<IdentifierNameSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<GenvarDeclarationSyntax>(attributes, keyword, identifiers, semi);
+        }
+        case SyntaxKind::HierarchicalInstance: {
+            Token name = readToken();
+            auto dimensions = readList<VariableDimensionSyntax>();
+            Token openParen = readToken();
+            auto connections = readSeparatedList<PortConnectionSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<HierarchicalInstanceSyntax>(name, dimensions, openParen, connections, closeParen);
+        }
+        case SyntaxKind::HierarchyInstantiation: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token type = readToken();
+            auto parameters = readOptionalNode<ParameterValueAssignmentSyntax>();
+            auto instances = readSeparatedList<HierarchicalInstanceSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<HierarchyInstantiationSyntax>(attributes, type, parameters, instances, semi);
+        }
+        case SyntaxKind::IdentifierList: {
+            Token openParen = readToken();
+            auto identifiers = readSeparatedList<IdentifierNameSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<IdentifierListSyntax>(openParen, identifiers, closeParen);
+        }
+        case SyntaxKind::IdentifierName: {
+            Token identifier = readToken();
+            return alloc.emplace<IdentifierNameSyntax>(identifier);
+        }
+        case SyntaxKind::IdentifierSelectName: {
+            Token identifier = readToken();
+            auto selectors = readList<ElementSelectSyntax>();
+            return alloc.emplace<IdentifierSelectNameSyntax>(identifier, selectors);
+        }
+        case SyntaxKind::IfGenerate: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token keyword = readToken();
+            Token openParen = readToken();
+            auto& condition = readNode<ExpressionSyntax>();
+            Token closeParen = readToken();
+            auto& block = readNode<MemberSyntax>();
+            auto elseClause = readOptionalNode<ElseClauseSyntax>();
+            return alloc.emplace<IfGenerateSyntax>(attributes, keyword, openParen, condition, closeParen, block, elseClause);
+        }
+        case SyntaxKind::IffClause: {
+            Token iff = readToken();
+            Token openParen = readToken();
+            auto& expr = readNode<ExpressionSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<IffClauseSyntax>(iff, openParen, expr, closeParen);
+        }
+        case SyntaxKind::ImmediateAssertionMember: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto& statement = readNode<ImmediateAssertionStatementSyntax>();
+            return alloc.emplace<ImmediateAssertionMemberSyntax>(attributes, statement);
+        }
+        case SyntaxKind::ImmediateAssertStatement:
+        case SyntaxKind::ImmediateAssumeStatement:
+        case SyntaxKind::ImmediateCoverStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token keyword = readToken();
+            auto delay = readOptionalNode<DeferredAssertionSyntax>();
+            auto& expr = readNode<ParenthesizedExpressionSyntax>();
+            auto& action = readNode<ActionBlockSyntax>();
+            return alloc.emplace<ImmediateAssertionStatementSyntax>(kind, label, attributes, keyword, delay, expr, action);
+        }
+        case SyntaxKind::ImplementsClause: {
+            Token keyword = readToken();
+            auto interfaces = readSeparatedList<NameSyntax>();
+            return alloc.emplace<ImplementsClauseSyntax>(keyword, interfaces);
+        }
+        case SyntaxKind::ImplicationConstraint: {
+            auto& left = readNode<ExpressionSyntax>();
+            Token arrow = readToken();
+            auto& constraints = readNode<ConstraintItemSyntax>();
+            return alloc.emplace<ImplicationConstraintSyntax>(left, arrow, constraints);
+        }
+        case SyntaxKind::ImplicitAnsiPort: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto& header = readNode<PortHeaderSyntax>();
+            auto& declarator = readNode<VariableDeclaratorSyntax>();
+            return alloc.emplace<ImplicitAnsiPortSyntax>(attributes, header, declarator);
+        }
+        case SyntaxKind::ImplicitEventControl: {
+            Token atStar = readToken();
+            return alloc.emplace<ImplicitEventControlSyntax>(atStar);
+        }
+        case SyntaxKind::ImplicitNonAnsiPort: {
+            auto expr = readOptionalNode<PortExpressionSyntax>();
+            return alloc.emplace<ImplicitNonAnsiPortSyntax>(expr);
+        }
+        case SyntaxKind::ImplicitType: {
+            Token signing = readToken();
+            auto dimensions = readList<VariableDimensionSyntax>();
+            return alloc.emplace<ImplicitTypeSyntax>(signing, dimensions);
+        }
+        case SyntaxKind::IncludeDirective: {
+            Token directive = readToken();
+            Token fileName = readToken();
+            return alloc.emplace<IncludeDirectiveSyntax>(directive, fileName);
+        }
+        case SyntaxKind::InsideExpression: {
+            auto& expr = readNode<ExpressionSyntax>();
+            Token inside = readToken();
+            auto& ranges = readNode<OpenRangeListSyntax>();
+            return alloc.emplace<InsideExpressionSyntax>(expr, inside, ranges);
+        }
+        case SyntaxKind::BitType:
+        case SyntaxKind::ByteType:
+        case SyntaxKind::IntType:
+        case SyntaxKind::IntegerType:
+        case SyntaxKind::LogicType:
+        case SyntaxKind::LongIntType:
+        case SyntaxKind::RegType:
+        case SyntaxKind::ShortIntType:
+        case SyntaxKind::TimeType: {
+            Token keyword = readToken();
+            Token signing = readToken();
+            auto dimensions = readList<VariableDimensionSyntax>();
+            return alloc.emplace<IntegerTypeSyntax>(kind, keyword, signing, dimensions);
+        }
+        case SyntaxKind::IntegerVectorExpression: {
+            Token size = readToken();
+            Token base = readToken();
+            Token value = readToken();
+            return alloc.emplace<IntegerVectorExpressionSyntax>(size, base, value);
+        }
+        case SyntaxKind::InterconnectPortHeader: {
+            Token direction = readToken();
+            Token interconnect = readToken();
+            auto type = readOptionalNode<DataTypeSyntax>();
+            return alloc.emplace<InterconnectPortHeaderSyntax>(direction, interconnect, type);
+        }
+        case SyntaxKind::InterfacePortHeader: {
+            Token nameOrKeyword = readToken();
+            auto modport = readOptionalNode<DotMemberClauseSyntax>();
+            return alloc.emplace<InterfacePortHeaderSyntax>(nameOrKeyword, modport);
+        }
+        case SyntaxKind::InvocationExpression: {
+            auto& left = readNode<ExpressionSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto arguments = readOptionalNode<ArgumentListSyntax>();
+            return alloc.emplace<InvocationExpressionSyntax>(left, attributes, arguments);
+        }
+        case SyntaxKind::JumpStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token breakOrContinue = readToken();
+            Token semi = readToken();
+            return alloc.emplace<JumpStatementSyntax>(label, attributes, breakOrContinue, semi);
+        }
+        case SyntaxKind::ArrayAndMethod:
+        case SyntaxKind::ArrayOrMethod:
+        case SyntaxKind::ArrayUniqueMethod:
+        case SyntaxKind::ArrayXorMethod:
+        case SyntaxKind::ConstructorName:
+        case SyntaxKind::LocalScope:
+        case SyntaxKind::RootScope:
+        case SyntaxKind::SuperHandle:
+        case SyntaxKind::SystemName:
+        case SyntaxKind::ThisHandle:
+        case SyntaxKind::UnitScope: {
+            Token keyword = readToken();
+            return alloc.emplace<KeywordNameSyntax>(kind, keyword);
+        }
+        case SyntaxKind::CHandleType:
+        case SyntaxKind::EventType:
+        case SyntaxKind::PropertyType:
+        case SyntaxKind::RealTimeType:
+        case SyntaxKind::RealType:
+        case SyntaxKind::SequenceType:
+        case SyntaxKind::ShortRealType:
+        case SyntaxKind::StringType:
+        case SyntaxKind::TypeType:
+        case SyntaxKind::Untyped:
+        case SyntaxKind::VoidType: {
+            Token keyword = readToken();
+            return alloc.emplace<KeywordTypeSyntax>(kind, keyword);
+        }
+        case SyntaxKind::LetDeclaration: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token let = readToken();
+            Token identifier = readToken();
+            auto portList = readOptionalNode<AssertionItemPortListSyntax>();
+            auto& initializer = readNode<EqualsValueClauseSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<LetDeclarationSyntax>(attributes, let, identifier, portList, initializer, semi);
+        }
+        case SyntaxKind::LineDirective: {
+            Token directive = readToken();
+            Token lineNumber = readToken();
+            Token fileName = readToken();
+            Token level = readToken();
+            return alloc.emplace<LineDirectiveSyntax>(directive, lineNumber, fileName, level);
+        }
+        case SyntaxKind::DefaultPatternKeyExpression:
+        case SyntaxKind::IntegerLiteralExpression:
+        case SyntaxKind::NullLiteralExpression:
+        case SyntaxKind::OneStepLiteralExpression:
+        case SyntaxKind::RealLiteralExpression:
+        case SyntaxKind::StringLiteralExpression:
+        case SyntaxKind::TimeLiteralExpression:
+        case SyntaxKind::UnbasedUnsizedLiteralExpression:
+        case SyntaxKind::WildcardLiteralExpression: {
+            Token literal = readToken();
+            return alloc.emplace<LiteralExpressionSyntax>(kind, literal);
+        }
+        case SyntaxKind::LoopConstraint: {
+            Token foreachKeyword = readToken();
+            auto& loopList = readNode<ForeachLoopListSyntax>();
+            auto& constraints = readNode<ConstraintItemSyntax>();
+            return alloc.emplace<LoopConstraintSyntax>(foreachKeyword, loopList, constraints);
+        }
+        case SyntaxKind::LoopGenerate: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token keyword = readToken();
+            Token openParen = readToken();
+            Token genvar = readToken();
+            Token identifier = readToken();
+            Token equals = readToken();
+            auto& initialExpr = readNode<ExpressionSyntax>();
+            Token semi1 = readToken();
+            auto& stopExpr = readNode<ExpressionSyntax>();
+            Token semi2 = readToken();
+            auto& iterationExpr = readNode<ExpressionSyntax>();
+            Token closeParen = readToken();
+            auto& block = readNode<MemberSyntax>();
+            return alloc.emplace<LoopGenerateSyntax>(attributes, keyword, openParen, genvar, identifier, equals, initialExpr, semi1, stopExpr, semi2, iterationExpr, closeParen, block);
+        }
+        case SyntaxKind::LoopStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token repeatOrWhile = readToken();
+            Token openParen = readToken();
+            auto& expr = readNode<ExpressionSyntax>();
+            Token closeParen = readToken();
+            auto& statement = readNode<StatementSyntax>();
+            return alloc.emplace<LoopStatementSyntax>(label, attributes, repeatOrWhile, openParen, expr, closeParen, statement);
+        }
+        case SyntaxKind::MacroActualArgumentList: {
+            Token openParen = readToken();
+            auto args = readSeparatedList<MacroActualArgumentSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<MacroActualArgumentListSyntax>(openParen, args, closeParen);
+        }
+        case SyntaxKind::MacroActualArgument: {
+            auto tokens = readTokenList();
+            return alloc.emplace<MacroActualArgumentSyntax>(tokens);
+        }
+        case SyntaxKind::MacroArgumentDefault: {
+            Token equals = readToken();
+            auto tokens = readTokenList();
+            return alloc.emplace<MacroArgumentDefaultSyntax>(equals, tokens);
+        }
+        case SyntaxKind::MacroFormalArgumentList: {
+            Token openParen = readToken();
+            auto args = readSeparatedList<MacroFormalArgumentSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<MacroFormalArgumentListSyntax>(openParen, args, closeParen);
+        }
+        case SyntaxKind::MacroFormalArgument: {
+            Token name = readToken();
+            auto defaultValue = readOptionalNode<MacroArgumentDefaultSyntax>();
+            return alloc.emplace<MacroFormalArgumentSyntax>(name, defaultValue);
+        }
+        case SyntaxKind::MacroUsage: {
+            Token directive = readToken();
+            auto args = readOptionalNode<MacroActualArgumentListSyntax>();
+            return alloc.emplace<MacroUsageSyntax>(directive, args);
+        }
+        case SyntaxKind::MatchesClause: {
+            Token matchesKeyword = readToken();
+            auto& pattern = readNode<PatternSyntax>();
+            return alloc.emplace<MatchesClauseSyntax>(matchesKeyword, pattern);
+        }
+        case SyntaxKind::MemberAccessExpression: {
+            auto& left = readNode<ExpressionSyntax>();
+            Token dot = readToken();
+            Token name = readToken();
+            return alloc.emplace<MemberAccessExpressionSyntax>(left, dot, name);
+        }
+        case SyntaxKind::MinTypMaxExpression: {
+            auto& min = readNode<ExpressionSyntax>();
+            Token colon1 = readToken();
+            auto& typ = readNode<ExpressionSyntax>();
+            Token colon2 = readToken();
+            auto& max = readNode<ExpressionSyntax>();
+            return alloc.emplace<MinTypMaxExpressionSyntax>(min, colon1, typ, colon2, max);
+        }
+        case SyntaxKind::ModportClockingPort: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token clocking = readToken();
+            Token name = readToken();
+            return alloc.emplace<ModportClockingPortSyntax>(attributes, clocking, name);
+        }
+        case SyntaxKind::ModportDeclaration: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token keyword = readToken();
+            auto items = readSeparatedList<ModportItemSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<ModportDeclarationSyntax>(attributes, keyword, items, semi);
+        }
+        case SyntaxKind::ModportExplicitPort: {
+            Token dot = readToken();
+            Token name = readToken();
+            Token openParen = readToken();
+            auto expr = readOptionalNode<ExpressionSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<ModportExplicitPortSyntax>(dot, name, openParen, expr, closeParen);
+        }
+        case SyntaxKind::ModportItem: {
+            Token name = readToken();
+            auto& ports = readNode<AnsiPortListSyntax>();
+            return alloc.emplace<ModportItemSyntax>(name, ports);
+        }
+        case SyntaxKind::ModportNamedPort: {
+            Token name = readToken();
+            return alloc.emplace<ModportNamedPortSyntax>(name);
+        }
+        case SyntaxKind::ModportSimplePortList: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token direction = readToken();
+            auto ports = readSeparatedList<ModportPortSyntax>();
+            return alloc.emplace<ModportSimplePortListSyntax>(attributes, direction, ports);
+        }
+        case SyntaxKind::ModportSubroutinePortList: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token importExport = readToken();
+            auto ports = readSeparatedList<ModportPortSyntax>();
+            return alloc.emplace<ModportSubroutinePortListSyntax>(attributes, importExport, ports);
+        }
+        case SyntaxKind::ModportSubroutinePort: {
+            auto& prototype = readNode<FunctionPrototypeSyntax>();
+            return alloc.emplace<ModportSubroutinePortSyntax>(prototype);
+        }
+        case SyntaxKind::InterfaceDeclaration:
+        case SyntaxKind::ModuleDeclaration:
+        case SyntaxKind::PackageDeclaration:
+        case SyntaxKind::ProgramDeclaration: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto& header = readNode<ModuleHeaderSyntax>();
+            auto members = readList<MemberSyntax>();
+            Token endmodule = readToken();
+            auto blockName = readOptionalNode<NamedBlockClauseSyntax>();
+            return alloc.emplace<ModuleDeclarationSyntax>(kind, attributes, header, members, endmodule, blockName);
+        }
+        case SyntaxKind::InterfaceHeader:
+        case SyntaxKind::ModuleHeader:
+        case SyntaxKind::PackageHeader:
+        case SyntaxKind::ProgramHeader: {
+            Token moduleKeyword = readToken();
+            Token lifetime = readToken();
+            Token name = readToken();
+            auto imports = readList<PackageImportDeclarationSyntax>();
+            auto parameters = readOptionalNode<ParameterPortListSyntax>();
+            auto ports = readOptionalNode<PortListSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<ModuleHeaderSyntax>(kind, moduleKeyword, lifetime, name, imports, parameters, ports, semi);
+        }
+        case SyntaxKind::MultipleConcatenationExpression: {
+            Token openBrace = readToken();
+            auto& expression = readNode<ExpressionSyntax>();
+            auto& concatenation = readNode<ConcatenationExpressionSyntax>();
+            Token closeBrace = readToken();
+            return alloc.emplace<MultipleConcatenationExpressionSyntax>(openBrace, expression, concatenation, closeBrace);
+        }
+        case SyntaxKind::NamedArgument: {
+            Token dot = readToken();
+            Token name = readToken();
+            Token openParen = readToken();
+            auto expr = readOptionalNode<ExpressionSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<NamedArgumentSyntax>(dot, name, openParen, expr, closeParen);
+        }
+        case SyntaxKind::NamedBlockClause: {
+            Token colon = readToken();
+            Token name = readToken();
+            return alloc.emplace<NamedBlockClauseSyntax>(colon, name);
+        }
+        case SyntaxKind::NamedLabel: {
+            Token name = readToken();
+            Token colon = readToken();
+            return alloc.emplace<NamedLabelSyntax>(name, colon);
+        }
+        case SyntaxKind::NamedPortConnection: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token dot = readToken();
+            Token name = readToken();
+            Token openParen = readToken();
+            auto expr = readOptionalNode<ExpressionSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<NamedPortConnectionSyntax>(attributes, dot, name, openParen, expr, closeParen);
+        }
+        case SyntaxKind::NamedStructurePatternMember: {
+            Token name = readToken();
+            Token colon = readToken();
+            auto& pattern = readNode<PatternSyntax>();
+            return alloc.emplace<NamedStructurePatternMemberSyntax>(name, colon, pattern);
+        }
+        case SyntaxKind::NamedType: {
+            auto& name = readNode<NameSyntax>();
+            return alloc.emplace<NamedTypeSyntax>(name);
+        }
+        case SyntaxKind::NetDeclaration: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token netType = readToken();
+            auto strength = readOptionalNode<NetStrengthSyntax>();
+            Token expansionHint = readToken();
+            auto& type = readNode<DataTypeSyntax>();
+            auto declarators = readSeparatedList<VariableDeclaratorSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<NetDeclarationSyntax>(attributes, netType, strength, expansionHint, type, declarators, semi);
+        }
+        case SyntaxKind::NetPortHeader: {
+            Token direction = readToken();
+            Token netType = readToken();
+            auto& dataType = readNode<DataTypeSyntax>();
+            return alloc.emplace<NetPortHeaderSyntax>(direction, netType, dataType);
+        }
+        case SyntaxKind::NewArrayExpression: {
+            Token newKeyword = readToken();
+            Token openBracket = readToken();
+            auto& sizeExpr = readNode<ExpressionSyntax>();
+            Token closeBracket = readToken();
+            auto initializer = readOptionalNode<ParenthesizedExpressionSyntax>();
+            return alloc.emplace<NewArrayExpressionSyntax>(newKeyword, openBracket, sizeExpr, closeBracket, initializer);
+        }
+        case SyntaxKind::NewClassExpression: {
+            auto classScope = readOptionalNode<ClassScopeSyntax>();
+            Token newKeyword = readToken();
+            auto arguments = readOptionalNode<ArgumentListSyntax>();
+            return alloc.emplace<NewClassExpressionSyntax>(classScope, newKeyword, arguments);
+        }
+        case SyntaxKind::NewExpression: {
+            Token newKeyword = readToken();
+            auto& expr = readNode<ExpressionSyntax>();
+            return alloc.emplace<NewExpressionSyntax>(newKeyword, expr);
+        }
+        case SyntaxKind::NonAnsiPortList: {
+            Token openParen = readToken();
+            auto ports = readSeparatedList<NonAnsiPortSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<NonAnsiPortListSyntax>(openParen, ports, closeParen);
+        }
+        case SyntaxKind::OpenRangeList: {
+            Token openBrace = readToken();
+            auto valueRanges = readSeparatedList<ExpressionSyntax>();
+            Token closeBrace = readToken();
+            return alloc.emplace<OpenRangeListSyntax>(openBrace, valueRanges, closeBrace);
+        }
+        case SyntaxKind::OrderedArgument: {
+            auto& expr = readNode<ExpressionSyntax>();
+            return alloc.emplace<OrderedArgumentSyntax>(expr);
+        }
+        case SyntaxKind::OrderedPortConnection: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto expr = readOptionalNode<ExpressionSyntax>();
+            return alloc.emplace<OrderedPortConnectionSyntax>(attributes, expr);
+        }
+        case SyntaxKind::OrderedStructurePatternMember: {
+            auto& pattern = readNode<PatternSyntax>();
+            return alloc.emplace<OrderedStructurePatternMemberSyntax>(pattern);
+        }
+        case SyntaxKind::PackageImportDeclaration: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token keyword = readToken();
+            auto items = readSeparatedList<PackageImportItemSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<PackageImportDeclarationSyntax>(attributes, keyword, items, semi);
+        }
+        case SyntaxKind::PackageImportItem: {
+            Token package = readToken();
+            Token doubleColon = readToken();
+            Token item = readToken();
+            return alloc.emplace<PackageImportItemSyntax>(package, doubleColon, item);
+        }
+        case SyntaxKind::ParameterDeclarationStatement: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto& parameter = readNode<ParameterDeclarationSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<ParameterDeclarationStatementSyntax>(attributes, parameter, semi);
+        }
+        case SyntaxKind::ParameterDeclaration: {
+            Token keyword = readToken();
+            auto& type = readNode<DataTypeSyntax>();
+            auto declarators = readSeparatedList<VariableDeclaratorSyntax>();
+            return alloc.emplace<ParameterDeclarationSyntax>(keyword, type, declarators);
+        }
+        case SyntaxKind::ParameterPortList: {
+            Token hash = readToken();
+            Token openParen = readToken();
+            auto declarations = readSeparatedList<ParameterDeclarationSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<ParameterPortListSyntax>(hash, openParen, declarations, closeParen);
+        }
+        case SyntaxKind::ParameterValueAssignment: {
+            Token hash = readToken();
+            auto& assignments = readNode<ArgumentListSyntax>();
+            return alloc.emplace<ParameterValueAssignmentSyntax>(hash, assignments);
+        }
+        case SyntaxKind::ParenImplicitEventControl: {
+            Token at = readToken();
+            Token openParenStarCloseParen = readToken();
+            return alloc.emplace<ParenImplicitEventControlSyntax>(at, openParenStarCloseParen);
+        }
+        case SyntaxKind::ParenthesizedEventExpression: {
+            Token openParen = readToken();
+            auto& expr = readNode<EventExpressionSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<ParenthesizedEventExpressionSyntax>(openParen, expr, closeParen);
+        }
+        case SyntaxKind::ParenthesizedExpression: {
+            Token openParen = readToken();
+            auto& expression = readNode<ExpressionSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<ParenthesizedExpressionSyntax>(openParen, expression, closeParen);
+        }
+        case SyntaxKind::PatternCaseItem: {
+            auto& pattern = readNode<PatternSyntax>();
+            Token tripleAnd = readToken();
+            auto expr = readOptionalNode<ExpressionSyntax>();
+            Token colon = readToken();
+            auto& statement = readNode<StatementSyntax>();
+            return alloc.emplace<PatternCaseItemSyntax>(pattern, tripleAnd, expr, colon, statement);
+        }
+        case SyntaxKind::PortConcatenation: {
+            Token openBrace = readToken();
+            auto references = readSeparatedList<PortReferenceSyntax>();
+            Token closeBrace = readToken();
+            return alloc.emplace<PortConcatenationSyntax>(openBrace, references, closeBrace);
+        }
+        case SyntaxKind::PortDeclaration: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto& header = readNode<PortHeaderSyntax>();
+            auto declarators = readSeparatedList<VariableDeclaratorSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<PortDeclarationSyntax>(attributes, header, declarators, semi);
+        }
+        case SyntaxKind::PortReference: {
+            Token name = readToken();
+            auto select = readOptionalNode<ElementSelectSyntax>();
+            return alloc.emplace<PortReferenceSyntax>(name, select);
+        }
+        case SyntaxKind::PostdecrementExpression:
+        case SyntaxKind::PostincrementExpression: {
+            auto& operand = readNode<ExpressionSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token operatorToken = readToken();
+            return alloc.emplace<PostfixUnaryExpressionSyntax>(kind, operand, attributes, operatorToken);
+        }
+        case SyntaxKind::AcceptOnPropertyExpression:
+        case SyntaxKind::AlwaysPropertyExpression:
+        case SyntaxKind::EventuallyPropertyExpression:
+        case SyntaxKind::NextTimePropertyExpression:
+        case SyntaxKind::RejectOnPropertyExpression:
+        case SyntaxKind::SAlwaysPropertyExpression:
+        case SyntaxKind::SEventuallyPropertyExpression:
+        case SyntaxKind::SNextTimePropertyExpression:
+        case SyntaxKind::SyncAcceptOnPropertyExpression:
+        case SyntaxKind::SyncRejectOnPropertyExpression:
+        case SyntaxKind::UnaryBitwiseAndExpression:
+        case SyntaxKind::UnaryBitwiseNandExpression:
+        case SyntaxKind::UnaryBitwiseNorExpression:
+        case SyntaxKind::UnaryBitwiseNotExpression:
+        case SyntaxKind::UnaryBitwiseOrExpression:
+        case SyntaxKind::UnaryBitwiseXnorExpression:
+        case SyntaxKind::UnaryBitwiseXorExpression:
+        case SyntaxKind::UnaryLogicalNotExpression:
+        case SyntaxKind::UnaryMinusExpression:
+        case SyntaxKind::UnaryNotPropertyExpression:
+        case SyntaxKind::UnaryPlusExpression:
+        case SyntaxKind::UnaryPredecrementExpression:
+        case SyntaxKind::UnaryPreincrementExpression:
+        case SyntaxKind::UnarySequenceDelayExpression:
+        case SyntaxKind::UnarySequenceEventExpression: {
+            Token operatorToken = readToken();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto& operand = readNode<ExpressionSyntax>();
+            return alloc.emplace<PrefixUnaryExpressionSyntax>(kind, operatorToken, attributes, operand);
+        }
+        case SyntaxKind::PrimaryBlockEventExpression: {
+            Token keyword = readToken();
+            auto& name = readNode<NameSyntax>();
+            return alloc.emplace<PrimaryBlockEventExpressionSyntax>(keyword, name);
+        }
+        case SyntaxKind::ProceduralAssignStatement:
+        case SyntaxKind::ProceduralForceStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token keyword = readToken();
+            auto& lvalue = readNode<ExpressionSyntax>();
+            Token equals = readToken();
+            auto& value = readNode<ExpressionSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<ProceduralAssignStatementSyntax>(kind, label, attributes, keyword, lvalue, equals, value, semi);
+        }
+        case SyntaxKind::AlwaysBlock:
+        case SyntaxKind::AlwaysCombBlock:
+        case SyntaxKind::AlwaysFFBlock:
+        case SyntaxKind::AlwaysLatchBlock:
+        case SyntaxKind::FinalBlock:
+        case SyntaxKind::InitialBlock: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token keyword = readToken();
+            auto& statement = readNode<StatementSyntax>();
+            return alloc.emplace<ProceduralBlockSyntax>(kind, attributes, keyword, statement);
+        }
+        case SyntaxKind::ProceduralDeassignStatement:
+        case SyntaxKind::ProceduralReleaseStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token keyword = readToken();
+            auto& variable = readNode<ExpressionSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<ProceduralDeassignStatementSyntax>(kind, label, attributes, keyword, variable, semi);
+        }
+        case SyntaxKind::PropertyDeclaration: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token keyword = readToken();
+            Token name = readToken();
+            auto portList = readOptionalNode<AssertionItemPortListSyntax>();
+            Token semi = readToken();
+            auto assertionVariables = readList<MemberSyntax>();
+            auto& propertySpec = readNode<PropertySpecSyntax>();
+            Token optionalSemi = readToken();
+            Token end = readToken();
+            auto endBlockName = readOptionalNode<NamedBlockClauseSyntax>();
+            return alloc.emplace<PropertyDeclarationSyntax>(attributes, keyword, name, portList, semi, assertionVariables, propertySpec, optionalSemi, end, endBlockName);
+        }
+        case SyntaxKind::PropertySpec: {
+            auto clocking = readOptionalNode<TimingControlSyntax>();
+            auto disable = readOptionalNode<DisableIffSyntax>();
+            auto& expr = readNode<ExpressionSyntax>();
+            return alloc.emplace<PropertySpecSyntax>(clocking, disable, expr);
+        }
+        case SyntaxKind::QueueDimensionSpecifier: {
+            Token dollar = readToken();
+            auto maxSizeClause = readOptionalNode<ColonExpressionClauseSyntax>();
+            return alloc.emplace<QueueDimensionSpecifierSyntax>(dollar, maxSizeClause);
+        }
+        case SyntaxKind::RandCaseItem: {
+            auto& expr = readNode<ExpressionSyntax>();
+            Token colon = readToken();
+            auto& statement = readNode<StatementSyntax>();
+            return alloc.emplace<RandCaseItemSyntax>(expr, colon, statement);
+        }
+        case SyntaxKind::RandCaseStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token randCase = readToken();
+            auto items = readList<RandCaseItemSyntax>();
+            Token endCase = readToken();
+            return alloc.emplace<RandCaseStatementSyntax>(label, attributes, randCase, items, endCase);
+        }
+        case SyntaxKind::RandomizeMethodWithClause: {
+            Token with = readToken();
+            auto names = readOptionalNode<IdentifierListSyntax>();
+            auto& constraints = readNode<ConstraintBlockSyntax>();
+            return alloc.emplace<RandomizeMethodWithClauseSyntax>(with, names, constraints);
+        }
+        case SyntaxKind::RangeCoverageBinInitializer: {
+            auto& ranges = readNode<OpenRangeListSyntax>();
+            auto withClause = readOptionalNode<WithClauseSyntax>();
+            return alloc.emplace<RangeCoverageBinInitializerSyntax>(ranges, withClause);
+        }
+        case SyntaxKind::RangeDimensionSpecifier: {
+            auto& selector = readNode<SelectorSyntax>();
+            return alloc.emplace<RangeDimensionSpecifierSyntax>(selector);
+        }
+        case SyntaxKind::AscendingRangeSelect:
+        case SyntaxKind::DescendingRangeSelect:
+        case SyntaxKind::SimpleRangeSelect: {
+            auto& left = readNode<ExpressionSyntax>();
+            Token range = readToken();
+            auto& right = readNode<ExpressionSyntax>();
+            return alloc.emplace<RangeSelectSyntax>(kind, left, range, right);
+        }
+        case SyntaxKind::RepeatedEventControl: {
+            Token repeat = readToken();
+            Token openParen = readToken();
+            auto& expr = readNode<ExpressionSyntax>();
+            Token closeParen = readToken();
+            auto eventControl = readOptionalNode<TimingControlSyntax>();
+            return alloc.emplace<RepeatedEventControlSyntax>(repeat, openParen, expr, closeParen, eventControl);
+        }
+        case SyntaxKind::ReplicatedAssignmentPattern: {
+            Token openBrace = readToken();
+            auto& countExpr = readNode<ExpressionSyntax>();
+            Token innerOpenBrace = readToken();
+            auto items = readSeparatedList<ExpressionSyntax>();
+            Token innerCloseBrace = readToken();
+            Token closeBrace = readToken();
+            return alloc.emplace<ReplicatedAssignmentPatternSyntax>(openBrace, countExpr, innerOpenBrace, items, innerCloseBrace, closeBrace);
+        }
+        case SyntaxKind::ReturnStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token returnKeyword = readToken();
+            auto returnValue = readOptionalNode<ExpressionSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<ReturnStatementSyntax>(label, attributes, returnKeyword, returnValue, semi);
+        }
+        case SyntaxKind::ScopedName: {
+            auto& left = readNode<NameSyntax>();
+            Token separator = readToken();
+            auto& right = readNode<NameSyntax>();
+            return alloc.emplace<ScopedNameSyntax>(left, separator, right);
+        }
+        case SyntaxKind::SequenceDeclaration: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token keyword = readToken();
+            Token name = readToken();
+            auto portList = readOptionalNode<AssertionItemPortListSyntax>();
+            Token semi = readToken();
+            auto assertionVariables = readList<MemberSyntax>();
+            auto& seqExpr = readNode<ExpressionSyntax>();
+            Token optionalSemi = readToken();
+            Token end = readToken();
+            auto endBlockName = readOptionalNode<NamedBlockClauseSyntax>();
+            return alloc.emplace<SequenceDeclarationSyntax>(attributes, keyword, name, portList, semi, assertionVariables, seqExpr, optionalSemi, end, endBlockName);
+        }
+        case SyntaxKind::ShortcutCycleDelayRange: {
+            Token doubleHash = readToken();
+            Token openBracket = readToken();
+            Token op = readToken();
+            Token closeBracket = readToken();
+            return alloc.emplace<ShortcutCycleDelayRangeSyntax>(doubleHash, openBracket, op, closeBracket);
+        }
+        case SyntaxKind::SignalEventExpression: {
+            Token edge = readToken();
+            auto& expr = readNode<ExpressionSyntax>();
+            return alloc.emplace<SignalEventExpressionSyntax>(edge, expr);
+        }
+        case SyntaxKind::SignedCastExpression: {
+            Token signing = readToken();
+            Token apostrophe = readToken();
+            auto& inner = readNode<ParenthesizedExpressionSyntax>();
+            return alloc.emplace<SignedCastExpressionSyntax>(signing, apostrophe, inner);
+        }
+        case SyntaxKind::SimpleAssignmentPattern: {
+            Token openBrace = readToken();
+            auto items = readSeparatedList<ExpressionSyntax>();
+            Token closeBrace = readToken();
+            return alloc.emplace<SimpleAssignmentPatternSyntax>(openBrace, items, closeBrace);
+        }
+        case SyntaxKind::CellDefineDirective:
+        case SyntaxKind::EndCellDefineDirective:
+        case SyntaxKind::EndKeywordsDirective:
+        case SyntaxKind::NoUnconnectedDriveDirective:
+        case SyntaxKind::PragmaDirective:
+        case SyntaxKind::ResetAllDirective:
+        case SyntaxKind::UnconnectedDriveDirective:
+        case SyntaxKind::UndefineAllDirective: {
+            Token directive = readToken();
+            return alloc.emplace<SimpleDirectiveSyntax>(kind, directive);
+        }
+        case SyntaxKind::SolveBeforeConstraint: {
+            Token solve = readToken();
+            auto beforeExpr = readSeparatedList<ExpressionSyntax>();
+            Token before = readToken();
+            auto afterExpr = readSeparatedList<ExpressionSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<SolveBeforeConstraintSyntax>(solve, beforeExpr, before, afterExpr, semi);
+        }
+        case SyntaxKind::StandardCaseItem: {
+            auto expressions = readSeparatedList<ExpressionSyntax>();
+            Token colon = readToken();
+            auto& clause = readNode<SyntaxNode>();
+            return alloc.emplace<StandardCaseItemSyntax>(expressions, colon, clause);
+        }
+        case SyntaxKind::StreamExpression: {
+            auto& expression = readNode<ExpressionSyntax>();
+            auto withRange = readOptionalNode<StreamExpressionWithRange>();
+            return alloc.emplace<StreamExpressionSyntax>(expression, withRange);
+        }
+        case SyntaxKind::StreamExpressionWithRange: {
+            Token withKeyword = readToken();
+            auto& range = readNode<ElementSelectSyntax>();
+            return alloc.emplace<StreamExpressionWithRange>(withKeyword, range);
+        }
+        case SyntaxKind::StreamingConcatenationExpression: {
+            Token openBrace = readToken();
+            Token operatorToken = readToken();
+            auto sliceSize = readOptionalNode<ExpressionSyntax>();
+            Token innerOpenBrace = readToken();
+            auto expressions = readSeparatedList<StreamExpressionSyntax>();
+            Token innerCloseBrace = readToken();
+            Token closeBrace = readToken();
+            return alloc.emplace<StreamingConcatenationExpressionSyntax>(openBrace, operatorToken, sliceSize, innerOpenBrace, expressions, innerCloseBrace, closeBrace);
+        }
+        case SyntaxKind::StructUnionMember: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token randomQualifier = readToken();
+            auto& type = readNode<DataTypeSyntax>();
+            auto declarators = readSeparatedList<VariableDeclaratorSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<StructUnionMemberSyntax>(attributes, randomQualifier, type, declarators, semi);
+        }
+        case SyntaxKind::StructType:
+        case SyntaxKind::UnionType: {
+            Token keyword = readToken();
+            Token tagged = readToken();
+            Token packed = readToken();
+            Token signing = readToken();
+            Token openBrace = readToken();
+            auto members = readList<StructUnionMemberSyntax>();
+            Token closeBrace = readToken();
+            auto dimensions = readList<VariableDimensionSyntax>();
+            return alloc.emplace<StructUnionTypeSyntax>(kind, keyword, tagged, packed, signing, openBrace, members, closeBrace, dimensions);
+        }
+        case SyntaxKind::StructurePattern: {
+            Token openBrace = readToken();
+            auto members = readSeparatedList<StructurePatternMemberSyntax>();
+            Token closeBrace = readToken();
+            return alloc.emplace<StructurePatternSyntax>(openBrace, members, closeBrace);
+        }
+        case SyntaxKind::StructuredAssignmentPattern: {
+            Token openBrace = readToken();
+            auto items = readSeparatedList<AssignmentPatternItemSyntax>();
+            Token closeBrace = readToken();
+            return alloc.emplace<StructuredAssignmentPatternSyntax>(openBrace, items, closeBrace);
+        }
+        case SyntaxKind::TaggedPattern: {
+            Token tagged = readToken();
+            Token memberName = readToken();
+            auto pattern = readOptionalNode<PatternSyntax>();
+            return alloc.emplace<TaggedPatternSyntax>(tagged, memberName, pattern);
+        }
+        case SyntaxKind::TaggedUnionExpression: {
+            Token tagged = readToken();
+            Token member = readToken();
+            auto expr = readOptionalNode<ExpressionSyntax>();
+            return alloc.emplace<TaggedUnionExpressionSyntax>(tagged, member, expr);
+        }
+        case SyntaxKind::TimeUnitsDeclaration: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token keyword = readToken();
+            Token time = readToken();
+            auto divider = readOptionalNode<DividerClauseSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<TimeUnitsDeclarationSyntax>(attributes, keyword, time, divider, semi);
+        }
+        case SyntaxKind::TimescaleDirective: {
+            Token directive = readToken();
+            Token timeUnit = readToken();
+            Token timeUnitUnit = readToken();
+            Token slash = readToken();
+            Token timePrecision = readToken();
+            Token timePrecisionUnit = readToken();
+            return alloc.emplace<TimescaleDirectiveSyntax>(directive, timeUnit, timeUnitUnit, slash, timePrecision, timePrecisionUnit);
+        }
+        case SyntaxKind::TimingControlExpressionConcatenation: {
+            auto& left = readNode<ExpressionSyntax>();
+            auto& timing = readNode<TimingControlSyntax>();
+            auto& right = readNode<ExpressionSyntax>();
+            return alloc.emplace<TimingControlExpressionConcatenationSyntax>(left, timing, right);
+        }
+        case SyntaxKind::TimingControlExpression: {
+            auto& timing = readNode<TimingControlSyntax>();
+            auto& expr = readNode<ExpressionSyntax>();
+            return alloc.emplace<TimingControlExpressionSyntax>(timing, expr);
+        }
+        case SyntaxKind::TimingControlStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            auto& timingControl = readNode<TimingControlSyntax>();
+            auto& statement = readNode<StatementSyntax>();
+            return alloc.emplace<TimingControlStatementSyntax>(label, attributes, timingControl, statement);
+        }
+        case SyntaxKind::TransListCoverageBinInitializer: {
+            auto sets = readSeparatedList<TransSetSyntax>();
+            auto withClause = readOptionalNode<WithClauseSyntax>();
+            return alloc.emplace<TransListCoverageBinInitializerSyntax>(sets, withClause);
+        }
+        case SyntaxKind::TransRange: {
+            auto items = readSeparatedList<ExpressionSyntax>();
+            auto repeat = readOptionalNode<TransRepeatRangeSyntax>();
+            return alloc.emplace<TransRangeSyntax>(items, repeat);
+        }
+        case SyntaxKind::TransRepeatRange: {
+            Token openBracket = readToken();
+            Token specifier = readToken();
+            auto selector = readOptionalNode<SelectorSyntax>();
+            Token closeBracket = readToken();
+            return alloc.emplace<TransRepeatRangeSyntax>(openBracket, specifier, selector, closeBracket);
+        }
+        case SyntaxKind::TransSet: {
+            Token openParen = readToken();
+            auto ranges = readSeparatedList<TransRangeSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<TransSetSyntax>(openParen, ranges, closeParen);
+        }
+        case SyntaxKind::TypeReference: {
+            Token typeKeyword = readToken();
+            Token openParen = readToken();
+            auto& expr = readNode<ExpressionSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<TypeReferenceSyntax>(typeKeyword, openParen, expr, closeParen);
+        }
+        case SyntaxKind::TypedefDeclaration: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token typedefKeyword = readToken();
+            auto& type = readNode<DataTypeSyntax>();
+            Token name = readToken();
+            auto dimensions = readList<VariableDimensionSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<TypedefDeclarationSyntax>(attributes, typedefKeyword, type, name, dimensions, semi);
+        }
+        case SyntaxKind::ElseDirective:
+        case SyntaxKind::EndIfDirective: {
+            Token directive = readToken();
+            auto disabledTokens = readTokenList();
+            return alloc.emplace<UnconditionalBranchDirectiveSyntax>(kind, directive, disabledTokens);
+        }
+        case SyntaxKind::UndefDirective: {
+            Token directive = readToken();
+            Token name = readToken();
+            return alloc.emplace<UndefDirectiveSyntax>(directive, name);
+        }
+        case SyntaxKind::UniquenessConstraint: {
+            Token unique = readToken();
+            auto& ranges = readNode<OpenRangeListSyntax>();
+            Token semi = readToken();
+            return alloc.emplace<UniquenessConstraintSyntax>(unique, ranges, semi);
+        }
+        case SyntaxKind::VarDataType: {
+            Token var = readToken();
+            auto& type = readNode<DataTypeSyntax>();
+            return alloc.emplace<VarDataTypeSyntax>(var, type);
+        }
+        case SyntaxKind::VariableDeclarator: {
+            Token name = readToken();
+            auto dimensions = readList<VariableDimensionSyntax>();
+            auto initializer = readOptionalNode<EqualsValueClauseSyntax>();
+            return alloc.emplace<VariableDeclaratorSyntax>(name, dimensions, initializer);
+        }
+        case SyntaxKind::VariableDimension: {
+            Token openBracket = readToken();
+            auto specifier = readOptionalNode<DimensionSpecifierSyntax>();
+            Token closeBracket = readToken();
+            return alloc.emplace<VariableDimensionSyntax>(openBracket, specifier, closeBracket);
+        }
+        case SyntaxKind::VariablePattern: {
+            Token dot = readToken();
+            Token variableName = readToken();
+            return alloc.emplace<VariablePatternSyntax>(dot, variableName);
+        }
+        case SyntaxKind::VariablePortHeader: {
+            Token direction = readToken();
+            Token varKeyword = readToken();
+            auto& dataType = readNode<DataTypeSyntax>();
+            return alloc.emplace<VariablePortHeaderSyntax>(direction, varKeyword, dataType);
+        }
+        case SyntaxKind::VirtualInterfaceType: {
+            Token virtualKeyword = readToken();
+            Token interfaceKeyword = readToken();
+            Token name = readToken();
+            auto parameters = readOptionalNode<ParameterValueAssignmentSyntax>();
+            auto modport = readOptionalNode<DotMemberClauseSyntax>();
+            return alloc.emplace<VirtualInterfaceTypeSyntax>(virtualKeyword, interfaceKeyword, name, parameters, modport);
+        }
+        case SyntaxKind::WaitForkStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token wait = readToken();
+            Token fork = readToken();
+            Token semi = readToken();
+            return alloc.emplace<WaitForkStatementSyntax>(label, attributes, wait, fork, semi);
+        }
+        case SyntaxKind::WaitOrderStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token wait_order = readToken();
+            Token openParen = readToken();
+            auto names = readSeparatedList<NameSyntax>();
+            Token closeParen = readToken();
+            auto& action = readNode<ActionBlockSyntax>();
+            return alloc.emplace<WaitOrderStatementSyntax>(label, attributes, wait_order, openParen, names, closeParen, action);
+        }
+        case SyntaxKind::WaitStatement: {
+            auto label = readOptionalNode<NamedLabelSyntax>();
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token wait = readToken();
+            Token openParen = readToken();
+            auto& expr = readNode<ExpressionSyntax>();
+            Token closeParen = readToken();
+            auto& statement = readNode<StatementSyntax>();
+            return alloc.emplace<WaitStatementSyntax>(label, attributes, wait, openParen, expr, closeParen, statement);
+        }
+        case SyntaxKind::WildcardDimensionSpecifier: {
+            Token star = readToken();
+            return alloc.emplace<WildcardDimensionSpecifierSyntax>(star);
+        }
+        case SyntaxKind::WildcardPattern: {
+            Token dotStar = readToken();
+            return alloc.emplace<WildcardPatternSyntax>(dotStar);
+        }
+        case SyntaxKind::WildcardPortConnection: {
+            auto attributes = readList<AttributeInstanceSyntax>();
+            Token dotStar = readToken();
+            return alloc.emplace<WildcardPortConnectionSyntax>(attributes, dotStar);
+        }
+        case SyntaxKind::WildcardPortList: {
+            Token openParen = readToken();
+            Token dotStar = readToken();
+            Token closeParen = readToken();
+            return alloc.emplace<WildcardPortListSyntax>(openParen, dotStar, closeParen);
+        }
+        case SyntaxKind::WithClause: {
+            Token with = readToken();
+            Token openParen = readToken();
+            auto& expr = readNode<ExpressionSyntax>();
+            Token closeParen = readToken();
+            return alloc.emplace<WithClauseSyntax>(with, openParen, expr, closeParen);
+        }
+        case SyntaxKind::WithFunctionSample: {
+            Token with = readToken();
+            Token function = readToken();
+            Token sample = readToken();
+            auto& portList = readNode<AnsiPortListSyntax>();
+            return alloc.emplace<WithFunctionSampleSyntax>(with, function, sample, portList);
+        }
+        default:
+            break;
+    }
+    throw CorruptDataException("Invalid syntax kind");
+}
+
 ActionBlockSyntax& SyntaxFactory::actionBlock(StatementSyntax* statement, ElseClauseSyntax* elseClause) {
     return *alloc.emplace<ActionBlockSyntax>(statement, elseClause);
 }
@@ -0,0 +1,54 @@
+//------------------------------------------------------------------------------
+// ParallelSyntaxTreeBuilder.cpp
+// Parses many source files at once on a thread pool.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#include "slang/syntax/ParallelSyntaxTreeBuilder.h"
+
+#include "slang/util/ThreadPool.h"
+
+namespace slang {
+
+ParallelSyntaxTreeBuilder::ParallelSyntaxTreeBuilder(SourceManager& sourceManager,
+                                                     const Bag& options, uint32_t threadCount) :
+    sourceManager(sourceManager),
+    options(options), threadCount(threadCount ? threadCount : ThreadPool::getDefaultThreadCount()) {
+}
+
+void ParallelSyntaxTreeBuilder::addFile(string_view path) {
+    sources.push_back({ std::string(path), SourceBuffer() });
+}
+
+void ParallelSyntaxTreeBuilder::addBuffer(const SourceBuffer& buffer) {
+    sources.push_back({ std::string(), buffer });
+}
+
+std::vector<std::shared_ptr<SyntaxTree>> ParallelSyntaxTreeBuilder::build() {
+    std::vector<std::shared_ptr<SyntaxTree>> results(sources.size());
+    uint32_t numThreads = std::min(threadCount, (uint32_t)sources.size());
+
+    if (numThreads <= 1) {
+        for (size_t i = 0; i < sources.size(); i++)
+            results[i] = parse(sources[i]);
+    }
+    else {
+        // Each task writes only to its own slot in the results list,
+        // which is what keeps the output in input order.
+        ThreadPool pool(numThreads);
+        for (size_t i = 0; i < sources.size(); i++)
+            pool.push([this, &results, i] { results[i] = parse(sources[i]); });
+        pool.waitForAll();
+    }
+
+    sources.clear();
+    return results;
+}
+
+std::shared_ptr<SyntaxTree> ParallelSyntaxTreeBuilder::parse(const Source& source) const {
+    if (source.buffer)
+        return SyntaxTree::fromBuffer(source.buffer, sourceManager, options);
+    return SyntaxTree::fromFile(source.path, sourceManager, options);
+}
+
+} // namespace slang
@@ -6,6 +6,7 @@
 //------------------------------------------------------------------------------
 #include "slang/syntax/SyntaxNode.h"
 
+#include "slang/parsing/DeferredBodyParser.h"
 #include "slang/syntax/AllSyntax.h"
 #include "slang/syntax/SyntaxPrinter.h"
 
@@ -33,39 +34,59 @@ ConstTokenOrSyntax::ConstTokenOrSyntax(TokenOrSyntax tos) {
         *this = tos.token();
 }
 
+void SyntaxNode::parseSkimmedBody() const {
+    if (skimmed)
+        DeferredBodyParser::parse(*this);
+}
+
 std::string SyntaxNode::toString() const {
     return SyntaxPrinter().print(*this).str();
 }
 
+// The first and last tokens are found with an explicit stack of the nodes being
+// searched, each with the number of its children not searched yet, rather than by
+// recursion, since trees for things like long chains of binary operators can get
+// very deep.
+
 Token SyntaxNode::getFirstToken() const {
-    uint32_t childCount = getChildCount();
-    for (uint32_t i = 0; i < childCount; i++) {
-        auto child = getChild(i);
+    SmallVectorSized<std::pair<const SyntaxNode*, uint32_t>, 16> stack;
+    stack.append({ this, getChildCount() });
+    while (!stack.empty()) {
+        auto& [node, remaining] = stack.back();
+        if (!remaining) {
+            stack.pop();
+            continue;
+        }
+
+        auto child = node->getChild(node->getChildCount() - remaining--);
         if (child.isToken()) {
             if (child.token())
                 return child.token();
         }
         else if (child.node()) {
-            auto result = child.node()->getFirstToken();
-            if (result)
-                return result;
+            stack.append({ child.node(), child.node()->getChildCount() });
         }
     }
     return Token();
 }
 
 Token SyntaxNode::getLastToken() const {
-    uint32_t childCount = getChildCount();
-    for (int i = int(childCount) - 1; i >= 0; i--) {
-        auto child = getChild(uint32_t(i));
+    SmallVectorSized<std::pair<const SyntaxNode*, uint32_t>, 16> stack;
+    stack.append({ this, getChildCount() });
+    while (!stack.empty()) {
+        auto& [node, remaining] = stack.back();
+        if (!remaining) {
+            stack.pop();
+            continue;
+        }
+
+        auto child = node->getChild(--remaining);
         if (child.isToken()) {
             if (child.token())
                 return child.token();
         }
         else if (child.node()) {
-            auto result = child.node()->getLastToken();
-            if (result)
-                return result;
+            stack.append({ child.node(), child.node()->getChildCount() });
         }
     }
     return Token();
@@ -78,6 +99,9 @@ SourceRange SyntaxNode::sourceRange() const {
 }
 
 ConstTokenOrSyntax SyntaxNode::getChild(uint32_t index) const {
+    if (skimmed)
+        DeferredBodyParser::parse(*this);
+
     GetChildVisitor visitor;
     return visit(visitor, index);
 }
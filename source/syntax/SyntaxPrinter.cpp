@@ -20,8 +20,12 @@ SyntaxPrinter& SyntaxPrinter::print(Trivia trivia) {
             if (includeDirectives)
                 print(*trivia.syntax());
             else if (includePreprocessed) {
-                for (const auto& t : trivia.syntax()->getFirstToken().trivia())
-                    print(t);
+                // The text of an inactive conditional region is attached to the
+                // directive that ends it, so leave that out along with the directive.
+                for (const auto& t : trivia.syntax()->getFirstToken().trivia()) {
+                    if (t.kind != TriviaKind::DisabledText)
+                        print(t);
+                }
             }
             break;
         case TriviaKind::SkippedSyntax:
@@ -87,12 +91,26 @@ SyntaxPrinter& SyntaxPrinter::print(Token token) {
 }
 
 SyntaxPrinter& SyntaxPrinter::print(const SyntaxNode& node) {
-    uint32_t childCount = node.getChildCount();
-    for (uint32_t i = 0; i < childCount; i++) {
-        if (auto childNode = node.childNode(i); childNode)
-            print(*childNode);
-        else if (auto token = node.childToken(i); token)
-            print(token);
+    // Walk the tree with an explicit stack rather than recursing, since trees for
+    // things like long chains of binary operators can get very deep. Children are
+    // pushed in reverse so that they come off the stack in order.
+    SmallVectorSized<ConstTokenOrSyntax, 32> stack;
+    stack.append(&node);
+    while (!stack.empty()) {
+        auto current = stack.back();
+        stack.pop();
+        if (current.isToken()) {
+            print(current.token());
+            continue;
+        }
+
+        auto& parent = *current.node();
+        for (uint32_t i = parent.getChildCount(); i > 0; i--) {
+            if (auto childNode = parent.childNode(i - 1); childNode)
+                stack.append(childNode);
+            else if (auto token = parent.childToken(i - 1); token)
+                stack.append(token);
+        }
     }
     return *this;
 }
@@ -135,10 +153,8 @@ void SyntaxPrinter::append(string_view text) {
             i++;
         }
 
-        for (; i < text.length(); i++) {
-            if (text[i] == '\r' || text[i] == '\n')
-                i++;
-        }
+        while (i < text.length() && (text[i] == '\r' || text[i] == '\n'))
+            i++;
 
         text = text.substr(i);
     }
@@ -0,0 +1,892 @@
+//------------------------------------------------------------------------------
+// SyntaxSerializer.cpp
+// Binary serialization of syntax trees.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#include "slang/syntax/SyntaxSerializer.h"
+
+#include <cstring>
+
+#include "slang/syntax/AllSyntax.h"
+#include "slang/syntax/SyntaxTree.h"
+#include "slang/util/Hash.h"
+
+// Serialized trees start with a Header, followed by three sections:
+// - strings: text that isn't in any source buffer, which other sections refer to by offset
+// - buffers: one entry per buffer the tree refers to, each one a BufferKind and then:
+//   - Main: nothing; this is the buffer the tree was parsed from
+//   - File: the absolute path of a file, a hash of its text, the location it was
+//           included from, and the name and kind of the include that found it
+//   - Text: the name of a buffer that wasn't loaded from disk, its text, the location
+//           it was included from, and the name and kind of the include that found it
+//   - Macro / MacroArg: the original location, the start and end of the expansion range,
+//                       and for Macro, the name of the macro
+//   Entries only refer to buffers that come before them.
+// - tree: the root node, the EOF token, and the diagnostics
+//
+// All integers in the sections are LEB128 varints, so they only take as many bytes as
+// they need. Other things are written as follows:
+// - location: the index of its buffer in the table, starting at 1, then the offset;
+//             or just 0 for an invalid location
+// - text: the length, and if it's not zero, one of:
+//   - 0 and an offset into the strings section
+//   - 1 if it starts in the same buffer right where the previous text ended
+//   - the index of the buffer it's in plus 1, and an offset into its text
+// - node: 0 for null, otherwise the kind plus 1 and then the children in order; lists
+//         are written as a count and then their elements, without a kind
+// - token: 0 for an invalid token, otherwise the kind plus 1, whether it's missing, its
+//          trivia and raw text, then 0 if it's located at its raw text or 1 and its
+//          location, and whatever else there is for its kind
+// - diagnostic: the code, location, arguments, ranges and notes
+
+namespace {
+
+using namespace slang;
+
+// Bump this whenever the format changes in a way that SchemaHash and the
+// size of the various kind enums wouldn't catch.
+constexpr uint32_t FormatVersion = 4;
+
+constexpr char Magic[8] = { 'S', 'L', 'A', 'N', 'G', 'S', 'Y', 'N' };
+
+struct Header {
+    char magic[8];
+    uint64_t key;
+    uint64_t stringsSize;
+    uint64_t buffersSize;
+    uint64_t treeSize;
+};
+
+enum class BufferKind { Main, File, Text, Macro, MacroArg };
+
+enum class ArgKind { String, SignedInt, UnsignedInt };
+
+// Gets the path that a buffer loaded from disk is compared by when loading,
+// or an empty path if the buffer doesn't seem to be from a file.
+fs::path getAbsolutePath(const SourceManager& sourceManager, BufferID id) {
+    std::error_code ec;
+    fs::path path = fs::absolute(fs::path(sourceManager.getRawFileName(id)), ec);
+    if (ec)
+        return {};
+    return path.lexically_normal();
+}
+
+// The deepest nesting of nodes that gets serialized; both writing and reading
+// are recursive, so this keeps deep trees and corrupt data from using up the stack.
+constexpr uint32_t MaxDepth = 4096;
+
+} // namespace
+
+namespace slang {
+
+SyntaxSerializer::SyntaxSerializer(const SourceManager& sourceManager) :
+    sourceManager(sourceManager) {
+}
+
+bool SyntaxSerializer::serialize(SyntaxTree& tree, std::vector<char>& output) {
+    if (!tree.source)
+        return false;
+
+    // Failed includes can start working without the text of the tree changing.
+    tree.parseSkimmedBodies();
+    for (auto& diag : tree.diagnostics()) {
+        if (diag.code == DiagCode::CouldNotOpenIncludeFile)
+            return false;
+    }
+
+    // The main buffer always comes first, and included files get written out even if
+    // nothing in the tree refers to them, since their text can still affect it.
+    SyntaxSerializer serializer(tree.sourceManager());
+    for (auto& file : tree.includedFiles)
+        serializer.includes.emplace(file.buffer.id.getId(), &file);
+
+    serializer.buffer(tree.source.id);
+    for (auto& file : tree.includedFiles)
+        serializer.buffer(file.buffer.id);
+
+    // Members shared with earlier versions of an edited tree can still be located in
+    // their buffers, which have the same text at those locations as the main one.
+    // Only the locations get mapped over; text pointing into those buffers is written
+    // out separately, since it isn't all at the same offsets in the main buffer.
+    for (auto id : tree.previousSources)
+        serializer.bufferIndices.emplace(id.getId(), 1);
+
+    serializer.node(tree.rootNode);
+    serializer.token(tree.eof);
+
+    Diagnostics& diagnostics = tree.diagnostics();
+    serializer.varint(diagnostics.size());
+    for (auto& diag : diagnostics)
+        serializer.diagnostic(diag);
+
+    if (!serializer.ok)
+        return false;
+
+    Header header;
+    memcpy(header.magic, Magic, sizeof(Magic));
+    header.key = getKey(tree.source, tree.options_);
+    header.stringsSize = serializer.strings.size();
+    header.buffersSize = serializer.buffers.size();
+    header.treeSize = serializer.tree.size();
+
+    auto headerBytes = reinterpret_cast<const char*>(&header);
+    output.insert(output.end(), headerBytes, headerBytes + sizeof(Header));
+    output.insert(output.end(), serializer.strings.begin(), serializer.strings.end());
+    output.insert(output.end(), serializer.buffers.begin(), serializer.buffers.end());
+    output.insert(output.end(), serializer.tree.begin(), serializer.tree.end());
+    return true;
+}
+
+uint64_t SyntaxSerializer::getKey(const SourceBuffer& buffer, const Bag& options) {
+    // Hash everything other than included files that parsing depends on;
+    // included files get checked separately when loading.
+    std::string key;
+    auto add = [&](auto value) {
+        key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    auto addString = [&](string_view value) {
+        add(value.size());
+        key.append(value);
+    };
+
+    add(FormatVersion);
+    add(SyntaxDeserializer::SchemaHash);
+    add(SyntaxKind::CompilationUnit);
+    add(TokenKind::LineContinuation);
+    add(DiagCode::MaxValue);
+
+    auto ppOptions = options.getOrDefault<PreprocessorOptions>();
+    add(ppOptions.maxIncludeDepth);
+    addString(ppOptions.predefineSource);
+    add(ppOptions.predefines.size());
+    for (auto& define : ppOptions.predefines)
+        addString(define);
+    add(ppOptions.undefines.size());
+    for (auto& undef : ppOptions.undefines)
+        addString(undef);
+    add(ppOptions.skipGuardedIncludes);
+
+    auto lexerOptions = options.getOrDefault<LexerOptions>();
+    add(lexerOptions.maxErrors);
+    add(lexerOptions.discardTrivia);
+
+    auto parserOptions = options.getOrDefault<ParserOptions>();
+    add(parserOptions.maxRecursionDepth);
+    add(parserOptions.lazyIntegerLiterals);
+
+    uint64_t seed = xxhash64(key.data(), key.size(), 0);
+    return xxhash64(buffer.data.data(), buffer.data.size(), seed);
+}
+
+uint32_t SyntaxSerializer::buffer(BufferID id) {
+    if (!id)
+        return 0;
+
+    if (auto it = bufferIndices.find(id.getId()); it != bufferIndices.end())
+        return it->second;
+
+    bool isMacro = sourceManager.isMacroLoc(SourceLocation(id, 0));
+    if (isMacro)
+        expansion(id);
+    else
+        file(id, bufferIndices.empty());
+
+    uint32_t index = (uint32_t)bufferIndices.size() + 1;
+    bufferIndices.emplace(id.getId(), index);
+
+    if (!isMacro) {
+        string_view text = sourceManager.getSourceText(id);
+        bufferTexts.emplace(text.data(), std::make_pair(text.data() + text.size(), index));
+    }
+    return index;
+}
+
+void SyntaxSerializer::file(BufferID id, bool isMain) {
+    if (isMain) {
+        buffers.push_back((char)BufferKind::Main);
+        return;
+    }
+
+    SourceLocation includedFrom = sourceManager.getIncludedFrom(id);
+    buffer(includedFrom.buffer());
+
+    // Files read from disk get read again when loading, and checked against a hash of
+    // what they held before. Anything else, like the text of predefined macros, gets
+    // stored as is.
+    string_view name = sourceManager.getRawFileName(id);
+    string_view text = sourceManager.getSourceText(id);
+
+    std::error_code ec;
+    fs::path path = getAbsolutePath(sourceManager, id);
+    bool onDisk = !path.empty() && fs::is_regular_file(path, ec);
+    if (onDisk)
+        onDisk = fs::file_size(path, ec) + 1 == text.size() && !ec;
+
+    auto saved = std::exchange(out, &buffers);
+    if (onDisk) {
+        varint((uint64_t)BufferKind::File);
+        string(ownedStrings.emplace_back(path.string()));
+        varint(xxhash64(text.data(), text.size(), 0));
+    }
+    else {
+        varint((uint64_t)BufferKind::Text);
+        string(name);
+        string(text);
+    }
+    location(includedFrom);
+
+    auto it = includes.find(id.getId());
+    if (it != includes.end()) {
+        string(it->second->name);
+        varint(it->second->isSystem);
+    }
+    else {
+        string("");
+        varint(0);
+    }
+    out = saved;
+}
+
+void SyntaxSerializer::expansion(BufferID id) {
+    SourceLocation loc(id, 0);
+    SourceLocation original = sourceManager.getOriginalLoc(loc);
+    SourceRange range = sourceManager.getExpansionRange(loc);
+    bool isMacroArg = sourceManager.isMacroArgLoc(loc);
+
+    buffer(original.buffer());
+    buffer(range.start().buffer());
+    buffer(range.end().buffer());
+
+    auto saved = std::exchange(out, &buffers);
+    varint((uint64_t)(isMacroArg ? BufferKind::MacroArg : BufferKind::Macro));
+    location(original);
+    location(range.start());
+    location(range.end());
+    if (!isMacroArg)
+        string(sourceManager.getMacroName(loc));
+    out = saved;
+}
+
+void SyntaxSerializer::node(const SyntaxNode* node) {
+    if (!node) {
+        varint(0);
+        return;
+    }
+
+    if (SyntaxListBase::isKind(node->kind) || ++depth > MaxDepth) {
+        ok = false;
+        return;
+    }
+
+    varint((uint64_t)node->kind + 1);
+    children(*node);
+    depth--;
+}
+
+void SyntaxSerializer::children(const SyntaxNode& node) {
+    // A null child node comes back as an invalid token, which gets
+    // written the same way, so the reader can tell what it was.
+    for (uint32_t i = 0; i < node.getChildCount() && ok; i++) {
+        auto child = node.childNode(i);
+        if (!child)
+            token(node.childToken(i));
+        else if (SyntaxListBase::isKind(child->kind)) {
+            varint(child->getChildCount());
+            children(*child);
+        }
+        else {
+            this->node(child);
+        }
+    }
+}
+
+void SyntaxSerializer::token(Token token) {
+    if (!token) {
+        varint(0);
+        return;
+    }
+
+    const Token::Info* info = token.getInfo();
+    varint((uint64_t)token.kind + 1);
+    varint(token.isMissing());
+
+    varint(info->trivia().size());
+    for (auto& t : info->trivia())
+        trivia(t);
+
+    // Most tokens are located right where their text is.
+    string_view rawText = info->rawText();
+    string(rawText);
+    if (!rawText.empty() && lastSource && buffer(info->location.buffer()) == lastSource &&
+        info->location.offset() == uint64_t(rawText.data() - lastSourceText)) {
+        varint(0);
+    }
+    else {
+        varint(1);
+        location(info->location);
+    }
+
+    switch (token.kind) {
+        case TokenKind::Identifier:
+            varint((uint64_t)info->idType());
+            break;
+        case TokenKind::StringLiteral:
+        case TokenKind::IncludeFileName:
+            string(info->stringText());
+            break;
+        case TokenKind::Directive:
+        case TokenKind::MacroUsage:
+            varint((uint64_t)info->directiveKind());
+            break;
+        case TokenKind::IntegerLiteral:
+        case TokenKind::IntegerBase:
+        case TokenKind::UnbasedUnsizedLiteral:
+        case TokenKind::RealLiteral:
+        case TokenKind::TimeLiteral: {
+            auto& numInfo = info->numInfo();
+            varint(numInfo.numericFlags.raw);
+            varint(numInfo.value.index());
+            if (auto bit = std::get_if<logic_t>(&numInfo.value))
+                varint(bit->value);
+            else if (auto real = std::get_if<double>(&numInfo.value)) {
+                uint64_t bits;
+                memcpy(&bits, real, sizeof(bits));
+                varint(bits);
+            }
+            else if (auto storage = std::get_if<SVIntStorage>(&numInfo.value)) {
+                const SVInt value = *storage;
+                varint(value.getBitWidth());
+                varint(value.isSigned());
+                varint(value.hasUnknown());
+                for (uint32_t i = 0; i < value.getNumWords(); i++)
+                    varint(value.getRawData()[i]);
+            }
+            else {
+                auto& undecoded = std::get<Token::Info::UndecodedInt>(numInfo.value);
+                varint(undecoded.size);
+                varint(undecoded.storage.bitWidth);
+                varint(undecoded.storage.unknownFlag);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void SyntaxSerializer::trivia(const Trivia& trivia) {
+    varint((uint64_t)trivia.kind);
+    switch (trivia.kind) {
+        case TriviaKind::Directive:
+        case TriviaKind::SkippedSyntax:
+            // Line directives change what the source manager reports for
+            // locations, and there's no way to get that back out of it.
+            if (trivia.syntax()->kind == SyntaxKind::LineDirective)
+                ok = false;
+            node(trivia.syntax());
+            break;
+        case TriviaKind::SkippedTokens:
+            varint(trivia.getSkippedTokens().size());
+            for (Token t : trivia.getSkippedTokens())
+                token(t);
+            break;
+        default:
+            string(trivia.getRawText());
+            if (auto location = trivia.getExplicitLocation()) {
+                varint(1);
+                this->location(*location);
+            }
+            else {
+                varint(0);
+            }
+            break;
+    }
+}
+
+void SyntaxSerializer::diagnostic(const Diagnostic& diag) {
+    if (diag.symbol)
+        ok = false;
+
+    varint((uint64_t)diag.code);
+    location(diag.location);
+
+    varint(diag.args.size());
+    for (auto& arg : diag.args) {
+        if (auto str = std::get_if<std::string>(&arg)) {
+            varint((uint64_t)ArgKind::String);
+            string(*str);
+        }
+        else if (auto signedValue = std::get_if<int64_t>(&arg)) {
+            varint((uint64_t)ArgKind::SignedInt);
+            varint(((uint64_t)*signedValue << 1) ^ (uint64_t)(*signedValue >> 63));
+        }
+        else if (auto unsignedValue = std::get_if<uint64_t>(&arg)) {
+            varint((uint64_t)ArgKind::UnsignedInt);
+            varint(*unsignedValue);
+        }
+        else {
+            // Types and constant values only come up after parsing.
+            ok = false;
+        }
+    }
+
+    varint(diag.ranges.size());
+    for (auto& range : diag.ranges) {
+        location(range.start());
+        location(range.end());
+    }
+
+    varint(diag.notes.size());
+    for (auto& note : diag.notes)
+        diagnostic(note);
+}
+
+void SyntaxSerializer::location(SourceLocation location) {
+    uint32_t index = buffer(location.buffer());
+    varint(index);
+    if (index)
+        varint(location.offset());
+}
+
+void SyntaxSerializer::string(string_view text) {
+    varint(text.size());
+    if (text.empty())
+        return;
+
+    // Text in the tree often picks up right where the previous text left off,
+    // like the trivia of a token and then its raw text.
+    bool inTree = out == &tree;
+    if (inTree && lastSource && text.data() == lastEnd &&
+        text.data() + text.size() <= lastSourceEnd) {
+        varint(1);
+        lastEnd += text.size();
+        return;
+    }
+
+    auto it = bufferTexts.upper_bound(text.data());
+    if (it != bufferTexts.begin()) {
+        --it;
+        if (text.data() + text.size() <= it->second.first) {
+            varint(it->second.second + 1);
+            varint(uint64_t(text.data() - it->first));
+            if (inTree) {
+                lastSource = it->second.second;
+                lastSourceText = it->first;
+                lastSourceEnd = it->second.first;
+                lastEnd = text.data() + text.size();
+            }
+            return;
+        }
+    }
+
+    auto [entry, inserted] = stringOffsets.emplace(text, (uint32_t)strings.size());
+    if (inserted)
+        strings.insert(strings.end(), text.begin(), text.end());
+
+    varint(0);
+    varint(entry->second);
+    if (inTree)
+        lastSource = 0;
+}
+
+void SyntaxSerializer::varint(uint64_t value) {
+    while (value >= 0x80) {
+        out->push_back(char(value | 0x80));
+        value >>= 7;
+    }
+    out->push_back(char(value));
+}
+
+std::shared_ptr<SyntaxTree> SyntaxDeserializer::deserialize(std::shared_ptr<const char> owner,
+                                                            string_view data,
+                                                            const SourceBuffer& buffer,
+                                                            SourceManager& sourceManager,
+                                                            const Bag& options) {
+    Header header;
+    if (data.size() < sizeof(Header))
+        throw CorruptDataException("Missing header");
+
+    memcpy(&header, data.data(), sizeof(Header));
+    if (memcmp(header.magic, Magic, sizeof(Magic)) != 0)
+        throw CorruptDataException("Not a serialized syntax tree");
+
+    if (header.key != SyntaxSerializer::getKey(buffer, options))
+        return nullptr;
+
+    data.remove_prefix(sizeof(Header));
+    if (header.stringsSize > data.size() || header.buffersSize > data.size() ||
+        header.treeSize != data.size() - header.stringsSize - header.buffersSize) {
+        throw CorruptDataException("Wrong section sizes");
+    }
+
+    string_view strings = data.substr(0, header.stringsSize);
+    string_view buffers = data.substr(header.stringsSize, header.buffersSize);
+    string_view tree = data.substr(header.stringsSize + header.buffersSize);
+
+    BumpAllocator alloc;
+    SyntaxDeserializer reader(strings, alloc);
+    reader.ptr = buffers.data();
+    reader.end = buffers.data() + buffers.size();
+    if (!reader.readBuffers(sourceManager, buffer))
+        return nullptr;
+
+    reader.ptr = tree.data();
+    reader.end = tree.data() + tree.size();
+    SyntaxNode* root = reader.readAnyNode();
+    if (!root)
+        throw CorruptDataException("Missing root node");
+
+    Token eof = reader.readToken();
+
+    Diagnostics diagnostics;
+    uint32_t diagCount = reader.readCount();
+    for (uint32_t i = 0; i < diagCount; i++)
+        diagnostics.append(reader.readDiagnostic());
+
+    if (reader.ptr != reader.end)
+        throw CorruptDataException("Unexpected data after the tree");
+
+    auto result = std::shared_ptr<SyntaxTree>(
+        new SyntaxTree(root, sourceManager, std::move(alloc), std::move(diagnostics), options, eof,
+                       nullptr, buffer));
+    result->includedFiles = std::move(reader.includedFiles);
+    result->cacheData = std::move(owner);
+    return result;
+}
+
+bool SyntaxDeserializer::readBuffers(SourceManager& sourceManager, const SourceBuffer& mainBuffer) {
+    while (ptr != end) {
+        auto kind = BufferKind(readVarint());
+        switch (kind) {
+            case BufferKind::Main:
+                buffers.push_back(mainBuffer);
+                break;
+            case BufferKind::File: {
+                string_view path = readString();
+                uint64_t hash = readVarint();
+                SourceLocation includedFrom = readLocation();
+                string_view includeName = readString();
+                bool isSystem = readVarint() != 0;
+
+                // Look the file up again the way the include did, since different
+                // include directories can lead to a different file.
+                SourceBuffer buffer = sourceManager.readHeader(
+                    includeName.empty() ? path : includeName, includedFrom, isSystem);
+                if (!buffer || getAbsolutePath(sourceManager, buffer.id) != fs::path(path) ||
+                    xxhash64(buffer.data.data(), buffer.data.size(), 0) != hash) {
+                    return false;
+                }
+
+                buffers.push_back(buffer);
+                includedFiles.push_back({ buffer, includeName, isSystem });
+                break;
+            }
+            case BufferKind::Text: {
+                string_view name = readString();
+                string_view text = readString();
+                SourceLocation includedFrom = readLocation();
+                string_view includeName = readString();
+                bool isSystem = readVarint() != 0;
+                buffers.push_back(sourceManager.assignText(name, text, includedFrom));
+                if (includedFrom)
+                    includedFiles.push_back({ buffers.back(), includeName, isSystem });
+                break;
+            }
+            case BufferKind::Macro:
+            case BufferKind::MacroArg: {
+                SourceLocation original = readLocation();
+                SourceLocation start = readLocation();
+                SourceLocation end = readLocation();
+
+                // Expansions that aren't of any particular macro have an empty name.
+                string_view name = kind == BufferKind::Macro ? readString() : "";
+                SourceLocation loc;
+                if (name.empty())
+                    loc = sourceManager.createExpansionLoc(original, start, end,
+                                                           kind == BufferKind::MacroArg);
+                else
+                    loc = sourceManager.createExpansionLoc(original, start, end, name);
+                buffers.push_back(SourceBuffer{ "", loc.buffer() });
+                break;
+            }
+            default:
+                throw CorruptDataException("Invalid buffer kind");
+        }
+    }
+
+    if (buffers.empty() || buffers[0].id != mainBuffer.id)
+        throw CorruptDataException("Missing main buffer");
+    return true;
+}
+
+SyntaxNode* SyntaxDeserializer::readAnyNode() {
+    uint64_t kind = readVarint();
+    if (!kind)
+        return nullptr;
+
+    if (kind - 1 > (uint64_t)SyntaxKind::CompilationUnit || ++depth > MaxDepth)
+        throw CorruptDataException("Invalid syntax node");
+
+    SyntaxNode* node = createNode(SyntaxKind(kind - 1));
+    depth--;
+    return node;
+}
+
+TokenList SyntaxDeserializer::readTokenList() {
+    uint32_t count = readCount();
+    auto tokens = (Token*)alloc.allocate(sizeof(Token) * count, alignof(Token));
+    for (uint32_t i = 0; i < count; i++)
+        new (&tokens[i]) Token(readToken());
+    return span<Token>(tokens, count);
+}
+
+Token SyntaxDeserializer::readToken() {
+    uint64_t kindValue = readVarint();
+    if (!kindValue)
+        return Token();
+
+    if (kindValue - 1 > (uint64_t)TokenKind::LineContinuation)
+        throw CorruptDataException("Invalid token kind");
+
+    auto kind = TokenKind(kindValue - 1);
+    auto info = alloc.emplace<Token::Info>();
+    if (readVarint())
+        info->flags = TokenFlags::Missing;
+
+    uint32_t triviaCount = readCount();
+    if (triviaCount) {
+        auto trivia = (Trivia*)alloc.allocate(sizeof(Trivia) * triviaCount, alignof(Trivia));
+        for (uint32_t i = 0; i < triviaCount; i++)
+            new (&trivia[i]) Trivia(readTrivia());
+        info->setTrivia({ trivia, triviaCount });
+    }
+
+    string_view rawText = readString();
+    info->setRawText(rawText);
+    if (readVarint())
+        info->location = readLocation();
+    else if (lastSource && !rawText.empty())
+        info->location = SourceLocation(buffers[lastSource - 1].id, lastOffset);
+    else
+        throw CorruptDataException("Invalid token location");
+
+    switch (kind) {
+        case TokenKind::Identifier: {
+            uint64_t type = readVarint();
+            if (type > (uint64_t)IdentifierType::System)
+                throw CorruptDataException("Invalid identifier type");
+
+            info->setIdType(IdentifierType(type));
+            break;
+        }
+        case TokenKind::StringLiteral:
+        case TokenKind::IncludeFileName:
+            info->setStringText(readString());
+            break;
+        case TokenKind::Directive:
+        case TokenKind::MacroUsage: {
+            uint64_t directive = readVarint();
+            if (directive > (uint64_t)SyntaxKind::CompilationUnit)
+                throw CorruptDataException("Invalid directive kind");
+            info->setDirectiveKind(SyntaxKind(directive));
+            break;
+        }
+        case TokenKind::IntegerLiteral:
+        case TokenKind::IntegerBase:
+        case TokenKind::UnbasedUnsizedLiteral:
+        case TokenKind::RealLiteral:
+        case TokenKind::TimeLiteral: {
+            NumericTokenFlags flags;
+            flags.raw = (uint8_t)readVarint();
+
+            switch (readVarint()) {
+                case 0:
+                    info->setBit(alloc, logic_t((uint8_t)readVarint()));
+                    break;
+                case 1: {
+                    uint64_t bits = readVarint();
+                    double real;
+                    memcpy(&real, &bits, sizeof(real));
+                    info->setReal(alloc, real);
+                    break;
+                }
+                case 2: {
+                    uint64_t bitWidth = readVarint();
+                    bool isSigned = readVarint() != 0;
+                    bool hasUnknown = readVarint() != 0;
+                    if (!bitWidth || bitWidth > SVInt::MAX_BITS)
+                        throw CorruptDataException("Invalid integer width");
+
+                    uint32_t words = uint32_t((bitWidth + 63) / 64) * (hasUnknown ? 2 : 1);
+                    SmallVectorSized<uint64_t, 2> data;
+                    for (uint32_t i = 0; i < words; i++)
+                        data.append(readVarint());
+
+                    SVIntStorage storage(data.data(), (bitwidth_t)bitWidth, isSigned, hasUnknown);
+                    if (bitWidth <= 64 && !hasUnknown)
+                        storage.val = data[0];
+                    info->setInt(alloc, SVInt(storage));
+                    break;
+                }
+                case 3: {
+                    uint64_t size = readVarint();
+                    uint64_t width = readVarint();
+                    bool hasUnknown = readVarint() != 0;
+                    if (!width || width > SVInt::MAX_BITS || size > SVInt::MAX_BITS)
+                        throw CorruptDataException("Invalid integer width");
+
+                    info->setUndecodedInt(alloc, flags.base(), flags.isSigned(), (bitwidth_t)size,
+                                          (bitwidth_t)width, hasUnknown);
+                    break;
+                }
+                default:
+                    throw CorruptDataException("Invalid numeric value");
+            }
+
+            info->setNumFlags(alloc, flags.base(), flags.isSigned());
+            info->setTimeUnit(alloc, flags.unit());
+            break;
+        }
+        default:
+            break;
+    }
+
+    return Token(kind, info);
+}
+
+Trivia SyntaxDeserializer::readTrivia() {
+    uint64_t kindValue = readVarint();
+    if (kindValue > (uint64_t)TriviaKind::Directive)
+        throw CorruptDataException("Invalid trivia kind");
+
+    auto kind = TriviaKind(kindValue);
+    switch (kind) {
+        case TriviaKind::Directive:
+        case TriviaKind::SkippedSyntax:
+            return Trivia(kind, &readNode<SyntaxNode>());
+        case TriviaKind::SkippedTokens: {
+            uint32_t count = readCount();
+            auto tokens = (Token*)alloc.allocate(sizeof(Token) * count, alignof(Token));
+            for (uint32_t i = 0; i < count; i++)
+                new (&tokens[i]) Token(readToken());
+            return Trivia(kind, span<Token const>(tokens, count));
+        }
+        default: {
+            Trivia trivia(kind, readString());
+            if (readVarint())
+                trivia = trivia.withLocation(alloc, readLocation());
+            return trivia;
+        }
+    }
+}
+
+Diagnostic SyntaxDeserializer::readDiagnostic() {
+    uint64_t code = readVarint();
+    if (code >= (uint64_t)DiagCode::MaxValue)
+        throw CorruptDataException("Invalid diagnostic code");
+
+    Diagnostic diag(DiagCode(code), readLocation());
+
+    uint32_t argCount = readCount();
+    for (uint32_t i = 0; i < argCount; i++) {
+        switch (ArgKind(readVarint())) {
+            case ArgKind::String:
+                diag.args.emplace_back(std::string(readString()));
+                break;
+            case ArgKind::SignedInt: {
+                uint64_t value = readVarint();
+                diag.args.emplace_back(int64_t(value >> 1) ^ -int64_t(value & 1));
+                break;
+            }
+            case ArgKind::UnsignedInt:
+                diag.args.emplace_back(readVarint());
+                break;
+            default:
+                throw CorruptDataException("Invalid diagnostic argument");
+        }
+    }
+
+    uint32_t rangeCount = readCount();
+    for (uint32_t i = 0; i < rangeCount; i++) {
+        SourceLocation start = readLocation();
+        diag.ranges.emplace_back(start, readLocation());
+    }
+
+    uint32_t noteCount = readCount();
+    for (uint32_t i = 0; i < noteCount; i++)
+        diag.notes.push_back(readDiagnostic());
+
+    return diag;
+}
+
+SourceLocation SyntaxDeserializer::readLocation() {
+    uint64_t index = readVarint();
+    if (!index)
+        return SourceLocation();
+
+    if (index > buffers.size())
+        throw CorruptDataException("Invalid buffer index");
+
+    const SourceBuffer& buffer = buffers[index - 1];
+    uint64_t offset = readVarint();
+    if (offset > UINT32_MAX || (!buffer.data.empty() && offset > buffer.data.size()))
+        throw CorruptDataException("Invalid location");
+
+    return SourceLocation(buffer.id, (uint32_t)offset);
+}
+
+string_view SyntaxDeserializer::readString() {
+    uint64_t length = readVarint();
+    if (!length)
+        return "";
+
+    // See SyntaxSerializer::string for what the index means.
+    uint64_t index = readVarint();
+    uint64_t offset;
+    if (index == 1) {
+        if (!lastSource)
+            throw CorruptDataException("Invalid text");
+        offset = lastOffset + lastLength;
+    }
+    else {
+        lastSource = index ? index - 1 : 0;
+        offset = readVarint();
+    }
+
+    if (lastSource > buffers.size())
+        throw CorruptDataException("Invalid buffer index");
+
+    string_view source = lastSource ? buffers[lastSource - 1].data : strings;
+    if (offset > source.size() || length > source.size() - offset)
+        throw CorruptDataException("Invalid text");
+
+    lastOffset = (uint32_t)offset;
+    lastLength = (uint32_t)length;
+    return source.substr(offset, length);
+}
+
+uint64_t SyntaxDeserializer::readVarintSlow() {
+    uint64_t result = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7) {
+        if (ptr == end)
+            throw CorruptDataException("Unexpected end of data");
+
+        auto byte = (uint8_t)*ptr++;
+        result |= uint64_t(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return result;
+    }
+    throw CorruptDataException("Invalid integer");
+}
+
+uint32_t SyntaxDeserializer::readCount() {
+    // Everything that gets counted takes at least a byte, which keeps
+    // bad counts from turning into huge allocations.
+    uint64_t count = readVarint();
+    if (count > uint64_t(end - ptr))
+        throw CorruptDataException("Invalid count");
+    return (uint32_t)count;
+}
+
+} // namespace slang
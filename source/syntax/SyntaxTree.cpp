@@ -0,0 +1,594 @@
+//------------------------------------------------------------------------------
+// SyntaxTree.cpp
+// Top-level parser interface.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#include "slang/syntax/SyntaxTree.h"
+
+#include <algorithm>
+#include <flat_hash_map.hpp>
+#include <fmt/format.h>
+#include <fstream>
+#include <random>
+
+#include "slang/parsing/Lexer.h"
+#include "slang/syntax/AllSyntax.h"
+#include "slang/syntax/SyntaxSerializer.h"
+#include "slang/util/MappedFile.h"
+
+#include "../text/CharInfo.h"
+
+namespace slang {
+
+SyntaxKind getDirectiveKind(string_view directive);
+
+} // namespace slang
+
+namespace {
+
+using namespace slang;
+
+// Checks whether the text has any directives other than the few that don't change
+// how the text after them gets preprocessed or register anything with the source
+// manager. Anything else (macros, includes, conditionals, `line, `begin_keywords)
+// could change the meaning of text that gets reparsed on its own. This also finds
+// directives inside of comments and strings, but that just means reparsing more.
+bool hasStatefulDirectives(string_view text) {
+    size_t pos = 0;
+    while ((pos = text.find('`', pos)) != string_view::npos) {
+        size_t end = ++pos;
+        while (end < text.size() && isIdentifierChar(text[end]))
+            end++;
+
+        switch (getDirectiveKind(text.substr(pos, end - pos))) {
+            case SyntaxKind::TimescaleDirective:
+            case SyntaxKind::DefaultNetTypeDirective:
+            case SyntaxKind::ResetAllDirective:
+            case SyntaxKind::CellDefineDirective:
+            case SyntaxKind::EndCellDefineDirective:
+            case SyntaxKind::UnconnectedDriveDirective:
+            case SyntaxKind::NoUnconnectedDriveDirective:
+            case SyntaxKind::PragmaDirective:
+                break;
+            default:
+                return true;
+        }
+        pos = end;
+    }
+    return false;
+}
+
+// Copying a member to move its locations costs nearly as much as parsing it again,
+// so an edited tree is only worth building from the old one if more of the old text
+// can be shared as is than has to be copied. Below this size, parsing is quick
+// enough either way that the old tree always gets reused.
+constexpr size_t MinReparseAllSize = 64 * 1024;
+
+uint32_t tokenEnd(Token token) {
+    return token.location().offset() + (uint32_t)token.rawText().length();
+}
+
+// Copies syntax with every location in the old buffers moved to the new one,
+// offset by the given amount.
+struct RelocateVisitor {
+    BumpAllocator& alloc;
+    const flat_hash_set<BufferID>& oldBuffers;
+    BufferID newBuffer;
+    int64_t shift = 0;
+
+    RelocateVisitor(BumpAllocator& alloc, const flat_hash_set<BufferID>& oldBuffers,
+                    BufferID newBuffer) :
+        alloc(alloc), oldBuffers(oldBuffers), newBuffer(newBuffer) {}
+
+    SourceLocation relocate(SourceLocation location) const {
+        if (!oldBuffers.count(location.buffer()))
+            return location;
+        return SourceLocation(newBuffer, uint32_t(location.offset() + shift));
+    }
+
+    Token relocate(Token token) {
+        if (!token)
+            return token;
+
+        // Most trivia is located relative to its token and can be shared as is.
+        auto trivia = token.trivia();
+        auto hasLocation = [](const Trivia& t) { return t.getExplicitLocation().has_value(); };
+        if (std::any_of(trivia.begin(), trivia.end(), hasLocation)) {
+            SmallVectorSized<Trivia, 8> newTrivia((uint32_t)trivia.size());
+            for (auto& t : trivia) {
+                switch (t.kind) {
+                    case TriviaKind::Directive:
+                    case TriviaKind::SkippedSyntax:
+                        newTrivia.append(Trivia(t.kind, t.syntax()->visit(*this)));
+                        break;
+                    case TriviaKind::SkippedTokens: {
+                        SmallVectorSized<Token, 8> tokens;
+                        for (auto skipped : t.getSkippedTokens())
+                            tokens.append(relocate(skipped));
+                        newTrivia.append(Trivia(t.kind, tokens.copy(alloc)));
+                        break;
+                    }
+                    default:
+                        if (auto location = t.getExplicitLocation())
+                            newTrivia.append(t.withLocation(alloc, relocate(*location)));
+                        else
+                            newTrivia.append(t);
+                        break;
+                }
+            }
+            token = token.withTrivia(alloc, newTrivia.copy(alloc));
+        }
+
+        return token.withLocation(alloc, relocate(token.location()));
+    }
+
+    template<typename T>
+    SyntaxNode* visit(const T& node) {
+        constexpr bool IsList = std::is_base_of_v<SyntaxListBase, T>;
+        T* cloned = node.clone(alloc);
+
+        uint32_t childCount = node.getChildCount();
+        SmallVectorSized<TokenOrSyntax, 8> children(childCount);
+        for (uint32_t i = 0; i < childCount; i++) {
+            auto child = node.getChild(i);
+            if (child.isToken())
+                children.append(relocate(child.token()));
+            else if (child.node())
+                children.append(child.node()->visit(*this));
+            else
+                children.append(static_cast<SyntaxNode*>(nullptr));
+        }
+
+        // Lists share their element arrays when cloned, so give them new ones. The
+        // parents of the elements get set by the node that owns the list.
+        if constexpr (IsList) {
+            cloned->resetAll(alloc, children);
+        }
+        else {
+            for (uint32_t i = 0; i < childCount; i++) {
+                if (children[i].isNode() && !children[i].node())
+                    continue;
+
+                cloned->setChild(i, children[i]);
+                if (children[i].isToken())
+                    continue;
+
+                // Lists are stored by value, so look up the copy the node ended up with.
+                SyntaxNode* childNode = cloned->getChild(i).node();
+                childNode->parent = cloned;
+                if (SyntaxListBase::isKind(childNode->kind)) {
+                    auto& list = static_cast<SyntaxListBase&>(*childNode);
+                    for (uint32_t j = 0; j < list.getChildCount(); j++) {
+                        auto element = list.getChild(j);
+                        if (element.isNode())
+                            element.node()->parent = cloned;
+                    }
+                }
+            }
+        }
+
+        return cloned;
+    }
+
+    SyntaxNode* visitInvalid(const SyntaxNode&) { THROW_UNREACHABLE; }
+
+    Diagnostic relocate(const Diagnostic& diag) {
+        Diagnostic result = diag;
+        result.location = relocate(diag.location);
+        for (auto& range : result.ranges)
+            range = SourceRange(relocate(range.start()), relocate(range.end()));
+        for (auto& note : result.notes)
+            note = relocate(note);
+        return result;
+    }
+};
+
+// A group of adjacent top-level members that gets either reused or reparsed as a
+// whole. The last chunk holds the end of file token, and may have no members.
+struct Chunk {
+    // Indices of the members in the compilation unit's list.
+    uint32_t firstMember = 0;
+    uint32_t endMember = 0;
+
+    // The offset where the chunk's leading trivia starts, which is where the
+    // previous chunk's last token ends.
+    uint32_t start = 0;
+
+    // The offset just past the chunk's first token. Edits at or before here can
+    // change where the previous chunk ends, so they damage it as well.
+    uint32_t firstTokenEnd = 0;
+
+    // How far the edits before the chunk move it in the new text.
+    int64_t shift = 0;
+
+    bool damaged = false;
+};
+
+// Gets the contents of the file at @a path, mapped into memory if possible.
+// Returns nullptr if it can't be read.
+std::shared_ptr<const char> readCacheFile(const std::string& path, size_t& size) {
+    auto mapping = std::make_shared<MappedFile>(MappedFile::open(path, /* nullTerminated */ false));
+    if (*mapping) {
+        size = mapping->text().size();
+        return std::shared_ptr<const char>(mapping, mapping->text().data());
+    }
+
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    if (!stream)
+        return nullptr;
+
+    size = (size_t)stream.tellg();
+    std::shared_ptr<char> data(new char[size], std::default_delete<char[]>());
+    stream.seekg(0);
+    if (!stream.read(data.get(), (std::streamsize)size))
+        return nullptr;
+    return data;
+}
+
+} // namespace
+
+namespace slang {
+
+std::shared_ptr<SyntaxTree> SyntaxTree::fromEdits(const std::shared_ptr<SyntaxTree>& tree,
+                                                  span<const TextEdit> edits) {
+    if (!tree->source)
+        throw std::logic_error("Can't edit a syntax tree that wasn't parsed from a buffer");
+    if (edits.empty())
+        return tree;
+
+    SourceManager& sourceManager = tree->sourceMan;
+    SourceBuffer oldBuffer = tree->source;
+    string_view oldText = oldBuffer.data;
+    if (!oldText.empty() && oldText.back() == '\0')
+        oldText.remove_suffix(1);
+
+    std::vector<char> newText;
+    newText.reserve(oldText.size() + 1);
+    size_t copied = 0;
+    for (auto& edit : edits) {
+        ASSERT(edit.offset >= copied && edit.offset + edit.length <= oldText.size());
+        newText.insert(newText.end(), oldText.begin() + copied, oldText.begin() + edit.offset);
+        newText.insert(newText.end(), edit.newText.begin(), edit.newText.end());
+        copied = edit.offset + edit.length;
+    }
+    newText.insert(newText.end(), oldText.begin() + copied, oldText.end());
+    newText.push_back('\0');
+
+    SourceBuffer newBuffer = sourceManager.assignBuffer(sourceManager.getRawFileName(oldBuffer.id),
+                                                        std::move(newText));
+
+    bool isUnit = tree->root().kind == SyntaxKind::CompilationUnit;
+    auto reparseAll = [&] { return create(sourceManager, newBuffer, tree->options_, !isUnit); };
+
+    if (!isUnit || hasStatefulDirectives(oldText))
+        return reparseAll();
+
+    // Text before the first edit is roughly what can be shared, and text after the
+    // last one what has to be copied.
+    auto& lastEdit = edits[edits.size() - 1];
+    size_t copiedSize = oldText.size() - (lastEdit.offset + lastEdit.length);
+    if (oldText.size() >= MinReparseAllSize && copiedSize > edits[0].offset)
+        return reparseAll();
+
+    // Everything in the old tree has to be there to copy it.
+    tree->parseSkimmedBodies();
+    Diagnostics& oldDiagnostics = tree->diagnostics();
+
+    // Lexers give up after too many errors, which depends on everything before.
+    auto lexerOptions = tree->options_.getOrDefault<LexerOptions>();
+    if (oldDiagnostics.size() >= lexerOptions.maxErrors)
+        return reparseAll();
+
+    // Locations in the old tree can also be in the buffers of the versions before it,
+    // for members it shared with them.
+    flat_hash_set<BufferID> oldBuffers;
+    oldBuffers.insert(oldBuffer.id);
+    for (auto id : tree->previousSources)
+        oldBuffers.insert(id);
+
+    std::vector<uint32_t> diagOffsets;
+    for (auto& diag : oldDiagnostics) {
+        if (!oldBuffers.count(diag.location.buffer()))
+            return reparseAll();
+        diagOffsets.push_back(diag.location.offset());
+    }
+    std::sort(diagOffsets.begin(), diagOffsets.end());
+
+    // Split the members into chunks. Members can only be reparsed separately from the
+    // one before them if that one ended with a real token, so that we know exactly where
+    // its text ends, and no diagnostics are reported right at that point, since we
+    // couldn't tell which of the two they belong to.
+    auto& unit = tree->root().as<CompilationUnitSyntax>();
+    auto& members = unit.members;
+    uint32_t numMembers = (uint32_t)members.size();
+
+    std::vector<Chunk> chunks;
+    uint32_t lastEnd = 0;
+    bool startChunk = true;
+    for (uint32_t i = 0; i <= numMembers; i++) {
+        if (startChunk) {
+            Token first = i < numMembers ? members[i]->getFirstToken() : unit.endOfFile;
+            Chunk& chunk = chunks.emplace_back();
+            chunk.firstMember = chunk.endMember = i;
+            chunk.start = lastEnd;
+            chunk.firstTokenEnd = (!first || first.isMissing()) ? UINT32_MAX : tokenEnd(first);
+        }
+        if (i == numMembers)
+            break;
+
+        Token last = members[i]->getLastToken();
+        chunks.back().endMember = i + 1;
+        startChunk = last && !last.isMissing() &&
+                     oldBuffers.count(last.location().buffer());
+        if (startChunk) {
+            lastEnd = tokenEnd(last);
+            startChunk = !std::binary_search(diagOffsets.begin(), diagOffsets.end(), lastEnd);
+        }
+    }
+
+    auto chunkAt = [&](uint32_t offset) {
+        auto it = std::upper_bound(
+            chunks.begin(), chunks.end(), offset,
+            [](uint32_t value, const Chunk& chunk) { return value < chunk.start; });
+        return size_t(it - chunks.begin()) - 1;
+    };
+
+    // Mark every chunk that an edit touches, even if just at its edge.
+    for (auto& edit : edits) {
+        size_t index = chunkAt(edit.offset);
+        if (index > 0 && edit.offset <= chunks[index].firstTokenEnd)
+            index--;
+
+        for (; index < chunks.size() && chunks[index].start <= edit.offset + edit.length; index++)
+            chunks[index].damaged = true;
+    }
+
+    // Chunks that end before the line of the first edit are shared with the old tree
+    // as is. Their text, line numbers and columns are all the same, and since the old
+    // buffer comes before the new one their locations still sort before everything
+    // that comes after them.
+    size_t lineBreak = edits[0].offset ? oldText.find_last_of("\r\n", edits[0].offset - 1)
+                                       : string_view::npos;
+    uint32_t firstEditLine = lineBreak == string_view::npos ? 0 : uint32_t(lineBreak + 1);
+
+    size_t sharedChunks = 0;
+    while (sharedChunks + 1 < chunks.size() && !chunks[sharedChunks].damaged &&
+           chunks[sharedChunks + 1].start <= firstEditLine) {
+        sharedChunks++;
+    }
+
+    span<const TextEdit>::index_type editIndex = 0;
+    int64_t shift = 0;
+    for (auto& chunk : chunks) {
+        while (editIndex < edits.size() &&
+               edits[editIndex].offset + edits[editIndex].length < chunk.start) {
+            auto& edit = edits[editIndex++];
+            shift += int64_t(edit.newText.size()) - int64_t(edit.length);
+        }
+        chunk.shift = shift;
+    }
+
+    // Diagnostics in chunks that get reused are carried over; the rest get
+    // reported again when their chunks are reparsed.
+    std::vector<std::pair<size_t, const Diagnostic*>> oldDiags;
+    for (auto& diag : oldDiagnostics)
+        oldDiags.emplace_back(chunkAt(diag.location.offset()), &diag);
+    std::stable_sort(oldDiags.begin(), oldDiags.end(),
+                     [](auto& left, auto& right) { return left.first < right.first; });
+    auto nextDiag = oldDiags.begin();
+
+    // Bodies parsed later wouldn't belong to the new tree, so don't skim them.
+    Bag options = tree->options_;
+    auto parserOptions = options.getOrDefault<ParserOptions>();
+    parserOptions.skimBodies = false;
+    options.add(parserOptions);
+
+    BumpAllocator alloc;
+    Diagnostics diagnostics;
+    SmallVectorSized<MemberSyntax*, 16> newMembers;
+    Token eof;
+    RelocateVisitor visitor(alloc, oldBuffers, newBuffer.id);
+
+    auto firstToken = [&](const Chunk& chunk) {
+        visitor.shift = chunk.shift;
+        if (chunk.firstMember == numMembers)
+            return visitor.relocate(unit.endOfFile);
+        return visitor.relocate(members[chunk.firstMember]->getFirstToken());
+    };
+
+    for (size_t index = 0; index < chunks.size();) {
+        const Chunk& chunk = chunks[index];
+        if (index < sharedChunks) {
+            for (uint32_t i = chunk.firstMember; i < chunk.endMember; i++)
+                newMembers.append(members[i]);
+            for (; nextDiag != oldDiags.end() && nextDiag->first <= index; nextDiag++)
+                diagnostics.append(*nextDiag->second);
+
+            index++;
+            continue;
+        }
+
+        if (!chunk.damaged) {
+            visitor.shift = chunk.shift;
+            for (uint32_t i = chunk.firstMember; i < chunk.endMember; i++)
+                newMembers.append(&members[i]->visit(visitor)->as<MemberSyntax>());
+            if (index == chunks.size() - 1)
+                eof = visitor.relocate(unit.endOfFile);
+
+            for (; nextDiag != oldDiags.end() && nextDiag->first <= index; nextDiag++)
+                diagnostics.append(visitor.relocate(*nextDiag->second));
+
+            index++;
+            continue;
+        }
+
+        // Lex from the start of the damaged chunks until we end up exactly at the start
+        // of an undamaged one, which then has to survive parsing the tokens before it.
+        // If it doesn't, we take it in as well and try again.
+        size_t endIndex = index;
+        auto absorbNext = [&] {
+            endIndex++;
+            while (endIndex < chunks.size() && chunks[endIndex].damaged)
+                endIndex++;
+        };
+        auto endOffset = [&] {
+            if (endIndex == chunks.size())
+                return UINT64_MAX;
+            return uint64_t(chunks[endIndex].start + chunks[endIndex].shift);
+        };
+        absorbNext();
+
+        uint64_t startOffset = chunk.start + chunk.shift;
+        Lexer lexer(newBuffer.id, newBuffer.data, newBuffer.data.data() + startOffset, alloc,
+                    diagnostics, lexerOptions);
+
+        std::vector<Token> tokens;
+        while (true) {
+            while (true) {
+                if (!tokens.empty()) {
+                    Token last = tokens.back();
+                    if (last.kind == TokenKind::EndOfFile)
+                        break;
+
+                    while (tokenEnd(last) > endOffset())
+                        absorbNext();
+                    if (tokenEnd(last) == endOffset())
+                        break;
+                }
+
+                // Directives need a preprocessor to turn them into trivia, so any
+                // that show up here (even harmless ones) mean starting over.
+                Token token = lexer.lex(getDefaultKeywordVersion());
+                switch (token.kind) {
+                    case TokenKind::Directive:
+                    case TokenKind::MacroQuote:
+                    case TokenKind::MacroEscapedQuote:
+                    case TokenKind::MacroPaste:
+                    case TokenKind::LineContinuation:
+                        return reparseAll();
+                    default:
+                        break;
+                }
+                tokens.push_back(token);
+            }
+
+            Token next;
+            if (endIndex < chunks.size()) {
+                next = firstToken(chunks[endIndex]);
+                tokens.push_back(next);
+            }
+
+            Diagnostics parseDiagnostics;
+            Parser parser(tokens, alloc, parseDiagnostics, options);
+
+            Token endToken;
+            auto parsed = parser.parseMembersUntil(tokens.back().location(), endToken);
+            if (!endToken)
+                return reparseAll();
+
+            bool ok = true;
+            if (next) {
+                ok = endToken.getInfo() == next.getInfo() &&
+                     std::none_of(parseDiagnostics.begin(), parseDiagnostics.end(),
+                                  [&](auto& diag) { return !(diag.location < next.location()); });
+                tokens.pop_back();
+            }
+
+            if (ok) {
+                newMembers.appendRange(parsed);
+                diagnostics.appendRange(parseDiagnostics);
+                if (!next)
+                    eof = endToken;
+                break;
+            }
+
+            absorbNext();
+        }
+
+        while (nextDiag != oldDiags.end() && nextDiag->first < endIndex)
+            nextDiag++;
+        index = endIndex;
+    }
+
+    if (diagnostics.size() >= lexerOptions.maxErrors)
+        return reparseAll();
+
+    // The members go in after constructing the root, since the constructor would point
+    // the shared ones, which still belong to the old tree, at the new root.
+    auto root = alloc.emplace<CompilationUnitSyntax>(nullptr, eof);
+    root->members = newMembers.copy(alloc);
+    root->members.parent = root;
+
+    uint32_t sharedMembers = chunks[sharedChunks].firstMember;
+    for (uint32_t i = sharedMembers; i < newMembers.size(); i++)
+        newMembers[i]->parent = root;
+
+    auto result = std::shared_ptr<SyntaxTree>(
+        new SyntaxTree(root, sourceManager, std::move(alloc), std::move(diagnostics),
+                       tree->options_, eof, nullptr, newBuffer));
+    result->parentTree = tree;
+    if (sharedMembers) {
+        result->previousSources = tree->previousSources;
+        result->previousSources.push_back(oldBuffer.id);
+    }
+    return result;
+}
+
+uint64_t SyntaxTree::getCacheKey(const SourceBuffer& buffer, const Bag& options) {
+    return SyntaxSerializer::getKey(buffer, options);
+}
+
+std::shared_ptr<SyntaxTree> SyntaxTree::fromCache(string_view cachePath,
+                                                  const SourceBuffer& buffer,
+                                                  SourceManager& sourceManager,
+                                                  const Bag& options) {
+    size_t size = 0;
+    std::string path(cachePath);
+    if (auto data = readCacheFile(path, size)) {
+        try {
+            string_view contents(data.get(), size);
+            auto result = SyntaxDeserializer::deserialize(std::move(data), contents, buffer,
+                                                          sourceManager, options);
+            if (result)
+                return result;
+        }
+        catch (const SyntaxDeserializer::CorruptDataException&) {
+            // Just parse the text again and overwrite the file.
+        }
+    }
+
+    auto result = fromBuffer(buffer, sourceManager, options);
+    result->writeCache(cachePath);
+    return result;
+}
+
+bool SyntaxTree::writeCache(string_view path) {
+    std::vector<char> data;
+    if (!SyntaxSerializer::serialize(*this, data))
+        return false;
+
+    // Write to a temporary file first so that anyone loading the cache at the
+    // same time never sees a partially written one.
+    std::string tempPath = fmt::format("{}.{:x}.tmp", path, std::random_device()());
+    {
+        std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+        stream.write(data.data(), (std::streamsize)data.size());
+        stream.close();
+        if (!stream) {
+            std::error_code ec;
+            fs::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tempPath, std::string(path), ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace slang
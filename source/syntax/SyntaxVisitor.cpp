@@ -10,95 +10,184 @@ namespace {
 
 using namespace slang;
 
-struct CloneVisitor {
+// Makes a copy of a single node; its children are still the original ones.
+struct ShallowCloneVisitor {
     BumpAllocator& alloc;
-    const slang::detail::ChangeMap& changes;
 
-    CloneVisitor(BumpAllocator& alloc, const slang::detail::ChangeMap& changes) :
-        alloc(alloc), changes(changes) {}
+    explicit ShallowCloneVisitor(BumpAllocator& alloc) : alloc(alloc) {}
 
-#ifdef _MSC_VER
-#    pragma warning(push)
-#    pragma warning(disable : 4127) // conditional expression is constant
-#endif
     template<typename T>
     SyntaxNode* visit(const T& node) {
-        T* cloned = node.clone(alloc);
+        return node.clone(alloc);
+    }
 
-        constexpr bool IsList = std::is_same_v<T, SyntaxListBase>;
-        optional<SmallVectorSized<TokenOrSyntax, 8>> listBuffer;
+    SyntaxNode* visitInvalid(const SyntaxNode&) { THROW_UNREACHABLE; }
+};
 
-        auto backfillList = [&](uint32_t index) {
-            if (cloned->kind != SyntaxKind::SyntaxList && cloned->kind != SyntaxKind::SeparatedList)
-                throw std::logic_error("Can't use insertBefore or insertAfter on a non-list node");
+struct SetChildVisitor {
+    template<typename T>
+    void visit(T& node, uint32_t index, TokenOrSyntax child) {
+        node.setChild(index, child);
+    }
 
-            listBuffer.emplace();
-            for (uint32_t i = 0; i < index; i++)
-                listBuffer->append(cloned->getChild(i));
-        };
+    void visitInvalid(SyntaxNode&, uint32_t, TokenOrSyntax) { THROW_UNREACHABLE; }
+};
 
-        for (uint32_t i = 0; i < node.getChildCount(); i++) {
-            auto child = node.childNode(i);
-            if (!child) {
-                if (IsList && listBuffer)
-                    listBuffer->append(node.childToken(i));
+// Builds the transformed tree. Only nodes that have a change somewhere beneath them
+// get copied; every untouched subtree is shared with the original tree, which the new
+// tree keeps alive. The tree is walked in post order using an explicit stack rather
+// than by recursion, so that deep trees (like long chains of binary operators) can't
+// overflow the call stack, and each node is rebuilt after its children if any of
+// them ended up different.
+class CloneVisitor {
+public:
+    CloneVisitor(BumpAllocator& alloc, const slang::detail::ChangeMap& changes) :
+        alloc(alloc), changes(changes) {}
+
+    SyntaxNode* cloneTree(const SyntaxNode& root) {
+        walkAll = !findSpine(root);
+        stack.push_back({ &root, 0, 0 });
+        while (true) {
+            Frame& frame = stack.back();
+            if (frame.next < frame.node->getChildCount()) {
+                addChild(frame.next++);
                 continue;
             }
 
-            // We might not know until we're part way through a list that we
-            // want to insert or remove elements from it. Once we see the first
-            // modification we start building the buffer instead, and then replace
-            // the whole list in one go at the end.
-            auto it = changes.find(child);
-            if (it == changes.end()) {
-                if (IsList && listBuffer)
-                    listBuffer->append(child->visit(*this));
-                else
-                    cloned->setChild(i, child->visit(*this));
-            }
-            else {
-                switch (it->second.kind) {
-                    case slang::detail::SyntaxChange::Remove:
-                        THROW_UNREACHABLE; // TODO: implement this
-
-                    case slang::detail::SyntaxChange::Replace:
-                        if (IsList && listBuffer)
-                            listBuffer->append(it->second.second);
-                        else
-                            cloned->setChild(i, it->second.second);
-                        break;
-                    case slang::detail::SyntaxChange::InsertBefore:
-                        if (!listBuffer)
-                            backfillList(i);
-                        listBuffer->append(it->second.second);
-                        listBuffer->append(child->visit(*this));
-                        break;
-                    case slang::detail::SyntaxChange::InsertAfter:
-                        if (!listBuffer)
-                            backfillList(i);
-                        listBuffer->append(child->visit(*this));
-                        listBuffer->append(it->second.second);
-                        break;
-                    default:
-                        THROW_UNREACHABLE;
-                }
+            Frame finished = frame;
+            stack.pop_back();
+
+            SyntaxNode* result = rebuild(finished);
+            if (stack.empty())
+                return result;
+
+            children.push_back(result);
+            if (result != finished.node)
+                stack.back().changed = true;
+            if (finished.insertAfter)
+                children.push_back(finished.insertAfter);
+        }
+    }
+
+private:
+    // A node whose children are being visited. Their results, which are either the
+    // original children or their replacements, go on the children stack starting at
+    // the given base index.
+    struct Frame {
+        const SyntaxNode* node;
+        uint32_t next;
+        size_t base;
+        bool changed = false;
+        SyntaxNode* insertAfter = nullptr;
+    };
+
+    // Finds the nodes that have changes beneath them by following parent pointers up
+    // from each change, so that the walk only has to go down those paths. That doesn't
+    // work if any of them fail to lead back to the root, which is the case for trees
+    // that came out of an earlier rewrite: the nodes they share with the original
+    // still point at their parents in it. Those trees get walked in full.
+    bool findSpine(const SyntaxNode& root) {
+        for (auto& [node, change] : changes) {
+            auto current = node;
+            while (current != &root && current->parent) {
+                current = current->parent;
+                if (!spine.insert(current).second)
+                    break;
             }
+
+            if (!current->parent && current != &root)
+                return false;
         }
+        return true;
+    }
+
+    void addChild(uint32_t index) {
+        Frame& frame = stack.back();
+        auto child = frame.node->childNode(index);
+        if (!child) {
+            children.push_back(frame.node->childToken(index));
+            return;
+        }
+
+        auto it = changes.find(child);
+        if (it == changes.end()) {
+            // Parent pointers skip over lists, so they always get looked into.
+            if (walkAll || spine.count(child) || SyntaxListBase::isKind(child->kind))
+                stack.push_back({ child, 0, children.size() });
+            else
+                children.push_back(const_cast<SyntaxNode*>(child));
+            return;
+        }
+
+        auto& change = it->second;
+        switch (change.kind) {
+            case slang::detail::SyntaxChange::Remove:
+                THROW_UNREACHABLE; // TODO: implement this
+
+            case slang::detail::SyntaxChange::Replace:
+                frame.changed = true;
+                children.push_back(change.second);
+                break;
+            case slang::detail::SyntaxChange::InsertBefore:
+                checkList(frame);
+                frame.changed = true;
+                children.push_back(change.second);
+                stack.push_back({ child, 0, children.size() });
+                break;
+            case slang::detail::SyntaxChange::InsertAfter:
+                checkList(frame);
+                frame.changed = true;
+                stack.push_back({ child, 0, children.size(), false, change.second });
+                break;
+            default:
+                THROW_UNREACHABLE;
+        }
+    }
+
+    static void checkList(const Frame& frame) {
+        auto kind = frame.node->kind;
+        if (kind != SyntaxKind::SyntaxList && kind != SyntaxKind::SeparatedList)
+            throw std::logic_error("Can't use insertBefore or insertAfter on a non-list node");
+    }
+
+    SyntaxNode* rebuild(const Frame& frame) {
+        if (!frame.changed) {
+            children.resize(frame.base);
+
+            // Shared nodes still belong to the original tree, which the new tree keeps
+            // alive as its parent.
+            return const_cast<SyntaxNode*>(frame.node);
+        }
+
+        ShallowCloneVisitor cloneVisitor(alloc);
+        SyntaxNode* cloned = frame.node->visit(cloneVisitor);
 
-        if constexpr (IsList) {
-            if (listBuffer) {
-                cloned->resetAll(alloc, *listBuffer);
-                listBuffer.reset();
+        // A copy of a list shares its elements with the original, so it needs new
+        // storage. Other nodes only get the children that changed set on them.
+        span<const TokenOrSyntax> results(children.data() + frame.base,
+                                          children.size() - frame.base);
+        if (SyntaxListBase::isKind(cloned->kind)) {
+            static_cast<SyntaxListBase*>(cloned)->resetAll(alloc, results);
+        }
+        else {
+            SetChildVisitor setVisitor;
+            for (uint32_t i = 0; i < frame.node->getChildCount(); i++) {
+                auto& child = results[i];
+                if (child.isNode() && child.node() != frame.node->childNode(i))
+                    cloned->visit(setVisitor, i, child);
             }
         }
 
+        children.resize(frame.base);
         return cloned;
     }
-#ifdef _MSC_VER
-#    pragma warning(pop)
-#endif
 
-    SyntaxNode* visitInvalid(const SyntaxNode&) { THROW_UNREACHABLE; }
+    BumpAllocator& alloc;
+    const slang::detail::ChangeMap& changes;
+    flat_hash_set<const SyntaxNode*> spine;
+    bool walkAll = false;
+    std::vector<Frame> stack;
+    std::vector<TokenOrSyntax> children;
 };
 
 } // namespace
@@ -114,7 +203,7 @@ std::shared_ptr<SyntaxTree> transformTree(
     BumpAllocator alloc;
     CloneVisitor visitor(alloc, changes);
 
-    SyntaxNode* root = tree->root().visit(visitor);
+    SyntaxNode* root = visitor.cloneTree(tree->root());
 
     // Steal ownership of any temporary syntax trees that the user created; once we return the
     // user expects that the newly transformed tree fully owns all of its memory.
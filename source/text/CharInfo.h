@@ -6,8 +6,82 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <array>
+#include <cstdint>
+
 namespace slang {
 
+namespace charinfo {
+
+/// Bit flags for the classes a character can belong to.
+enum CharClass : uint16_t {
+    HorizontalSpace = 1 << 0,
+    Newline = 1 << 1,
+    DecimalDigit = 1 << 2,
+    OctalDigit = 1 << 3,
+    HexDigit = 1 << 4,
+    BinaryDigit = 1 << 5,
+    Letter = 1 << 6,
+    IdentifierSymbol = 1 << 7,
+    LogicDigit = 1 << 8,
+    Printable = 1 << 9,
+
+    Whitespace = HorizontalSpace | Newline,
+    AlphaNumeric = Letter | DecimalDigit,
+    IdentifierChar = AlphaNumeric | IdentifierSymbol
+};
+
+constexpr std::array<uint16_t, 256> buildTable() {
+    std::array<uint16_t, 256> table{};
+    auto add = [&table](char c, uint16_t classes) {
+        table[static_cast<unsigned char>(c)] |= classes;
+    };
+
+    for (char c = 33; c <= 126; c++)
+        add(c, Printable);
+
+    for (char c : { ' ', '\t', '\v', '\f' })
+        add(c, HorizontalSpace);
+    add('\r', Newline);
+    add('\n', Newline);
+
+    for (char c = '0'; c <= '9'; c++) {
+        add(c, DecimalDigit | HexDigit);
+        if (c <= '7')
+            add(c, OctalDigit);
+        if (c <= '1')
+            add(c, BinaryDigit);
+    }
+
+    for (char c = 'a'; c <= 'z'; c++) {
+        char upper = char(c - 'a' + 'A');
+        add(c, Letter);
+        add(upper, Letter);
+        if (c <= 'f') {
+            add(c, HexDigit);
+            add(upper, HexDigit);
+        }
+    }
+
+    add('_', IdentifierSymbol);
+    add('$', IdentifierSymbol);
+
+    for (char c : { 'z', 'Z', '?', 'x', 'X' })
+        add(c, LogicDigit);
+
+    return table;
+}
+
+/// Classification flags for every possible character value.
+inline constexpr std::array<uint16_t, 256> Table = buildTable();
+
+/// Returns whether the given character is in any of the given classes.
+inline bool is(char c, uint16_t classes) {
+    return (Table[static_cast<unsigned char>(c)] & classes) != 0;
+}
+
+} // namespace charinfo
+
 /// Returns whether the given character is a valid ASCII character.
 inline bool isASCII(char c) {
     return static_cast<unsigned char>(c) < 128;
@@ -15,79 +89,60 @@ inline bool isASCII(char c) {
 
 /// Returns whether the given character is considered "printable".
 inline bool isPrintable(char c) {
-    return c >= 33 && c <= 126;
+    return charinfo::is(c, charinfo::Printable);
 }
 
 /// Returns whether the given character is considered whitespace.
 inline bool isWhitespace(char c) {
-    switch (c) {
-        case ' ':
-        case '\t':
-        case '\v':
-        case '\f':
-        case '\r':
-        case '\n':
-            return true;
-    }
-    return false;
+    return charinfo::is(c, charinfo::Whitespace);
 }
 
 /// Returns whether the given character is considered horizontal whitespace
 /// (as opposed to vertical like line feeds or vertical tabs).
 inline bool isHorizontalWhitespace(char c) {
-    switch (c) {
-        case ' ':
-        case '\t':
-        case '\v':
-        case '\f':
-            return true;
-    }
-    return false;
+    return charinfo::is(c, charinfo::HorizontalSpace);
 }
 
 /// Returns whether the given character is considered a new line.
 inline bool isNewline(char c) {
-    return c == '\r' || c == '\n';
+    return charinfo::is(c, charinfo::Newline);
 }
 
 /// Returns whether the given character is considered a decimal digit.
 inline bool isDecimalDigit(char c) {
-    return c >= '0' && c <= '9';
+    return charinfo::is(c, charinfo::DecimalDigit);
 }
 
 /// Returns whether the given character is considered an octal digit.
 inline bool isOctalDigit(char c) {
-    return c >= '0' && c <= '7';
+    return charinfo::is(c, charinfo::OctalDigit);
 }
 
 /// Returns whether the given character is considered a hexadecimal digit.
 inline bool isHexDigit(char c) {
-    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+    return charinfo::is(c, charinfo::HexDigit);
 }
 
 /// Returns whether the given character is considered a binary digit.
 inline bool isBinaryDigit(char c) {
-    return c == '0' || c == '1';
+    return charinfo::is(c, charinfo::BinaryDigit);
 }
 
 /// Returns whether the given character is considered an alphanumeric character.
 inline bool isAlphaNumeric(char c) {
-    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    return charinfo::is(c, charinfo::AlphaNumeric);
+}
+
+/// Returns whether the given character can appear in a (non-escaped) identifier
+/// after the first character: letters, digits, underscores and dollar signs.
+inline bool isIdentifierChar(char c) {
+    return charinfo::is(c, charinfo::IdentifierChar);
 }
 
 /// Returns whether the given character is considered a special logic digit,
 /// which encompasses various ways to say Unknown (X) or High Impedance (Z).
 inline bool isLogicDigit(char c) {
-    switch (c) {
-        case 'z':
-        case 'Z':
-        case '?':
-        case 'x':
-        case 'X':
-            return true;
-        default:
-            return false;
-    }
+    return charinfo::is(c, charinfo::LogicDigit);
 }
 
 /// Gets the numeric value of the given decimal digit. If the given character
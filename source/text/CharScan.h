@@ -0,0 +1,190 @@
+//------------------------------------------------------------------------------
+// CharScan.h
+// Vectorized searches through source text.
+//
+// File is under the MIT license; see LICENSE for details
+//------------------------------------------------------------------------------
+#pragma once
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define SLANG_HAS_SSE2 1
+#    if defined(__GNUC__) || defined(__clang__)
+#        include <immintrin.h>
+#        define SLANG_HAS_AVX2_DISPATCH 1
+#    endif
+#endif
+
+#include "slang/numeric/MathUtils.h"
+
+namespace slang {
+
+#if SLANG_HAS_AVX2_DISPATCH
+/// Returns whether the CPU we're running on supports AVX2 instructions.
+inline bool cpuHasAVX2() {
+    static const bool result = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+    return result;
+}
+#endif
+
+/// Matches any character that isn't horizontal whitespace.
+struct NotHorizontalWhitespace {
+    static bool match(char c) { return c != ' ' && c != '\t' && c != '\v' && c != '\f'; }
+
+#if SLANG_HAS_SSE2
+    static uint32_t match(__m128i v) {
+        __m128i a = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                                 _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+        __m128i b = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\v')),
+                                 _mm_cmpeq_epi8(v, _mm_set1_epi8('\f')));
+        return ~(uint32_t)_mm_movemask_epi8(_mm_or_si128(a, b)) & 0xffff;
+    }
+#endif
+
+#if SLANG_HAS_AVX2_DISPATCH
+    __attribute__((target("avx2"))) static uint32_t match(__m256i v) {
+        __m256i a = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+                                    _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')));
+        __m256i b = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\v')),
+                                    _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\f')));
+        return ~(uint32_t)_mm256_movemask_epi8(_mm256_or_si256(a, b));
+    }
+#endif
+};
+
+/// Matches the characters that can end (or interrupt) a line comment:
+/// newlines and nulls.
+struct LineCommentStop {
+    static bool match(char c) { return c == '\n' || c == '\r' || c == '\0'; }
+
+#if SLANG_HAS_SSE2
+    static uint32_t match(__m128i v) {
+        __m128i a = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')),
+                                 _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')));
+        __m128i b = _mm_cmpeq_epi8(v, _mm_setzero_si128());
+        return (uint32_t)_mm_movemask_epi8(_mm_or_si128(a, b));
+    }
+#endif
+
+#if SLANG_HAS_AVX2_DISPATCH
+    __attribute__((target("avx2"))) static uint32_t match(__m256i v) {
+        __m256i a = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')),
+                                    _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')));
+        __m256i b = _mm256_cmpeq_epi8(v, _mm256_setzero_si256());
+        return (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(a, b));
+    }
+#endif
+};
+
+/// Matches the characters that need a closer look inside a block comment:
+/// the pieces of comment delimiters and nulls.
+struct BlockCommentStop {
+    static bool match(char c) { return c == '*' || c == '/' || c == '\0'; }
+
+#if SLANG_HAS_SSE2
+    static uint32_t match(__m128i v) {
+        __m128i a = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('*')),
+                                 _mm_cmpeq_epi8(v, _mm_set1_epi8('/')));
+        __m128i b = _mm_cmpeq_epi8(v, _mm_setzero_si128());
+        return (uint32_t)_mm_movemask_epi8(_mm_or_si128(a, b));
+    }
+#endif
+
+#if SLANG_HAS_AVX2_DISPATCH
+    __attribute__((target("avx2"))) static uint32_t match(__m256i v) {
+        __m256i a = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('*')),
+                                    _mm256_cmpeq_epi8(v, _mm256_set1_epi8('/')));
+        __m256i b = _mm256_cmpeq_epi8(v, _mm256_setzero_si256());
+        return (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(a, b));
+    }
+#endif
+};
+
+/// Matches the characters that can start something spanning more than one line,
+/// or end a line: newlines, comment and string starts, backslashes and graves.
+struct ChunkBoundaryStop {
+    static bool match(char c) {
+        return c == '\n' || c == '/' || c == '"' || c == '\\' || c == '`';
+    }
+
+#if SLANG_HAS_SSE2
+    static uint32_t match(__m128i v) {
+        __m128i a = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')),
+                                 _mm_cmpeq_epi8(v, _mm_set1_epi8('/')));
+        __m128i b = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')),
+                                 _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+        __m128i c = _mm_cmpeq_epi8(v, _mm_set1_epi8('`'));
+        return (uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), c));
+    }
+#endif
+
+#if SLANG_HAS_AVX2_DISPATCH
+    __attribute__((target("avx2"))) static uint32_t match(__m256i v) {
+        __m256i a = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')),
+                                    _mm256_cmpeq_epi8(v, _mm256_set1_epi8('/')));
+        __m256i b = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')),
+                                    _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+        __m256i c = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('`'));
+        return (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(a, b), c));
+    }
+#endif
+};
+
+namespace detail {
+
+#if SLANG_HAS_SSE2
+template<typename TMatcher>
+const char* findFirstSSE2(const char* ptr, const char* end) {
+    for (; end - ptr >= 16; ptr += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+        if (uint32_t mask = TMatcher::match(v))
+            return ptr + countTrailingZeros32(mask);
+    }
+    return ptr;
+}
+#endif
+
+#if SLANG_HAS_AVX2_DISPATCH
+template<typename TMatcher>
+__attribute__((target("avx2"))) const char* findFirstAVX2(const char* ptr, const char* end) {
+    for (; end - ptr >= 32; ptr += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+        if (uint32_t mask = TMatcher::match(v))
+            return ptr + countTrailingZeros32(mask);
+    }
+    return ptr;
+}
+#endif
+
+} // namespace detail
+
+/// Returns a pointer to the first character in the range [ptr, end) that
+/// matches @a TMatcher, or @a end if there isn't one. The range is searched
+/// as many bytes at a time as the CPU allows.
+template<typename TMatcher>
+const char* findFirst(const char* ptr, const char* end) {
+    // Lots of runs are very short, so check the first character
+    // before paying for the vector setup.
+    if (ptr == end || TMatcher::match(*ptr))
+        return ptr;
+    ptr++;
+
+    // Each stage stops either on a match or when there's not enough text left
+    // for a full stride; in the first case the later stages return right away.
+#if SLANG_HAS_AVX2_DISPATCH
+    if (cpuHasAVX2())
+        ptr = detail::findFirstAVX2<TMatcher>(ptr, end);
+#endif
+#if SLANG_HAS_SSE2
+    ptr = detail::findFirstSSE2<TMatcher>(ptr, end);
+#endif
+
+    while (ptr != end && !TMatcher::match(*ptr))
+        ptr++;
+    return ptr;
+}
+
+} // namespace slang
@@ -8,14 +8,26 @@
 
 #include <fstream>
 
+#include "slang/numeric/MathUtils.h"
+#include "slang/util/Hash.h"
 #include "slang/util/StackContainer.h"
+#include "slang/util/ThreadPool.h"
+
+#include "CharScan.h"
 
 namespace slang {
 
 SourceManager::SourceManager() {
     // add a dummy entry to the start of the directory list so that our file IDs line up
-    FileInfo file;
-    bufferEntries.emplace_back(file);
+    addBufferEntry(FileInfo());
+}
+
+SourceManager::~SourceManager() {
+    // make sure background work is done before we start tearing down file data
+    lineTablePool.reset();
+
+    for (auto& chunk : entryChunks)
+        delete[] chunk.load(std::memory_order_relaxed);
 }
 
 std::string SourceManager::makeAbsolutePath(string_view path) const {
@@ -23,16 +35,24 @@ std::string SourceManager::makeAbsolutePath(string_view path) const {
 }
 
 void SourceManager::addSystemDirectory(string_view path) {
-    systemDirectories.push_back(fs::canonical(path));
+    auto dir = fs::canonical(path);
+    std::unique_lock lock(mut);
+    systemDirectories.emplace_back(std::move(dir));
+    includeCache.clear();
 }
 
 void SourceManager::addUserDirectory(string_view path) {
-    userDirectories.push_back(fs::canonical(path));
+    auto dir = fs::canonical(path);
+    std::unique_lock lock(mut);
+    userDirectories.emplace_back(std::move(dir));
+    includeCache.clear();
 }
 
 uint32_t SourceManager::getLineNumber(SourceLocation location) const {
     SourceLocation fileLocation = getFullyExpandedLoc(location);
-    uint32_t rawLineNumber = getRawLineNumber(fileLocation);
+
+    std::shared_lock lock(mut);
+    uint32_t rawLineNumber = getRawLineNumber(fileLocation, lock);
     if (rawLineNumber == 0)
         return 0;
 
@@ -51,9 +71,10 @@ uint32_t SourceManager::getColumnNumber(SourceLocation location) const {
         return 0;
 
     // walk backward to find start of line
+    string_view text = fd->text();
     uint32_t lineStart = location.offset();
-    ASSERT(lineStart < fd->mem.size());
-    while (lineStart > 0 && fd->mem[lineStart - 1] != '\n' && fd->mem[lineStart - 1] != '\r')
+    ASSERT(lineStart < text.size());
+    while (lineStart > 0 && text[lineStart - 1] != '\n' && text[lineStart - 1] != '\r')
         lineStart--;
 
     return location.offset() - lineStart + 1;
@@ -66,10 +87,12 @@ string_view SourceManager::getFileName(SourceLocation location) const {
     FileData* fd = getFileData(fileLocation.buffer());
     if (!fd)
         return "";
-    else if (fd->lineDirectives.empty())
+
+    std::shared_lock lock(mut);
+    if (fd->lineDirectives.empty())
         return string_view(fd->name);
 
-    auto lineDirective = fd->getPreviousLineDirective(getRawLineNumber(fileLocation));
+    auto lineDirective = fd->getPreviousLineDirective(getRawLineNumber(fileLocation, lock));
     if (!lineDirective)
         return string_view(fd->name);
     else
@@ -88,8 +111,7 @@ SourceLocation SourceManager::getIncludedFrom(BufferID buffer) const {
     if (!buffer)
         return SourceLocation();
 
-    ASSERT(buffer.id < bufferEntries.size());
-    const FileInfo* info = std::get_if<FileInfo>(&bufferEntries[buffer.id]);
+    const FileInfo* info = std::get_if<FileInfo>(&getBufferEntry(buffer));
     return info ? info->includedFrom : SourceLocation();
 }
 
@@ -101,12 +123,15 @@ string_view SourceManager::getMacroName(SourceLocation location) const {
     if (!buffer)
         return {};
 
-    ASSERT(buffer.id < bufferEntries.size());
-    auto info = std::get_if<ExpansionInfo>(&bufferEntries[buffer.id]);
+    auto info = std::get_if<ExpansionInfo>(&getBufferEntry(buffer));
     if (!info)
         return {};
 
-    return info->macroName;
+    std::shared_lock lock(mut);
+    if (info->macroName >= macroNames.size())
+        return {};
+
+    return macroNames[info->macroName];
 }
 
 bool SourceManager::isFileLoc(SourceLocation location) const {
@@ -114,8 +139,7 @@ bool SourceManager::isFileLoc(SourceLocation location) const {
     if (!buffer)
         return false;
 
-    ASSERT(buffer.id < bufferEntries.size());
-    return std::get_if<FileInfo>(&bufferEntries[buffer.id]) != nullptr;
+    return std::get_if<FileInfo>(&getBufferEntry(buffer)) != nullptr;
 }
 
 bool SourceManager::isMacroLoc(SourceLocation location) const {
@@ -123,8 +147,7 @@ bool SourceManager::isMacroLoc(SourceLocation location) const {
     if (!buffer)
         return false;
 
-    ASSERT(buffer.id < bufferEntries.size());
-    return std::get_if<ExpansionInfo>(&bufferEntries[buffer.id]) != nullptr;
+    return std::get_if<ExpansionInfo>(&getBufferEntry(buffer)) != nullptr;
 }
 
 bool SourceManager::isMacroArgLoc(SourceLocation location) const {
@@ -132,9 +155,8 @@ bool SourceManager::isMacroArgLoc(SourceLocation location) const {
     if (!buffer)
         return false;
 
-    ASSERT(buffer.id < bufferEntries.size());
-    auto info = std::get_if<ExpansionInfo>(&bufferEntries[buffer.id]);
-    return info && info->isMacroArg;
+    auto info = std::get_if<ExpansionInfo>(&getBufferEntry(buffer));
+    return info && info->isMacroArg();
 }
 
 bool SourceManager::isIncludedFileLoc(SourceLocation location) const {
@@ -190,8 +212,7 @@ SourceLocation SourceManager::getExpansionLoc(SourceLocation location) const {
     if (!buffer)
         return SourceLocation();
 
-    ASSERT(buffer.id < bufferEntries.size());
-    return std::get<ExpansionInfo>(bufferEntries[buffer.id]).expansionStart;
+    return std::get<ExpansionInfo>(getBufferEntry(buffer)).expansionStart;
 }
 
 SourceRange SourceManager::getExpansionRange(SourceLocation location) const {
@@ -199,9 +220,12 @@ SourceRange SourceManager::getExpansionRange(SourceLocation location) const {
     if (!buffer)
         return SourceRange();
 
-    ASSERT(buffer.id < bufferEntries.size());
-    const ExpansionInfo& info = std::get<ExpansionInfo>(bufferEntries[buffer.id]);
-    return SourceRange(info.expansionStart, info.expansionEnd);
+    const ExpansionInfo& info = std::get<ExpansionInfo>(getBufferEntry(buffer));
+    if (info.expansionLength != ExpansionInfo::FarEnd)
+        return SourceRange(info.expansionStart, info.expansionStart + info.expansionLength);
+
+    std::shared_lock lock(mut);
+    return SourceRange(info.expansionStart, farExpansionEnds.at(buffer.getId()));
 }
 
 SourceLocation SourceManager::getOriginalLoc(SourceLocation location) const {
@@ -209,8 +233,7 @@ SourceLocation SourceManager::getOriginalLoc(SourceLocation location) const {
     if (!buffer)
         return SourceLocation();
 
-    ASSERT(buffer.id < bufferEntries.size());
-    return std::get<ExpansionInfo>(bufferEntries[buffer.id]).originalLoc +
+    return std::get<ExpansionInfo>(getBufferEntry(buffer)).originalLoc +
            (size_t)location.offset();
 }
 
@@ -235,24 +258,62 @@ string_view SourceManager::getSourceText(BufferID buffer) const {
     if (!fd)
         return "";
 
-    return string_view(fd->mem.data(), fd->mem.size());
+    return fd->text();
 }
 
 SourceLocation SourceManager::createExpansionLoc(SourceLocation originalLoc,
                                                  SourceLocation expansionStart,
                                                  SourceLocation expansionEnd, bool isMacroArg) {
-    bufferEntries.emplace_back(
-        ExpansionInfo(originalLoc, expansionStart, expansionEnd, isMacroArg));
-    return SourceLocation(BufferID::get((uint32_t)(bufferEntries.size() - 1)), 0);
+    return createExpansionLoc(originalLoc, expansionStart, expansionEnd,
+                              isMacroArg ? ExpansionInfo::MacroArg : ExpansionInfo::NoName);
 }
 
 SourceLocation SourceManager::createExpansionLoc(SourceLocation originalLoc,
                                                  SourceLocation expansionStart,
                                                  SourceLocation expansionEnd,
                                                  string_view macroName) {
+    return createExpansionLoc(originalLoc, expansionStart, expansionEnd,
+                              getMacroNameIndex(macroName));
+}
 
-    bufferEntries.emplace_back(ExpansionInfo(originalLoc, expansionStart, expansionEnd, macroName));
-    return SourceLocation(BufferID::get((uint32_t)(bufferEntries.size() - 1)), 0);
+SourceLocation SourceManager::createExpansionLoc(SourceLocation originalLoc,
+                                                 SourceLocation expansionStart,
+                                                 SourceLocation expansionEnd, uint32_t macroName) {
+    // The end of the range is almost always a little ways after the start in the same
+    // buffer; in the rare case it isn't (such as when the last argument to a macro came
+    // from some other expansion) we need to remember it separately.
+    uint32_t length = ExpansionInfo::FarEnd;
+    if (expansionEnd.buffer() == expansionStart.buffer() &&
+        expansionEnd.offset() >= expansionStart.offset() &&
+        expansionEnd.offset() - expansionStart.offset() < ExpansionInfo::FarEnd) {
+        length = expansionEnd.offset() - expansionStart.offset();
+    }
+
+    BufferID id = addBufferEntry(ExpansionInfo(originalLoc, expansionStart, length, macroName));
+    if (length == ExpansionInfo::FarEnd) {
+        std::unique_lock lock(mut);
+        farExpansionEnds.emplace(id.getId(), expansionEnd);
+    }
+    return SourceLocation(id, 0);
+}
+
+uint32_t SourceManager::getMacroNameIndex(string_view name) {
+    {
+        std::shared_lock lock(mut);
+        auto it = macroNameIndices.find(name);
+        if (it != macroNameIndices.end())
+            return it->second;
+    }
+
+    std::unique_lock lock(mut);
+    auto it = macroNameIndices.find(name);
+    if (it != macroNameIndices.end())
+        return it->second;
+
+    uint32_t index = (uint32_t)macroNames.size();
+    ASSERT(index < ExpansionInfo::MacroArg);
+    macroNameIndices.emplace(macroNames.emplace_back(name), index);
+    return index;
 }
 
 SourceBuffer SourceManager::assignText(string_view text, SourceLocation includedFrom) {
@@ -278,49 +339,108 @@ SourceBuffer SourceManager::assignText(string_view path, string_view text,
 
 SourceBuffer SourceManager::assignBuffer(string_view path, std::vector<char>&& buffer,
                                          SourceLocation includedFrom) {
-    userFileBuffers.emplace_back(FileData(nullptr, std::string(path), std::move(buffer)));
-    return createBufferEntry(&userFileBuffers.back(), includedFrom);
+    FileData* fd;
+    {
+        std::unique_lock lock(mut);
+        fd = &userFileBuffers.emplace_back(nullptr, std::string(path),
+                                           std::make_shared<FileContents>(std::move(buffer)));
+    }
+    return createBufferEntry(fd, includedFrom);
 }
 
 SourceBuffer SourceManager::readSource(string_view path) {
     ASSERT(!path.empty());
-    return openCached(path, SourceLocation());
+    FileData* fd = openCached(path);
+    if (!fd)
+        return SourceBuffer();
+    return createBufferEntry(fd, SourceLocation());
 }
 
 SourceBuffer SourceManager::readHeader(string_view path, SourceLocation includedFrom,
                                        bool isSystemPath) {
+    const fs::path* directory = nullptr;
+    if (!isSystemPath) {
+        FileData* fd = getFileData(includedFrom.buffer());
+        if (fd)
+            directory = fd->directory;
+    }
+
+    FileData* fd = resolveHeader(path, directory, isSystemPath);
+    if (!fd)
+        return SourceBuffer();
+    return createBufferEntry(fd, includedFrom);
+}
+
+string_view SourceManager::prefetchHeader(string_view path, const fs::path*& directory,
+                                          bool isSystemPath) {
+    FileData* fd = resolveHeader(path, isSystemPath ? nullptr : directory, isSystemPath);
+    if (!fd)
+        return {};
+
+    directory = fd->directory;
+    return fd->text();
+}
+
+const fs::path* SourceManager::getDirectory(BufferID buffer) const {
+    FileData* fd = getFileData(buffer);
+    return fd ? fd->directory : nullptr;
+}
+
+SourceManager::FileData* SourceManager::resolveHeader(string_view path,
+                                                      const fs::path* directory,
+                                                      bool isSystemPath) {
     // if the header is specified as an absolute path, just do a straight lookup
     ASSERT(!path.empty());
     fs::path p = path;
     if (p.is_absolute())
-        return openCached(p, includedFrom);
-
-    // system path lookups only look in system directories
-    if (isSystemPath) {
-        for (auto& d : systemDirectories) {
-            SourceBuffer result = openCached(d / p, includedFrom);
-            if (result.id)
-                return result;
+        return openCached(p);
+
+    // see if we've already resolved this name from this directory
+    auto key = std::make_tuple(std::string(path), directory, isSystemPath);
+    {
+        std::shared_lock lock(mut);
+        auto it = includeCache.find(key);
+        if (it != includeCache.end()) {
+            includeCacheHits++;
+            probesSaved += it->second.probes;
+            return it->second.file;
         }
-        return SourceBuffer();
     }
 
-    // search relative to the current file
-    FileData* fd = getFileData(includedFrom.buffer());
-    if (fd && fd->directory) {
-        SourceBuffer result = openCached((*fd->directory) / p, includedFrom);
-        if (result.id)
-            return result;
+    // Build the list of candidate paths up front so that we don't need to hold
+    // the lock while probing the file system.
+    std::vector<fs::path> candidates;
+    if (isSystemPath) {
+        // system path lookups only look in system directories
+        std::shared_lock lock(mut);
+        for (auto& d : systemDirectories)
+            candidates.emplace_back(d / p);
+    }
+    else {
+        // search relative to the current file
+        if (directory)
+            candidates.emplace_back(*directory / p);
+
+        // search additional include directories
+        std::shared_lock lock(mut);
+        for (auto& d : userDirectories)
+            candidates.emplace_back(d / p);
     }
 
-    // search additional include directories
-    for (auto& d : userDirectories) {
-        SourceBuffer result = openCached(d / p, includedFrom);
-        if (result.id)
-            return result;
+    includeCacheMisses++;
+
+    FileData* result = nullptr;
+    uint32_t probes = 0;
+    for (auto& candidate : candidates) {
+        probes++;
+        result = openCached(candidate);
+        if (result)
+            break;
     }
 
-    return SourceBuffer();
+    std::unique_lock lock(mut);
+    includeCache.try_emplace(std::move(key), ResolvedInclude{ result, probes });
+    return result;
 }
 
 void SourceManager::addLineDirective(SourceLocation location, uint32_t lineNum, string_view name,
@@ -330,6 +450,7 @@ void SourceManager::addLineDirective(SourceLocation location, uint32_t lineNum,
     if (!fd)
         return;
 
+    std::unique_lock lock(mut);
     fs::path full;
     fs::path linePath = name;
     if (linePath.has_relative_path())
@@ -337,52 +458,123 @@ void SourceManager::addLineDirective(SourceLocation location, uint32_t lineNum,
     else
         full = fs::path(fd->name).replace_filename(linePath);
 
-    uint32_t sourceLineNum = getRawLineNumber(fileLocation);
+    uint32_t sourceLineNum = getRawLineNumber(fileLocation, lock);
     fd->lineDirectives.emplace_back(full.string(), sourceLineNum, lineNum, level);
 }
 
+SourceManagerStats SourceManager::getStats() const {
+    SourceManagerStats stats;
+    stats.includeCacheHits = includeCacheHits;
+    stats.includeCacheMisses = includeCacheMisses;
+    stats.probesSaved = probesSaved;
+    stats.duplicateFiles = duplicateFiles;
+    stats.duplicateBytesSaved = duplicateBytesSaved;
+    return stats;
+}
+
+void SourceManager::setEagerLineTables(bool enabled) {
+    // Don't destroy the pool while holding the lock; its pending tasks need it.
+    std::unique_ptr<ThreadPool> oldPool;
+    {
+        std::unique_lock lock(mut);
+        if (enabled == (lineTablePool != nullptr))
+            return;
+
+        if (enabled)
+            lineTablePool = std::make_unique<ThreadPool>(1);
+        else
+            oldPool = std::move(lineTablePool);
+    }
+}
+
+bool SourceManager::isEagerLineTables() const {
+    std::shared_lock lock(mut);
+    return lineTablePool != nullptr;
+}
+
+BufferID SourceManager::addBufferEntry(BufferEntry&& entry) {
+    // Figure out which chunk the new entry lives in. Chunk N holds
+    // 2^(FirstChunkBits + N) entries.
+    uint32_t index = entryCount.fetch_add(1);
+    uint64_t slot = uint64_t(index) + (1ull << FirstChunkBits);
+    uint32_t chunk = 63 - countLeadingZeros64(slot) - FirstChunkBits;
+    uint64_t chunkSize = 1ull << (FirstChunkBits + chunk);
+
+    BufferEntry* base = entryChunks[chunk].load(std::memory_order_acquire);
+    if (!base) {
+        std::lock_guard lock(entryChunkMutex);
+        base = entryChunks[chunk].load(std::memory_order_relaxed);
+        if (!base) {
+            base = new BufferEntry[chunkSize];
+            entryChunks[chunk].store(base, std::memory_order_release);
+        }
+    }
+
+    base[slot - chunkSize] = std::move(entry);
+    return BufferID::get(index);
+}
+
+const SourceManager::BufferEntry& SourceManager::getBufferEntry(BufferID buffer) const {
+    uint32_t index = buffer.getValue();
+    ASSERT(index < entryCount.load(std::memory_order_relaxed));
+
+    uint64_t slot = uint64_t(index) + (1ull << FirstChunkBits);
+    uint32_t chunk = 63 - countLeadingZeros64(slot) - FirstChunkBits;
+    uint64_t chunkSize = 1ull << (FirstChunkBits + chunk);
+    return entryChunks[chunk].load(std::memory_order_acquire)[slot - chunkSize];
+}
+
 SourceManager::FileData* SourceManager::getFileData(BufferID buffer) const {
     if (!buffer)
         return nullptr;
 
-    ASSERT(buffer.id < bufferEntries.size());
-    return std::get<FileInfo>(bufferEntries[buffer.id]).data;
+    return std::get<FileInfo>(getBufferEntry(buffer)).data;
 }
 
 SourceBuffer SourceManager::createBufferEntry(FileData* fd, SourceLocation includedFrom) {
     ASSERT(fd);
-    bufferEntries.emplace_back(FileInfo(fd, includedFrom));
-    return SourceBuffer{ string_view(fd->mem.data(), fd->mem.size()),
-                         BufferID::get((uint32_t)(bufferEntries.size() - 1)) };
+    return SourceBuffer{ fd->text(), addBufferEntry(FileInfo(fd, includedFrom)) };
 }
 
-SourceBuffer SourceManager::openCached(const fs::path& fullPath, SourceLocation includedFrom) {
+SourceManager::FileData* SourceManager::openCached(const fs::path& fullPath) {
     std::error_code ec;
     fs::path absPath = fs::canonical(fullPath, ec);
     if (ec)
-        return SourceBuffer();
+        return nullptr;
 
     // first see if we have this file cached
-    auto it = lookupCache.find(absPath.string());
-    if (it != lookupCache.end()) {
-        FileData* fd = it->second.get();
-        if (!fd)
-            return SourceBuffer();
-        return createBufferEntry(fd, includedFrom);
+    std::string pathStr = absPath.string();
+    {
+        std::shared_lock lock(mut);
+        auto it = lookupCache.find(pathStr);
+        if (it != lookupCache.end())
+            return it->second.get();
+    }
+
+    // Otherwise we need to load it. Don't hold the lock while we do the read so that
+    // other threads can keep going; if someone else loads the same file in the meantime
+    // we'll notice when we go to cache it.
+    // map the file if we've been asked to; if that doesn't work out for some reason
+    // we fall back to reading it into memory
+    if (useMemoryMapping) {
+        MappedFile mapping = MappedFile::open(absPath, /* nullTerminated */ true);
+        if (mapping)
+            return cacheFile(absPath, std::make_shared<FileContents>(std::move(mapping)));
     }
 
     // do the read
     std::vector<char> buffer;
     if (!readFile(absPath, buffer)) {
-        lookupCache.emplace(absPath.string(), nullptr);
-        return SourceBuffer();
+        std::unique_lock lock(mut);
+        lookupCache.emplace(std::move(pathStr), nullptr);
+        return nullptr;
     }
 
-    return cacheBuffer(absPath, includedFrom, std::move(buffer));
+    return cacheFile(absPath, std::make_shared<FileContents>(std::move(buffer)));
 }
 
-SourceBuffer SourceManager::cacheBuffer(const fs::path& path, SourceLocation includedFrom,
-                                        std::vector<char>&& buffer) {
+SourceManager::FileData* SourceManager::cacheFile(const fs::path& path,
+                                                  std::shared_ptr<FileContents> contents) {
     std::string name;
     std::error_code ec;
     fs::path rel = fs::proximate(path, ec);
@@ -391,31 +583,142 @@ SourceBuffer SourceManager::cacheBuffer(const fs::path& path, SourceLocation inc
     else
         name = rel.string();
 
-    auto fd = std::make_unique<FileData>(&*directories.insert(path.parent_path()).first,
-                                         std::move(name), std::move(buffer));
+    // See if we've already loaded a file with exactly the same text from some other
+    // path, and if so share its contents (and line table). Cached contents are never
+    // modified, so the actual comparison can happen without holding the lock.
+    string_view text = contents->text();
+    uint64_t hash = xxhash64(text.data(), text.size(), 0);
+
+    std::vector<std::shared_ptr<FileContents>> candidates;
+    {
+        std::shared_lock lock(mut);
+        auto range = contentCache.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it)
+            candidates.push_back(it->second);
+    }
+
+    bool isDuplicate = false;
+    for (auto& candidate : candidates) {
+        if (candidate->text() == text) {
+            contents = candidate;
+            isDuplicate = true;
+            break;
+        }
+    }
+
+    auto fd = std::make_unique<FileData>(nullptr, std::move(name), contents);
+
+    FileData* fdPtr;
+    {
+        std::unique_lock lock(mut);
+        fd->directory = &*directories.insert(path.parent_path()).first;
+
+        // if another thread beat us to loading this file, use their copy instead
+        auto [it, inserted] = lookupCache.try_emplace(path.string(), std::move(fd));
+        fdPtr = it->second.get();
+        if (!fdPtr)
+            return nullptr;
+
+        if (inserted && isDuplicate) {
+            duplicateFiles++;
+            duplicateBytesSaved += text.size();
+        }
+        else if (inserted) {
+            contentCache.emplace(hash, contents);
+            if (lineTablePool) {
+                lineTablePool->push([this, contents] {
+                    std::vector<uint32_t> offsets;
+                    computeLineOffsets(contents->text(), offsets);
+
+                    std::unique_lock writeLock(mut);
+                    if (contents->lineOffsets.empty())
+                        contents->lineOffsets = std::move(offsets);
+                });
+            }
+        }
+    }
+    return fdPtr;
+}
+
+namespace {
+
+// Given a mask of positions (relative to base) that hold a '\n' or '\r', records the
+// offset of the start of each new line. @a next is the index of the first character
+// that hasn't been consumed yet, which lets a \r\n pair straddle two blocks.
+inline void addLineStarts(const char* data, size_t base, uint32_t mask, size_t& next,
+                          std::vector<uint32_t>& offsets) {
+    while (mask) {
+        size_t i = base + countTrailingZeros32(mask);
+        mask &= mask - 1;
+        if (i < next)
+            continue;
+
+        // if we see \r\n or \n\r skip both chars
+        if ((data[i + 1] == '\n' || data[i + 1] == '\r') && data[i] != data[i + 1])
+            i++;
+
+        next = i + 1;
+        offsets.push_back((uint32_t)next);
+    }
+}
 
-    FileData* fdPtr = lookupCache.emplace(path.string(), std::move(fd)).first->second.get();
-    return createBufferEntry(fdPtr, includedFrom);
+#if SLANG_HAS_SSE2
+size_t scanLineStartsSSE2(const char* data, size_t i, size_t size, size_t& next,
+                          std::vector<uint32_t>& offsets) {
+    const __m128i nl = _mm_set1_epi8('\n');
+    const __m128i cr = _mm_set1_epi8('\r');
+    for (; i + 16 <= size; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i eq = _mm_or_si128(_mm_cmpeq_epi8(v, nl), _mm_cmpeq_epi8(v, cr));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(eq);
+        if (mask)
+            addLineStarts(data, i, mask, next, offsets);
+    }
+    return i;
+}
+#endif
+
+#if SLANG_HAS_AVX2_DISPATCH
+__attribute__((target("avx2"))) size_t scanLineStartsAVX2(const char* data, size_t i,
+                                                          size_t size, size_t& next,
+                                                          std::vector<uint32_t>& offsets) {
+    const __m256i nl = _mm256_set1_epi8('\n');
+    const __m256i cr = _mm256_set1_epi8('\r');
+    for (; i + 32 <= size; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i eq = _mm256_or_si256(_mm256_cmpeq_epi8(v, nl), _mm256_cmpeq_epi8(v, cr));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(eq);
+        if (mask)
+            addLineStarts(data, i, mask, next, offsets);
+    }
+    return i;
 }
+#endif
+
+} // namespace
 
-void SourceManager::computeLineOffsets(const std::vector<char>& buffer,
-                                       std::vector<uint32_t>& offsets) {
+void SourceManager::computeLineOffsets(string_view buffer, std::vector<uint32_t>& offsets) {
     // first line always starts at offset 0
     offsets.push_back(0);
 
-    const char* ptr = buffer.data();
-    const char* end = buffer.data() + buffer.size();
-    while (ptr != end) {
-        if (ptr[0] == '\n' || ptr[0] == '\r') {
-            // if we see \r\n or \n\r skip both chars
-            if ((ptr[1] == '\n' || ptr[1] == '\r') && ptr[0] != ptr[1])
-                ptr++;
-            ptr++;
-            offsets.push_back((uint32_t)(ptr - buffer.data()));
-        }
-        else {
-            ptr++;
-        }
+    // Scan for newlines as many bytes at a time as the CPU allows, then
+    // finish off whatever is left over one byte at a time.
+    const char* data = buffer.data();
+    size_t size = buffer.size();
+    size_t next = 0;
+    size_t i = 0;
+
+#if SLANG_HAS_AVX2_DISPATCH
+    if (cpuHasAVX2())
+        i = scanLineStartsAVX2(data, i, size, next, offsets);
+#endif
+#if SLANG_HAS_SSE2
+    i = scanLineStartsSSE2(data, i, size, next, offsets);
+#endif
+
+    for (; i < size; i++) {
+        if (data[i] == '\n' || data[i] == '\r')
+            addLineStarts(data, i, 1, next, offsets);
     }
 }
 
@@ -460,23 +763,43 @@ const SourceManager::LineDirectiveInfo* SourceManager::FileData::getPreviousLine
     return nullptr;
 }
 
-uint32_t SourceManager::getRawLineNumber(SourceLocation location) const {
+template<typename TLock>
+uint32_t SourceManager::getRawLineNumber(SourceLocation location, TLock& lock) const {
     FileData* fd = getFileData(location.buffer());
     if (!fd)
         return 0;
 
-    // compute line offsets if we haven't already
-    if (fd->lineOffsets.empty())
-        computeLineOffsets(fd->mem, fd->lineOffsets);
+    // Compute line offsets if we haven't already. If we only hold a shared lock we need
+    // to trade it for an exclusive one while we do so.
+    FileContents& contents = *fd->contents;
+    if (contents.lineOffsets.empty()) {
+        if constexpr (std::is_same_v<TLock, std::shared_lock<std::shared_mutex>>) {
+            // The file text never changes, so build the table without holding
+            // the lock at all and then publish it.
+            lock.unlock();
+            std::vector<uint32_t> offsets;
+            computeLineOffsets(contents.text(), offsets);
+            {
+                std::unique_lock writeLock(mut);
+                if (contents.lineOffsets.empty())
+                    contents.lineOffsets = std::move(offsets);
+            }
+            lock.lock();
+        }
+        else {
+            computeLineOffsets(contents.text(), contents.lineOffsets);
+        }
+    }
 
     // Find the first line offset that is greater than the given location offset. That iterator
     // then tells us how many lines away from the beginning we are.
-    auto it = std::lower_bound(fd->lineOffsets.begin(), fd->lineOffsets.end(), location.offset());
+    auto& lineOffsets = contents.lineOffsets;
+    auto it = std::lower_bound(lineOffsets.begin(), lineOffsets.end(), location.offset());
 
     // We want to ensure the line we return is strictly greater than the given location offset.
     // So if it is equal, add one to the lower bound we got.
-    uint32_t line = uint32_t(it - fd->lineOffsets.begin());
-    if (it != fd->lineOffsets.end() && *it == location.offset())
+    uint32_t line = uint32_t(it - lineOffsets.begin());
+    if (it != lineOffsets.end() && *it == location.offset())
         line++;
     return line;
 }
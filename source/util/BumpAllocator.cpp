@@ -48,12 +48,22 @@ void BumpAllocator::steal(BumpAllocator&& other) {
     head->prev = std::exchange(other.head, nullptr);
 }
 
+size_t BumpAllocator::getBytesAllocated() const {
+    size_t total = 0;
+    for (Segment* seg = head; seg; seg = seg->prev)
+        total += size_t(seg->current - reinterpret_cast<byte*>(seg + 1));
+    return total;
+}
+
 byte* BumpAllocator::allocateSlow(size_t size, size_t alignment) {
     // for really large allocations, give them their own segment
     if (size > (SEGMENT_SIZE >> 1)) {
         size = (size + alignment - 1) & ~(alignment - 1);
         head->prev = allocSegment(head->prev, size + sizeof(Segment));
-        return alignPtr(head->prev->current, alignment);
+
+        byte* result = alignPtr(head->prev->current, alignment);
+        head->prev->current = result + size;
+        return result;
     }
 
     // otherwise, start a new block
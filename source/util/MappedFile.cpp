@@ -0,0 +1,71 @@
+//------------------------------------------------------------------------------
+// MappedFile.cpp
+// Read-only memory mapped files.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#include "slang/util/MappedFile.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <unistd.h>
+#    define SLANG_HAS_MMAP 1
+#endif
+
+namespace slang {
+
+MappedFile MappedFile::open(const std::filesystem::path& path, bool nullTerminated) {
+#if SLANG_HAS_MMAP
+    std::error_code ec;
+    uintmax_t size = std::filesystem::file_size(path, ec);
+    if (ec || size == 0)
+        return MappedFile();
+
+    // The OS zero fills the remainder of the last page of a mapping, so as long as
+    // the file doesn't end exactly on a page boundary we get the terminator for free.
+    if (nullTerminated) {
+        long pageSize = sysconf(_SC_PAGESIZE);
+        if (pageSize <= 0 || size % (uintmax_t)pageSize == 0)
+            return MappedFile();
+    }
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return MappedFile();
+
+    void* addr = ::mmap(nullptr, (size_t)size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED)
+        return MappedFile();
+
+    return MappedFile(static_cast<const char*>(addr), (size_t)size + (nullTerminated ? 1 : 0),
+                      (size_t)size);
+#else
+    (void)path;
+    (void)nullTerminated;
+    return MappedFile();
+#endif
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept :
+    data(std::exchange(other.data, nullptr)), size(std::exchange(other.size, 0)),
+    mappedSize(std::exchange(other.mappedSize, 0)) {
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        this->~MappedFile();
+        new (this) MappedFile(std::move(other));
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+#if SLANG_HAS_MMAP
+    if (data)
+        ::munmap(const_cast<char*>(data), mappedSize);
+#endif
+}
+
+} // namespace slang
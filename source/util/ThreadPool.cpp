@@ -0,0 +1,134 @@
+//------------------------------------------------------------------------------
+// ThreadPool.cpp
+// Lightweight work-stealing thread pool.
+//
+// File is under the MIT license; see LICENSE for details.
+//------------------------------------------------------------------------------
+#include "slang/util/ThreadPool.h"
+
+namespace slang {
+
+// The pool and queue index of the worker running on the current thread, if any.
+static thread_local const ThreadPool* currentPool = nullptr;
+static thread_local size_t currentQueue = 0;
+
+ThreadPool::ThreadPool(uint32_t threadCount) {
+    if (threadCount == 0)
+        threadCount = getDefaultThreadCount();
+
+    for (uint32_t i = 0; i < threadCount; i++)
+        queues.emplace_back(std::make_unique<WorkQueue>());
+
+    for (uint32_t i = 0; i < threadCount; i++)
+        threads.emplace_back([this, i] { workerMain(i); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::unique_lock lock(mutex);
+        allDone.wait(lock, [this] { return pendingTasks == 0; });
+        stopping = true;
+    }
+
+    workAvailable.notify_all();
+    for (auto& thread : threads)
+        thread.join();
+}
+
+void ThreadPool::waitForAll() {
+    std::unique_lock lock(mutex);
+    allDone.wait(lock, [this] { return pendingTasks == 0; });
+
+    if (firstException)
+        std::rethrow_exception(std::exchange(firstException, nullptr));
+}
+
+uint32_t ThreadPool::getDefaultThreadCount() {
+    uint32_t count = std::thread::hardware_concurrency();
+    return count ? count : 1;
+}
+
+void ThreadPool::pushTask(Task&& task) {
+    // Tasks spawned by a worker go into its own queue for locality; others
+    // get spread across the workers round-robin.
+    size_t index;
+    {
+        std::unique_lock lock(mutex);
+        if (currentPool == this)
+            index = currentQueue;
+        else
+            index = nextQueue++ % queues.size();
+
+        // Count the task before it becomes visible so that a worker that steals it
+        // right away never sees the counters go negative.
+        queuedTasks++;
+        pendingTasks++;
+    }
+
+    {
+        auto& queue = *queues[index];
+        std::unique_lock lock(queue.mutex);
+        queue.tasks.emplace_back(std::move(task));
+    }
+
+    workAvailable.notify_one();
+}
+
+bool ThreadPool::tryPopTask(size_t index, Task& task) {
+    // Take from the back of our own queue first, then try to steal
+    // from the front of everyone else's.
+    for (size_t i = 0; i < queues.size(); i++) {
+        auto& queue = *queues[(index + i) % queues.size()];
+        std::unique_lock lock(queue.mutex);
+        if (queue.tasks.empty())
+            continue;
+
+        if (i == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        lock.unlock();
+
+        std::unique_lock stateLock(mutex);
+        queuedTasks--;
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::workerMain(size_t index) {
+    currentPool = this;
+    currentQueue = index;
+
+    while (true) {
+        Task task;
+        if (tryPopTask(index, task)) {
+            std::exception_ptr ex;
+            try {
+                task();
+            }
+            catch (...) {
+                ex = std::current_exception();
+            }
+
+            std::unique_lock lock(mutex);
+            if (ex && !firstException)
+                firstException = ex;
+
+            if (--pendingTasks == 0)
+                allDone.notify_all();
+            continue;
+        }
+
+        std::unique_lock lock(mutex);
+        workAvailable.wait(lock, [this] { return stopping || queuedTasks > 0; });
+        if (stopping && queuedTasks == 0)
+            return;
+    }
+}
+
+} // namespace slang
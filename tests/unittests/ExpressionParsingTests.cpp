@@ -65,6 +65,63 @@ TEST_CASE("Integer with question") {
     CHECK_DIAGNOSTICS_EMPTY;
 }
 
+TEST_CASE("Lazy integer literals") {
+    auto parseVector = [](const std::string& text, bool lazy) {
+        ParserOptions parserOptions;
+        parserOptions.lazyIntegerLiterals = lazy;
+
+        Bag options;
+        options.add(parserOptions);
+
+        diagnostics.clear();
+        Preprocessor preprocessor(getSourceManager(), alloc, diagnostics);
+        preprocessor.pushSource(string_view(text));
+
+        Parser parser(preprocessor, options);
+        auto& expr = parser.parseExpression();
+        REQUIRE(expr.kind == SyntaxKind::IntegerVectorExpression);
+        return expr.as<IntegerVectorExpressionSyntax>().value;
+    };
+
+    const char* literals[] = { "34'd56",      "4'b?10?", "128'hdead_beef_1e5_cafe_f00d_0123",
+                               "'hFF_ff",     "'o777",   "8'sb1x0z_01zz",
+                               "20'shf_f1e3", "4'dx",    "4'd?",
+                               "'d1_000" };
+
+    for (std::string literal : literals) {
+        SVInt expected = parseVector(literal, false).intValue();
+        CHECK_DIAGNOSTICS_EMPTY;
+
+        Token token = parseVector(literal, true);
+        CHECK_DIAGNOSTICS_EMPTY;
+        CHECK(std::holds_alternative<Token::Info::UndecodedInt>(
+            token.getInfo()->numInfo().value));
+        CHECK(exactlyEqual(token.intValue(), expected));
+
+        // The first call saves the value in the token for later calls to return.
+        auto& undecoded = std::get<Token::Info::UndecodedInt>(token.getInfo()->numInfo().value);
+        CHECK(exactlyEqual(SVInt(undecoded.storage), expected));
+        CHECK(exactlyEqual(token.intValue(), expected));
+    }
+
+    // Problems with the digits are still reported up front.
+    parseVector("4'hFFF", true);
+    REQUIRE(diagnostics.size() == 1);
+    CHECK(diagnostics[0].code == DiagCode::VectorLiteralOverflow);
+
+    // Truncating away the unknown digits leaves a value that needs fewer words.
+    Token truncated = parseVector("4'bx1010", true);
+    REQUIRE(diagnostics.size() == 1);
+    CHECK(diagnostics[0].code == DiagCode::VectorLiteralOverflow);
+    CHECK(exactlyEqual(truncated.intValue(), SVInt(4, 10, false)));
+    CHECK(exactlyEqual(truncated.intValue(), SVInt(4, 10, false)));
+
+    Token token = parseVector("8'b1012", true);
+    REQUIRE(diagnostics.size() == 1);
+    CHECK(diagnostics[0].code == DiagCode::BadBinaryDigit);
+    CHECK(token.intValue() == 0);
+}
+
 TEST_CASE("Real literal expression") {
     auto& text = "42.42";
     auto& expr = parseExpression(text);
@@ -376,6 +433,32 @@ TEST_CASE("Conditional expression (pattern matching)") {
           SyntaxKind::ExpressionPattern);
 }
 
+TEST_CASE("Long conditional expression chain") {
+    // Chains of conditional operators nest to the right, but shouldn't
+    // count against the parser's recursion limit.
+    std::string text = "a";
+    for (int i = 0; i < 5000; i++)
+        text += " ? b" + std::to_string(i) + " : c" + std::to_string(i) + " == d";
+
+    auto& expr = parseExpression(text);
+    CHECK(expr.toString() == text);
+    CHECK_DIAGNOSTICS_EMPTY;
+
+    int depth = 0;
+    int simpleLefts = 0;
+    const ExpressionSyntax* current = &expr;
+    while (current->kind == SyntaxKind::ConditionalExpression) {
+        auto& cond = current->as<ConditionalExpressionSyntax>();
+        if (cond.left->kind == SyntaxKind::IdentifierName)
+            simpleLefts++;
+        current = cond.right;
+        depth++;
+    }
+    CHECK(depth == 5000);
+    CHECK(simpleLefts == 5000);
+    CHECK(current->kind == SyntaxKind::EqualityExpression);
+}
+
 TEST_CASE("Big expression") {
     auto& text = R"(
 module M; localparam foo = (stackDepth == 100) || ((stackDepth == 200) || ((stackDepth ==
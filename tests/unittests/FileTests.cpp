@@ -1,4 +1,9 @@
 #include "Test.h"
+#include <fstream>
+#include <thread>
+
+#include "slang/syntax/ParallelSyntaxTreeBuilder.h"
+#include "slang/syntax/SyntaxPrinter.h"
 
 std::string getTestInclude() {
     return findTestDir() + "/include.svh";
@@ -68,3 +73,444 @@ TEST_CASE("Read header (include dirs)") {
     buffer = manager.readHeader("../infinite_chain.svh", SourceLocation(buffer.id, 0), false);
     CHECK(buffer);
 }
+
+TEST_CASE("Include resolution cache") {
+    SourceManager manager;
+    for (auto dir : { "/nested", "/system", "" }) {
+        manager.addUserDirectory(
+            string_view(manager.makeAbsolutePath(string_view(findTestDir() + dir))));
+    }
+
+    // first lookup has to probe every directory until it finds the file
+    SourceBuffer buffer1 = manager.readHeader("include.svh", SourceLocation(), false);
+    REQUIRE(buffer1);
+    CHECK(manager.getStats().includeCacheMisses == 1);
+    CHECK(manager.getStats().includeCacheHits == 0);
+
+    // the second one is answered from the cache but still gets a new buffer
+    SourceBuffer buffer2 = manager.readHeader("include.svh", SourceLocation(), false);
+    REQUIRE(buffer2);
+    CHECK(buffer2.id != buffer1.id);
+    CHECK(buffer2.data.data() == buffer1.data.data());
+    CHECK(manager.getStats().includeCacheHits == 1);
+    CHECK(manager.getStats().probesSaved == 3);
+
+    // misses are remembered as well
+    CHECK(!manager.readHeader("missing.svh", SourceLocation(), false));
+    CHECK(!manager.readHeader("missing.svh", SourceLocation(), false));
+    CHECK(manager.getStats().includeCacheMisses == 2);
+    CHECK(manager.getStats().includeCacheHits == 2);
+    CHECK(manager.getStats().probesSaved == 6);
+
+    // system lookups and lookups from a different directory are cached separately
+    CHECK(!manager.readHeader("include.svh", SourceLocation(), true));
+    CHECK(manager.readHeader("include.svh", SourceLocation(buffer1.id, 0), false));
+    CHECK(manager.getStats().includeCacheMisses == 4);
+
+    // adding a directory throws away the cache
+    manager.addSystemDirectory(string_view(manager.makeAbsolutePath(string_view(findTestDir()))));
+    CHECK(manager.readHeader("include.svh", SourceLocation(), true));
+    CHECK(manager.readHeader("include.svh", SourceLocation(), false));
+    CHECK(manager.getStats().includeCacheMisses == 6);
+    CHECK(manager.getStats().includeCacheHits == 2);
+}
+
+TEST_CASE("Read source (memory mapped)") {
+    SourceManager manager;
+    manager.setMemoryMapping(true);
+    CHECK(manager.isMemoryMapping());
+
+    std::string testPath = manager.makeAbsolutePath(string_view(getTestInclude()));
+    CHECK(!manager.readSource("X:\\nonsense.txt"));
+
+    auto file = manager.readSource(string_view(testPath));
+    REQUIRE(file);
+    REQUIRE(file.data.length() > 0);
+    CHECK(file.data.back() == '\0');
+
+    // contents should match what we get from a normal read
+    SourceManager other;
+    auto expected = other.readSource(string_view(testPath));
+    REQUIRE(expected);
+    CHECK(file.data == expected.data);
+
+    // including it again should hand back the same mapped data
+    auto header = manager.readHeader(string_view(testPath), SourceLocation(), false);
+    REQUIRE(header);
+    CHECK(header.data.data() == file.data.data());
+
+    CHECK(manager.getLineNumber(SourceLocation(file.id, 0)) == 1);
+}
+
+TEST_CASE("Concurrent source manager access") {
+    SourceManager manager;
+    std::string testPath = manager.makeAbsolutePath(string_view(getTestInclude()));
+
+    constexpr int NumThreads = 8;
+    constexpr int NumIterations = 500;
+
+    std::vector<std::thread> threads;
+    std::vector<std::vector<SourceLocation>> results(NumThreads);
+    std::vector<std::vector<uint32_t>> lineNumbers(NumThreads);
+    for (int i = 0; i < NumThreads; i++) {
+        threads.emplace_back([&, i] {
+            for (int j = 0; j < NumIterations; j++) {
+                auto file = manager.readSource(string_view(testPath));
+                auto text = manager.assignText("foo\nbar\n");
+                auto loc = manager.createExpansionLoc(SourceLocation(text.id, 4),
+                                                      SourceLocation(file.id, 0),
+                                                      SourceLocation(file.id, 1), "FOO"sv);
+                results[i].push_back(loc);
+                lineNumbers[i].push_back(manager.getLineNumber(loc));
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    for (auto& lines : lineNumbers)
+        CHECK(std::all_of(lines.begin(), lines.end(), [](uint32_t line) { return line == 1; }));
+
+    // every expansion should have gotten a unique buffer and be fully queryable
+    std::set<BufferID> seen;
+    for (auto& locs : results) {
+        for (auto loc : locs) {
+            CHECK(seen.insert(loc.buffer()).second);
+            CHECK(manager.getMacroName(loc) == "FOO");
+            CHECK(manager.getLineNumber(manager.getOriginalLoc(loc)) == 2);
+        }
+    }
+    CHECK(seen.size() == NumThreads * NumIterations);
+}
+
+TEST_CASE("Parallel syntax tree builder") {
+    SourceManager manager;
+    std::string testPath = manager.makeAbsolutePath(string_view(getTestInclude()));
+
+    constexpr int NumBuffers = 64;
+
+    ParallelSyntaxTreeBuilder builder(manager, {}, 4);
+    std::vector<std::string> names;
+    for (int i = 0; i < NumBuffers; i++) {
+        if (i % 8 == 0) {
+            builder.addFile(testPath);
+            names.push_back(testPath);
+        }
+        else {
+            std::string name = "module m" + std::to_string(i) + ";";
+            builder.addBuffer(manager.assignText(name + " endmodule"));
+            names.push_back(name);
+        }
+    }
+    builder.addFile("X:\\nonsense.txt");
+
+    auto trees = builder.build();
+    REQUIRE(trees.size() == NumBuffers + 1);
+    CHECK(!trees.back());
+
+    // trees must come back in the order they were added
+    for (int i = 0; i < NumBuffers; i++) {
+        REQUIRE(trees[i]);
+        if (i % 8 == 0) {
+            auto name = manager.getRawFileName(trees[i]->getEOFToken().location().buffer());
+            CHECK(name.substr(name.size() - 11) == "include.svh");
+        }
+        else {
+            std::string text = SyntaxPrinter::printFile(*trees[i]);
+            CHECK(text.substr(0, names[i].size()) == names[i]);
+            CHECK(trees[i]->diagnostics().empty());
+        }
+    }
+}
+
+TEST_CASE("Line numbers with mixed line endings") {
+    // Build text with every kind of line ending at lots of different alignments,
+    // so that some pairs straddle the blocks used by the vectorized scanner.
+    std::string text;
+    const char* endings[] = { "\n", "\r", "\r\n", "\n\r", "\n\n", "\r\r" };
+    for (int i = 0; i < 200; i++) {
+        text.append(size_t(i % 37), 'a');
+        text += endings[i % 6];
+    }
+
+    SourceManager manager;
+    auto buffer = manager.assignText(text);
+
+    uint32_t expected = 1;
+    for (size_t i = 0; i < text.size(); i++) {
+        CHECK(manager.getLineNumber(SourceLocation(buffer.id, i)) == expected);
+        if (text[i] == '\n' || text[i] == '\r') {
+            char next = i + 1 < text.size() ? text[i + 1] : '\0';
+            if ((next == '\n' || next == '\r') && next != text[i]) {
+                i++;
+                CHECK(manager.getLineNumber(SourceLocation(buffer.id, i)) == expected);
+            }
+            expected++;
+        }
+    }
+}
+
+TEST_CASE("Eager line tables") {
+    SourceManager manager;
+    manager.setEagerLineTables(true);
+    CHECK(manager.isEagerLineTables());
+
+    std::string testPath = manager.makeAbsolutePath(string_view(getTestInclude()));
+    auto file = manager.readSource(string_view(testPath));
+    REQUIRE(file);
+
+    SourceManager lazyManager;
+    auto lazyFile = lazyManager.readSource(string_view(testPath));
+    REQUIRE(lazyFile);
+
+    for (size_t i = 0; i < file.data.size(); i++) {
+        CHECK(manager.getLineNumber(SourceLocation(file.id, i)) ==
+              lazyManager.getLineNumber(SourceLocation(lazyFile.id, i)));
+    }
+
+    manager.setEagerLineTables(false);
+    CHECK(!manager.isEagerLineTables());
+}
+
+TEST_CASE("Duplicate file contents are shared") {
+    auto dir = fs::temp_directory_path() / "slang_dedup_test";
+    fs::create_directories(dir / "a");
+    fs::create_directories(dir / "b");
+    fs::copy_file(getTestInclude(), dir / "a/foo.svh", fs::copy_options::overwrite_existing);
+    fs::copy_file(getTestInclude(), dir / "b/bar.svh", fs::copy_options::overwrite_existing);
+
+    SourceManager manager;
+    auto file1 = manager.readSource((dir / "a/foo.svh").string());
+    auto file2 = manager.readSource((dir / "b/bar.svh").string());
+    auto file3 = manager.readSource(getTestInclude());
+    REQUIRE(file1);
+    REQUIRE(file2);
+    REQUIRE(file3);
+
+    // all three are the same text, but they're still different files
+    CHECK(file1.data.data() == file2.data.data());
+    CHECK(file1.data.data() == file3.data.data());
+    CHECK(manager.getRawFileName(file1.id) != manager.getRawFileName(file2.id));
+    CHECK(manager.getLineNumber(SourceLocation(file2.id, file2.data.size() - 1)) ==
+          manager.getLineNumber(SourceLocation(file3.id, file3.data.size() - 1)));
+
+    auto stats = manager.getStats();
+    CHECK(stats.duplicateFiles == 2);
+    CHECK(stats.duplicateBytesSaved == 2 * file1.data.size());
+
+    // relative includes still resolve against each file's own directory
+    fs::copy_file(findTestDir() + "/local.svh", dir / "b/local.svh",
+                  fs::copy_options::overwrite_existing);
+    CHECK(!manager.readHeader("local.svh", SourceLocation(file1.id, 0), false));
+    CHECK(manager.readHeader("local.svh", SourceLocation(file2.id, 0), false));
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("Expansion location encoding") {
+    SourceManager manager;
+    auto file1 = manager.assignText("`define FOO(a) a + 1\n`FOO(2)\n");
+    auto file2 = manager.assignText("other text");
+
+    SourceLocation start(file1.id, 21);
+    SourceLocation end(file1.id, 28);
+    SourceLocation farEnd(file2.id, 3);
+
+    std::string name = "FOO";
+    auto loc1 = manager.createExpansionLoc(SourceLocation(file1.id, 15), start, end, name);
+    auto loc2 = manager.createExpansionLoc(SourceLocation(file1.id, 15), start, farEnd, "FOO"sv);
+    auto loc3 = manager.createExpansionLoc(SourceLocation(file1.id, 26), SourceLocation(file1.id, 15),
+                                           SourceLocation(file1.id, 16), true);
+
+    CHECK(manager.getExpansionRange(loc1).start() == start);
+    CHECK(manager.getExpansionRange(loc1).end() == end);
+    CHECK(manager.getExpansionRange(loc2).end() == farEnd);
+    CHECK(manager.getExpansionRange(loc3).end() == SourceLocation(file1.id, 16));
+
+    // macro names are copied and shared between expansions
+    name = "BAR";
+    CHECK(manager.getMacroName(loc1) == "FOO");
+    CHECK(manager.getMacroName(loc1).data() == manager.getMacroName(loc2).data());
+    CHECK(manager.getMacroName(loc3 + 0) == "");
+
+    CHECK(manager.isMacroArgLoc(loc3));
+    CHECK(!manager.isMacroArgLoc(loc1));
+    CHECK(manager.getOriginalLoc(loc1 + 2) == SourceLocation(file1.id, 17));
+    CHECK(manager.getExpansionLoc(loc2) == start);
+}
+
+static void dumpTokens(const SyntaxNode& node, const SourceManager& sm, std::string& out) {
+    for (uint32_t i = 0; i < node.getChildCount(); i++) {
+        if (auto child = node.childNode(i))
+            dumpTokens(*child, sm, out);
+        else if (auto token = node.childToken(i)) {
+            auto loc = sm.getFullyExpandedLoc(token.location());
+            out += " " + std::to_string(int(token.kind)) + ":" + std::string(token.rawText()) +
+                   "@" + std::string(sm.getRawFileName(loc.buffer())) + ":" +
+                   std::to_string(loc.offset());
+            switch (token.kind) {
+                case TokenKind::IntegerLiteral:
+                    out += "=" + token.intValue().toString();
+                    break;
+                case TokenKind::RealLiteral:
+                case TokenKind::TimeLiteral:
+                    out += "=" + std::to_string(token.realValue()) + "/" +
+                           std::to_string(token.numericFlags().raw);
+                    break;
+                case TokenKind::IntegerBase:
+                    out += "/" + std::to_string(token.numericFlags().raw);
+                    break;
+                case TokenKind::StringLiteral:
+                    out += "=" + std::string(token.valueText());
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+TEST_CASE("Syntax tree cache files") {
+    auto dir = fs::temp_directory_path() / "slang_cache_test";
+    fs::create_directories(dir);
+    auto header = (dir / "defs.svh").string();
+    auto cachePath = (dir / "tree.cache").string();
+    fs::remove(cachePath);
+
+    auto writeFile = [](const std::string& path, const std::string& text) {
+        std::ofstream stream(path, std::ios::trunc);
+        stream << text;
+    };
+    writeFile(header, "`define WIDTH 8\n`define ADD(a, b) a + b\n");
+
+    std::string text = "`include \"" + header + "\"\n" + R"(
+module m #(parameter int P = 'hx3)(input logic [`WIDTH-1:0] a);
+    localparam real R = 1.5e3;
+    localparam string S = "hello\tworld";
+    initial $display("%d", `ADD(a, 32'd5) + 100000000000000000000);
+    time t = 10ns;
+    assign b = ;
+endmodule
+)";
+
+    auto check = [&](const std::shared_ptr<SyntaxTree>& tree, SourceManager& sm,
+                     const std::shared_ptr<SyntaxTree>& expected) {
+        std::string actualTokens, expectedTokens;
+        dumpTokens(tree->root(), sm, actualTokens);
+        dumpTokens(expected->root(), expected->sourceManager(), expectedTokens);
+        CHECK(actualTokens == expectedTokens);
+        CHECK(tree->root().toString() == expected->root().toString());
+        CHECK(tree->getEOFToken().rawText() == expected->getEOFToken().rawText());
+
+        CHECK(DiagnosticWriter(sm).report(tree->diagnostics()) ==
+              DiagnosticWriter(expected->sourceManager()).report(expected->diagnostics()));
+    };
+
+    SourceManager sm1;
+    auto buffer1 = sm1.assignText("source.sv", text);
+    auto tree1 = SyntaxTree::fromCache(cachePath, buffer1, sm1);
+    CHECK(!tree1->isFromCache());
+    CHECK(!tree1->diagnostics().empty());
+    REQUIRE(fs::exists(cachePath));
+
+    // A fresh source manager, as a new run of a tool would have.
+    SourceManager sm2;
+    auto buffer2 = sm2.assignText("source.sv", text);
+    auto tree2 = SyntaxTree::fromCache(cachePath, buffer2, sm2);
+    CHECK(tree2->isFromCache());
+    check(tree2, sm2, tree1);
+
+    // Different options or text mean a different key.
+    Bag options;
+    PreprocessorOptions ppOptions;
+    ppOptions.predefines.push_back("FOO");
+    options.add(ppOptions);
+    CHECK(SyntaxTree::getCacheKey(buffer2) != SyntaxTree::getCacheKey(buffer2, options));
+    CHECK(!SyntaxTree::fromCache(cachePath, buffer2, sm2, options)->isFromCache());
+    CHECK(SyntaxTree::fromCache(cachePath, buffer2, sm2, options)->isFromCache());
+    CHECK(!SyntaxTree::fromCache(cachePath, buffer2, sm2)->isFromCache());
+
+    // Changing an included file means parsing again.
+    writeFile(header, "`define WIDTH 16\n`define ADD(a, b) a - b\n");
+    SourceManager sm3;
+    auto tree3 = SyntaxTree::fromCache(cachePath, sm3.assignText("source.sv", text), sm3);
+    CHECK(!tree3->isFromCache());
+    CHECK(tree3->root().toString().find("16") != std::string::npos);
+
+    // Corrupt files get replaced.
+    for (size_t size : { size_t(0), size_t(20), size_t(60), fs::file_size(cachePath) - 3 }) {
+        fs::resize_file(cachePath, size);
+        SourceManager sm4;
+        auto tree4 = SyntaxTree::fromCache(cachePath, sm4.assignText("source.sv", text), sm4);
+        CHECK(!tree4->isFromCache());
+        check(tree4, sm4, tree3);
+    }
+
+    // Failed includes don't get cached, since the file might show up later.
+    SourceManager sm5;
+    CHECK(!SyntaxTree::fromText("`include \"nonexistent.svh\"", sm5)->writeCache(cachePath));
+
+    // Edited trees can have members located in the buffer they were edited from,
+    // which get loaded back into the main buffer.
+    std::string oldText = "module a; logic x; endmodule\nmodule b; logic y; endmodule\n";
+    std::string newText = oldText;
+    newText.replace(newText.find('y'), 1, "z");
+
+    SourceManager sm6;
+    auto original = SyntaxTree::fromBuffer(sm6.assignText("source.sv", oldText), sm6);
+    std::vector<TextEdit> edits = { { (uint32_t)oldText.find('y'), 1, "z" } };
+    auto edited = SyntaxTree::fromEdits(original, edits);
+    REQUIRE(edited->writeCache(cachePath));
+
+    SourceManager sm7;
+    auto loaded = SyntaxTree::fromCache(cachePath, sm7.assignText("source.sv", newText), sm7);
+    CHECK(loaded->isFromCache());
+    check(loaded, sm7, edited);
+    CHECK(loaded->root().getFirstToken().location().buffer() ==
+          loaded->getEOFToken().location().buffer());
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("Syntax tree cache files (include directories)") {
+    auto dir = fs::temp_directory_path() / "slang_cache_include_test";
+    for (auto sub : { "a", "b" })
+        fs::create_directories(dir / sub);
+    auto cachePath = (dir / "tree.cache").string();
+    fs::remove(cachePath);
+
+    auto writeFile = [](const fs::path& path, const std::string& text) {
+        std::ofstream stream(path, std::ios::trunc);
+        stream << text;
+    };
+    writeFile(dir / "a" / "defs.svh", "`define WIDTH 8\n");
+    writeFile(dir / "b" / "defs.svh", "`define WIDTH 16\n");
+
+    std::string text = "`include \"defs.svh\"\nmodule m; logic [`WIDTH-1:0] a; endmodule\n";
+    auto load = [&](const char* includeDir) {
+        SourceManager sm;
+        sm.addUserDirectory((dir / includeDir).string());
+        auto tree = SyntaxTree::fromCache(cachePath, sm.assignText("source.sv", text), sm);
+        bool fromCache = tree->isFromCache();
+        bool wide = tree->root().toString().find("16") != std::string::npos;
+        return std::make_pair(fromCache, wide);
+    };
+
+    CHECK(load("a") == std::make_pair(false, false));
+    CHECK(load("a") == std::make_pair(true, false));
+
+    // The same include now finds a different file, so the cache can't be used.
+    CHECK(load("b") == std::make_pair(false, true));
+    CHECK(load("b") == std::make_pair(true, true));
+
+    // Adding a directory that comes first in the search order does the same.
+    SourceManager sm;
+    sm.addUserDirectory((dir / "a").string());
+    sm.addUserDirectory((dir / "b").string());
+    auto tree = SyntaxTree::fromCache(cachePath, sm.assignText("source.sv", text), sm);
+    CHECK(!tree->isFromCache());
+    CHECK(tree->root().toString().find("16") == std::string::npos);
+
+    fs::remove_all(dir);
+}
@@ -729,4 +729,64 @@ endmodule
 
     auto& asdf = compilation.getRoot().lookupName<GenerateBlockSymbol>("test.m.asdf");
     CHECK(asdf.isInstantiated);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Compiling skimmed bodies") {
+    auto& text = R"(
+module Top;
+    Leaf #(.W(3)) l1();
+    Mid m();
+endmodule
+
+module Mid;
+    Leaf l2();
+    function int f(int a);
+        return a + 1;
+    endfunction
+    localparam int P = f(2);
+endmodule
+
+module Leaf #(parameter int W = 1);
+    logic [W-1:0] v;
+endmodule
+
+module Unused #(parameter int X);
+    OnlyInUnused #(X) u();
+endmodule
+
+module OnlyInUnused #(parameter int Y = 0);
+endmodule
+)";
+
+    ParserOptions options;
+    options.skimBodies = true;
+
+    Bag bag;
+    bag.add(options);
+
+    auto tree = SyntaxTree::fromText(text, SyntaxTree::getDefaultSourceManager(), "source", bag);
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+
+    const RootSymbol& root = compilation.getRoot();
+    REQUIRE(root.topInstances.size() == 1);
+    CHECK(root.topInstances[0]->name == "Top");
+
+    // Bodies are parsed once the definitions get instantiated, and not before.
+    auto unused = compilation.getDefinition("Unused");
+    auto mid = compilation.getDefinition("Mid");
+    REQUIRE(unused);
+    REQUIRE(mid);
+    CHECK(unused->hasSkimmedBody());
+    CHECK(unused->getSyntax()->isSkimmed());
+    CHECK(mid->getSyntax()->isSkimmed());
+
+    auto& p = root.lookupName<ParameterSymbol>("Top.m.P");
+    CHECK(p.getValue().integer() == 3);
+    CHECK(!mid->getSyntax()->isSkimmed());
+    CHECK(unused->getSyntax()->isSkimmed());
+
+    NO_COMPILATION_ERRORS;
+    CHECK(!unused->hasSkimmedBody());
+    CHECK(unused->getParameters().size() == 1);
+}
@@ -135,6 +135,37 @@ TEST_CASE("Block comment (embedded null)") {
     CHECK(diagnostics.back().code == DiagCode::EmbeddedNull);
 }
 
+TEST_CASE("Long trivia runs") {
+    // Exercise the vectorized trivia scanning with runs that
+    // end at every position within and across strides.
+    for (size_t len = 0; len < 80; len++) {
+        std::string pad(len, 'x');
+        std::string spaces(len, len % 2 ? ' ' : '\t');
+
+        std::string text = spaces + "//" + pad + '\0' + pad + "\n" + spaces + "/*" + pad + "*" +
+                           '\0' + pad + "/* */" + spaces + "foo";
+        Token token = lexToken(string_view(text));
+
+        CHECK(token.kind == TokenKind::Identifier);
+        CHECK(token.toString() == text);
+        CHECK(token.trivia().size() == (len ? 6 : 3));
+
+        REQUIRE(diagnostics.size() == 3);
+        CHECK(diagnostics[0].code == DiagCode::EmbeddedNull);
+        CHECK(diagnostics[0].location.offset() == len * 2 + 2);
+        CHECK(diagnostics[1].code == DiagCode::EmbeddedNull);
+        CHECK(diagnostics[1].location.offset() == len * 5 + 7);
+        CHECK(diagnostics[2].code == DiagCode::NestedBlockComment);
+    }
+
+    std::string text = "/*" + std::string(100, '*');
+    Token token = lexToken(string_view(text));
+    CHECK(token.kind == TokenKind::EndOfFile);
+    CHECK(token.toString() == text);
+    REQUIRE(diagnostics.size() == 1);
+    CHECK(diagnostics[0].code == DiagCode::UnterminatedBlockComment);
+}
+
 TEST_CASE("Block Comment (nested)") {
     auto& text = "/* comment /* stuff */";
     Token token = lexToken(text);
@@ -216,6 +247,30 @@ TEST_CASE("Mixed Identifiers") {
     CHECK_DIAGNOSTICS_EMPTY;
 }
 
+TEST_CASE("Long Identifiers") {
+    // Identifier runs that end at every position within and across strides,
+    // stopped by characters on either side of the identifier ranges.
+    std::string chars = "abcxyzABCXYZ0189_$";
+    for (size_t len = 1; len < 80; len++) {
+        std::string name;
+        for (size_t i = 0; i < len; i++)
+            name += chars[(i * 7) % chars.size()];
+        if ((name[0] >= '0' && name[0] <= '9') || name[0] == '$')
+            name[0] = 'n';
+
+        for (char stop : { '@', '[', '`', '{', '/', ':', '\x80', ' ' }) {
+            std::string text = name + stop;
+            auto buffer = getSourceManager().assignText(string_view(text));
+            diagnostics.clear();
+            Lexer lexer(buffer, alloc, diagnostics);
+
+            Token token = lexer.lex();
+            CHECK(token.kind == TokenKind::Identifier);
+            CHECK(token.valueText() == name);
+        }
+    }
+}
+
 TEST_CASE("Escaped Identifiers") {
     auto& text = "\\98\\#$%)(*lkjsd__09...asdf345";
     Token token = lexToken(text);
@@ -1026,4 +1081,23 @@ TEST_CASE("Punctuation corner cases") {
     token = lexToken("|-");
     CHECK(token.kind == TokenKind::Or);
     CHECK_DIAGNOSTICS_EMPTY;
-}
\ No newline at end of file
+}
+TEST_CASE("Keyword tables") {
+    // Every keyword added by a version should be recognized there and in
+    // all later versions, but not before.
+    CHECK(getKeywordKind("ifnone", KeywordVersion::v1364_1995) == TokenKind::IfNoneKeyword);
+    CHECK(getKeywordKind("ifnone", KeywordVersion::v1800_2017) == TokenKind::IfNoneKeyword);
+    CHECK(getKeywordKind("generate", KeywordVersion::v1364_1995) == TokenKind::Unknown);
+    CHECK(getKeywordKind("generate", KeywordVersion::v1364_2001_noconfig) ==
+          TokenKind::GenerateKeyword);
+    CHECK(getKeywordKind("config", KeywordVersion::v1364_2001_noconfig) == TokenKind::Unknown);
+    CHECK(getKeywordKind("config", KeywordVersion::v1364_2001) == TokenKind::ConfigKeyword);
+    CHECK(getKeywordKind("soft", KeywordVersion::v1800_2009) == TokenKind::Unknown);
+    CHECK(getKeywordKind("soft", KeywordVersion::v1800_2012) == TokenKind::SoftKeyword);
+    CHECK(getKeywordKind("soft", KeywordVersion::v1800_2017) == TokenKind::SoftKeyword);
+
+    // Near misses must not match.
+    CHECK(getKeywordKind("modul", KeywordVersion::v1800_2017) == TokenKind::Unknown);
+    CHECK(getKeywordKind("modules", KeywordVersion::v1800_2017) == TokenKind::Unknown);
+    CHECK(getKeywordKind("", KeywordVersion::v1800_2017) == TokenKind::Unknown);
+}
@@ -144,4 +144,358 @@ a1: assert property (@(posedge clk) a |-> p3);
     REQUIRE(coverStatement);
     REQUIRE(assertStatement);
     CHECK_DIAGNOSTICS_EMPTY;
-}
\ No newline at end of file
+}
+
+static Bag skimOptions() {
+    ParserOptions options;
+    options.skimBodies = true;
+
+    Bag bag;
+    bag.add(options);
+    return bag;
+}
+
+// Writes out the shape of a tree: the kind of every node and the text of every token.
+static void dumpTree(const SyntaxNode& node, std::string& out) {
+    out += "(" + std::to_string(int(node.kind));
+    for (uint32_t i = 0; i < node.getChildCount(); i++) {
+        if (auto child = node.childNode(i))
+            dumpTree(*child, out);
+        else if (auto token = node.childToken(i))
+            out += " " + std::string(token.rawText());
+    }
+    out += ")";
+}
+
+static std::string dumpTree(const SyntaxNode& node) {
+    std::string result;
+    dumpTree(node, result);
+    return result;
+}
+
+TEST_CASE("Skimmed bodies") {
+    auto& text = R"(
+module top #(parameter int W = 4) (input logic clk, output logic [W-1:0] q);
+    typedef class fwd;
+    virtual interface bus_if vif;
+    logic [W-1:0] r;
+    always_ff @(posedge clk) begin
+        case (r)
+            0: r <= 1;
+            default: r <= r + 1;
+        endcase
+    end
+    assign q = {r[W-1:1], r[0]};
+    logic [W-1:0] mem [2];
+    assign mem = '{default: 0};
+    generate
+        if (W > 2) begin : g
+            sub #(.W(W)) u(.clk(clk));
+        end
+    endgenerate
+    module nested; endmodule
+    function automatic int f(int x);
+        begin
+            return x + 1;
+        end
+    endfunction
+    task t;
+        fork
+            #1 r = 0;
+        join_none
+        wait fork;
+    endtask
+endmodule
+
+interface bus_if(input clk);
+    logic valid;
+    modport mp(input valid);
+endinterface
+
+function int g(int a);
+    case (a)
+        1: return 2;
+    endcase
+    return a;
+endfunction
+
+module sub #(parameter int W = 1) (input clk);
+endmodule : sub
+)";
+
+    auto& sourceManager = getSourceManager();
+    auto full = SyntaxTree::fromBuffer(sourceManager.assignText(text), sourceManager);
+    auto tree =
+        SyntaxTree::fromBuffer(sourceManager.assignText(text), sourceManager, skimOptions());
+
+    auto& fullUnit = full->root().as<CompilationUnitSyntax>();
+    auto& unit = tree->root().as<CompilationUnitSyntax>();
+    REQUIRE(unit.members.size() == 4);
+    for (auto member : unit.members)
+        CHECK(member->isSkimmed());
+
+    auto& top = unit.members[0]->as<ModuleDeclarationSyntax>();
+    CHECK(top.header->name.valueText() == "top");
+    CHECK(top.endmodule.kind == TokenKind::EndModuleKeyword);
+    CHECK(unit.members[3]->as<ModuleDeclarationSyntax>().blockName);
+
+    // Getting at the children of a node parses its body, and only its body.
+    CHECK(dumpTree(top) == dumpTree(*fullUnit.members[0]));
+    CHECK(!top.isSkimmed());
+    CHECK(top.members.size() == 11);
+    CHECK(top.members[0]->parent == &top);
+    CHECK(unit.members[1]->isSkimmed());
+
+    CHECK(dumpTree(unit) == dumpTree(fullUnit));
+    CHECK(unit.toString() == fullUnit.toString());
+    for (auto member : unit.members)
+        CHECK(!member->isSkimmed());
+
+    CHECK(tree->diagnostics().empty());
+    CHECK(full->diagnostics().empty());
+}
+
+TEST_CASE("Skimmed bodies with errors") {
+    auto& text = R"(
+module a;
+    logic x
+    assign x = 1;
+endmodule
+
+module b;
+    initial begin
+        x = 1;
+endmodule
+
+function int f();
+    return 1
+endfunction
+
+module c;
+    generate
+        logic y;
+endmodule
+)";
+
+    auto& sourceManager = getSourceManager();
+    auto full = SyntaxTree::fromBuffer(sourceManager.assignText(text), sourceManager);
+    auto tree =
+        SyntaxTree::fromBuffer(sourceManager.assignText(text), sourceManager, skimOptions());
+
+    // Bodies that aren't balanced get parsed up front, since we can't be
+    // sure where they end without parsing them.
+    auto& unit = tree->root().as<CompilationUnitSyntax>();
+    REQUIRE(unit.members.size() == 4);
+    CHECK(unit.members[0]->isSkimmed());
+    CHECK(!unit.members[1]->isSkimmed());
+    CHECK(unit.members[2]->isSkimmed());
+    CHECK(!unit.members[3]->isSkimmed());
+
+    // Errors in skimmed bodies aren't found until they're parsed.
+    size_t diagsBefore = tree->diagnostics().size();
+    CHECK(diagsBefore < full->diagnostics().size());
+
+    tree->parseSkimmedBodies();
+    CHECK(dumpTree(unit) == dumpTree(full->root()));
+    CHECK(unit.toString() == full->root().toString());
+
+    auto diagString = [&](Diagnostics& diags) {
+        diags.sort(sourceManager);
+        std::string result;
+        for (auto& diag : diags)
+            result += std::to_string(int(diag.code)) + "@" +
+                      std::to_string(diag.location.offset()) + " ";
+        return result;
+    };
+    CHECK(diagString(tree->diagnostics()) == diagString(full->diagnostics()));
+}
+
+// Writes out every token of a tree, with its location and whether its parent is set right,
+// its text is found at its location, and its location comes after the one before it.
+// Members shared with another tree can have that tree's root as their parent.
+static void dumpLocations(const SyntaxNode& node, const SyntaxNode* sharedRoot,
+                          SourceLocation& last, std::string& out) {
+    auto& sourceManager = getSourceManager();
+    for (uint32_t i = 0; i < node.getChildCount(); i++) {
+        if (auto child = node.childNode(i)) {
+            if (!SyntaxListBase::isKind(child->kind) && child->parent != &node &&
+                child->parent != node.parent && child->parent != sharedRoot) {
+                out += " <bad parent>";
+            }
+            dumpLocations(*child, sharedRoot, last, out);
+        }
+        else if (auto token = node.childToken(i)) {
+            SourceLocation loc = token.location();
+            out += " " + std::string(token.rawText()) + "@" + std::to_string(loc.offset());
+
+            string_view text = sourceManager.getSourceText(loc.buffer());
+            if (text.substr(loc.offset(), token.rawText().size()) != token.rawText())
+                out += "<wrong text>";
+            if (loc < last)
+                out += "<out of order>";
+            last = loc;
+        }
+    }
+}
+
+// Checks that applying the edits to the tree gives the same tree as parsing the edited
+// text from scratch, and returns the new tree.
+static std::shared_ptr<SyntaxTree> checkEdits(const std::shared_ptr<SyntaxTree>& tree,
+                                              const std::vector<TextEdit>& edits) {
+    auto& sourceManager = getSourceManager();
+    auto edited = SyntaxTree::fromEdits(tree, edits);
+
+    std::string newText(
+        sourceManager.getSourceText(tree->getEOFToken().location().buffer()).data());
+    for (auto it = edits.rbegin(); it != edits.rend(); it++)
+        newText.replace(it->offset, it->length, it->newText);
+    auto full = SyntaxTree::fromBuffer(sourceManager.assignText(newText), sourceManager);
+
+    auto dump = [&](const std::shared_ptr<SyntaxTree>& t) {
+        std::string result;
+        SourceLocation last;
+        dumpLocations(t->root(), &tree->root(), last, result);
+        result += " EOF@" + std::to_string(t->getEOFToken().location().offset());
+        return result;
+    };
+
+    auto diagString = [&](Diagnostics& diags) {
+        diags.sort(sourceManager);
+        std::string result;
+        for (auto& diag : diags)
+            result += std::to_string(int(diag.code)) + "@" +
+                      std::to_string(diag.location.offset()) + " ";
+        return result;
+    };
+
+    CHECK(edited->root().toString() == full->root().toString());
+    CHECK(dumpTree(edited->root()) == dumpTree(full->root()));
+    CHECK(dump(edited) == dump(full));
+    CHECK(diagString(edited->diagnostics()) == diagString(full->diagnostics()));
+    return edited;
+}
+
+// Checks edits to a tree parsed from the text, and returns whether any of it got reused.
+static bool checkEdits(string_view text, const std::vector<TextEdit>& edits) {
+    auto& sourceManager = getSourceManager();
+    auto tree = SyntaxTree::fromBuffer(sourceManager.assignText(text), sourceManager);
+    return checkEdits(tree, edits)->getParentTree() == tree.get();
+}
+
+TEST_CASE("Reparse after edits") {
+    std::string text = R"(module a;
+    logic x;
+    assign x = 1;
+endmodule
+
+module b #(parameter int W = 8) (input logic [W-1:0] d);
+    always_comb begin
+        if (d == 0) $display("zero");
+    end
+endmodule : b
+
+function int f(int i);
+    return i + 1;
+endfunction
+
+module c;
+    logic y
+    assign y = 0;
+endmodule
+)";
+
+    auto at = [&](string_view needle) { return (uint32_t)text.find(needle); };
+
+    // A change inside of one body.
+    CHECK(checkEdits(text, { { at("x = 1"), 5, "x = 32'd12345" } }));
+
+    // Changes in several places, including one that makes a new error
+    // and one that leaves the error in c alone.
+    CHECK(checkEdits(text, { { at("logic x"), 5, "wire" },
+                             { at("i + 1"), 5, "i +" },
+                             { at("assign y"), 0, "// comment\n    " } }));
+
+    // Removing the end of a module makes it swallow what comes after.
+    CHECK(checkEdits(text, { { at("endmodule\n\nmodule b"), 9, "" } }));
+
+    // Adding a label after the end of a module, in what used to be trivia.
+    CHECK(checkEdits(text, { { at("endmodule\n\nmodule b") + 9, 0, " : a" } }));
+
+    // Opening a comment that runs into the next module.
+    CHECK(checkEdits(text, { { at("endfunction"), 0, "/* " } }));
+
+    // Edits at the very start and the very end.
+    CHECK(checkEdits(text,
+                     { { 0, 0, "\n" }, { (uint32_t)text.size(), 0, "module d; endmodule" } }));
+
+    // Splitting a module in two.
+    CHECK(checkEdits(text, { { at("    assign x"), 0, "endmodule\nmodule a2;\n" } }));
+
+    // Anything that involves macros gets reparsed from scratch.
+    CHECK(!checkEdits(text, { { at("1;"), 1, "`FOO" } }));
+    CHECK(!checkEdits("`define FOO 1\nmodule m; endmodule\nmodule n; endmodule\n",
+                      { { 35, 0, " " } }));
+
+    // Harmless directives are fine, as long as they aren't in the part that gets reparsed.
+    string_view withDirective = "`timescale 1ns/1ps\nmodule m; endmodule\nmodule n; endmodule\n";
+    CHECK(checkEdits(withDirective, { { 49, 0, " logic z;" } }));
+    CHECK(!checkEdits(withDirective, { { 29, 0, " logic z;" } }));
+}
+
+TEST_CASE("Reparse after edits shares members before them") {
+    std::string text = R"(module a;
+    logic x;
+endmodule
+
+module b;
+    logic y;
+    assign y = ;
+endmodule
+
+module c;
+    logic z;
+endmodule
+)";
+
+    auto& sourceManager = getSourceManager();
+    auto tree = SyntaxTree::fromBuffer(sourceManager.assignText(text), sourceManager);
+    auto& members = tree->root().as<CompilationUnitSyntax>().members;
+    auto at = [&](string_view needle) { return (uint32_t)text.find(needle); };
+
+    // An edit in c leaves a and b (and the error in b) exactly as they were.
+    auto edited = checkEdits(tree, { { at("z;"), 1, "w" } });
+    auto& editedMembers = edited->root().as<CompilationUnitSyntax>().members;
+    REQUIRE(editedMembers.size() == 3);
+    CHECK(editedMembers[0] == members[0]);
+    CHECK(editedMembers[1] == members[1]);
+    CHECK(editedMembers[2] != members[2]);
+    CHECK(members[0]->parent == &tree->root());
+    CHECK(editedMembers[2]->parent == &edited->root());
+
+    // Editing again in a moves b and c, some of which were shared and some of which
+    // were copied the first time around.
+    auto again = checkEdits(edited, { { at("logic x"), 0, "// moved\n    " } });
+    auto& againMembers = again->root().as<CompilationUnitSyntax>().members;
+    REQUIRE(againMembers.size() == 3);
+    CHECK(againMembers[1] != members[1]);
+
+    // An edit on the same line as the end of a member means that member gets copied,
+    // so that the line its locations point at is the new one.
+    auto sameLine = checkEdits(tree, { { at("endmodule\n\nmodule b") + 9, 0, " : a" } });
+    CHECK(sameLine->root().as<CompilationUnitSyntax>().members[0] != members[0]);
+}
+
+TEST_CASE("Reparse after edits in a large tree") {
+    std::string text;
+    for (int i = 0; i < 2000; i++)
+        text += "module m" + std::to_string(i) + ";\n    logic [7:0] r;\nendmodule\n\n";
+    REQUIRE(text.size() > 64 * 1024);
+
+    // Copying everything after an edit near the start would cost more than
+    // parsing it again, so the whole text gets reparsed instead.
+    auto at = [&](string_view needle) { return (uint32_t)text.find(needle); };
+    CHECK(!checkEdits(text, { { at("m10;"), 1, "n" } }));
+
+    // Near the end, most of the tree is shared and only a little gets copied.
+    CHECK(checkEdits(text, { { at("m1990;"), 1, "n" } }));
+}
@@ -1,6 +1,8 @@
 #include "Test.h"
 
+#include "slang/parsing/ChunkedLexer.h"
 #include "slang/syntax/SyntaxPrinter.h"
+#include "slang/util/ThreadPool.h"
 
 std::string preprocess(string_view text, string_view name = "source") {
     diagnostics.clear();
@@ -1028,4 +1030,434 @@ TEST_CASE("Preprocessor API") {
     CHECK(pp.isDefined("FOO"));
     CHECK(pp.undefine("FOO"));
     CHECK(!pp.isDefined("FOO"));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Include prefetch scanning") {
+    auto& text = "`include \"a.svh\"\n"
+                 "// `include \"comment.svh\"\n"
+                 "/* `include \"block.svh\" */\n"
+                 "string s = \"`include \\\"str.svh\\\"\";\n"
+                 "`include   <sys/b.svh> `include \"c.svh\"\n"
+                 "`include\n\"nextline.svh\"\n"
+                 "`includes \"not.svh\"\n"
+                 "`include `MACRO\n"
+                 "`include \"d.svh";
+
+    SmallVectorSized<IncludePrefetcher::IncludeName, 8> names;
+    IncludePrefetcher::findIncludes(text, names);
+
+    REQUIRE(names.size() == 3);
+    CHECK(names[0].path == "a.svh");
+    CHECK(!names[0].isSystem);
+    CHECK(names[1].path == "sys/b.svh");
+    CHECK(names[1].isSystem);
+    CHECK(names[2].path == "c.svh");
+}
+
+TEST_CASE("Include prefetching") {
+    auto& text = "`include \"file_uses_defn.svh\"\n"
+                 "`include \"nonexistent.svh\"\n"
+                 "`include <system.svh>\n";
+
+    auto run = [&](ThreadPool* pool) {
+        SourceManager sourceManager;
+        sourceManager.addUserDirectory(string_view(findTestDir()));
+        sourceManager.addSystemDirectory(string_view(findTestDir() + "system/"));
+
+        PreprocessorOptions ppOptions;
+        ppOptions.prefetchPool = pool;
+        Bag options;
+        options.add(ppOptions);
+
+        Diagnostics diags;
+        std::string result;
+        {
+            Preprocessor preprocessor(sourceManager, alloc, diags, options);
+            preprocessor.pushSource(sourceManager.assignText("source", text));
+            if (pool)
+                pool->waitForAll();
+
+            while (true) {
+                Token token = preprocessor.next();
+                result += token.toString();
+                if (token.kind == TokenKind::EndOfFile)
+                    break;
+            }
+        }
+
+        CHECK(diags.size() == 1);
+
+        // Prefetching only loads files; it shouldn't use up any buffer IDs.
+        BufferID nextBuffer = sourceManager.assignText("").id;
+        return std::make_tuple(result, sourceManager.getStats(), nextBuffer);
+    };
+
+    ThreadPool pool(2);
+    auto [expected, normalStats, normalNext] = run(nullptr);
+    auto [actual, prefetchStats, prefetchNext] = run(&pool);
+
+    CHECK(actual == expected);
+    CHECK(normalNext == prefetchNext);
+    CHECK(normalStats.includeCacheHits == 0);
+
+    // Every include (including the nested one and the one that doesn't exist)
+    // should have been resolved ahead of time.
+    CHECK(prefetchStats.includeCacheMisses == 4);
+    CHECK(prefetchStats.includeCacheHits == 4);
+}
+
+TEST_CASE("Include guard detection") {
+    CHECK(Preprocessor::findIncludeGuard("// header\n"
+                                         "`ifndef FOO\n"
+                                         "`define FOO\n"
+                                         "`ifdef BAR /* `else */ `else \"`endif\" `endif\n"
+                                         "`define BAZ(a) \\\n"
+                                         "    `endif\n"
+                                         "`endif /* FOO */\n\0"sv) == "FOO");
+
+    CHECK(Preprocessor::findIncludeGuard("`ifndef FOO `define FOO 1\n`endif") == "FOO");
+    CHECK(Preprocessor::findIncludeGuard("`ifndef FOO `define FOO 1 `endif").empty());
+    CHECK(Preprocessor::findIncludeGuard("`ifndef FOO\n`define BAR\n`endif").empty());
+    CHECK(Preprocessor::findIncludeGuard("`ifndef FOO\n`define FOO\n`else\n`endif").empty());
+    CHECK(Preprocessor::findIncludeGuard("`ifndef FOO\n`define FOO\n`endif\nmodule m;").empty());
+    CHECK(Preprocessor::findIncludeGuard("module m;\n`ifndef FOO\n`define FOO\n`endif").empty());
+    CHECK(Preprocessor::findIncludeGuard("`ifndef FOO\n`define FOO(a)\n`endif").empty());
+    CHECK(Preprocessor::findIncludeGuard("`ifndef FOO\n`define FOO\n`ifdef BAR\n`endif").empty());
+    CHECK(Preprocessor::findIncludeGuard("`ifdef FOO\n`define FOO\n`endif").empty());
+}
+
+TEST_CASE("Include guarded file twice") {
+    auto& text = "`include \"guarded.svh\"\n"
+                 "`include \"guarded.svh\"\n"
+                 "`undef GUARDED_SVH\n"
+                 "`include \"guarded.svh\"\n";
+
+    auto run = [&](bool skipGuardedIncludes) {
+        SourceManager sourceManager;
+        sourceManager.addUserDirectory(string_view(findTestDir()));
+
+        PreprocessorOptions ppOptions;
+        ppOptions.skipGuardedIncludes = skipGuardedIncludes;
+        Bag options;
+        options.add(ppOptions);
+
+        Diagnostics diags;
+        Preprocessor preprocessor(sourceManager, alloc, diags, options);
+        preprocessor.pushSource(sourceManager.assignText("source", text));
+
+        std::string result;
+        size_t guardedCount = 0;
+        while (true) {
+            Token token = preprocessor.next();
+            if (token.kind == TokenKind::Identifier && token.valueText() == "guarded")
+                guardedCount++;
+            result += SyntaxPrinter().setIncludeDirectives(true).print(token).str();
+            if (token.kind == TokenKind::EndOfFile)
+                break;
+        }
+
+        CHECK(diags.empty());
+        CHECK(guardedCount == 2);
+        return result;
+    };
+
+    auto countHeaders = [](const std::string& str) {
+        size_t count = 0;
+        for (size_t pos = str.find("`ifndef GUARDED_SVH"); pos != std::string::npos;
+             pos = str.find("`ifndef GUARDED_SVH", pos + 1)) {
+            count++;
+        }
+        return count;
+    };
+
+    // With skipping the second include never gets lexed, so its disabled
+    // text doesn't show up; the third include runs since the guard was undefined.
+    CHECK(countHeaders(run(false)) == 3);
+    CHECK(countHeaders(run(true)) == 2);
+}
+
+TEST_CASE("Inactive region skipped as disabled text") {
+    auto& text = R"(`ifdef UNDEFINED
+  `ifdef NESTED "`else" // `endif
+    x /* `elsif */
+  `else \esc`endif
+  `endif
+  y
+`else
+z
+`endif
+)";
+
+    diagnostics.clear();
+    Preprocessor preprocessor(getSourceManager(), alloc, diagnostics);
+    preprocessor.pushSource(getSourceManager().assignText(text));
+
+    Token token = preprocessor.next();
+    CHECK(token.kind == TokenKind::Identifier);
+    CHECK(token.valueText() == "z");
+    Token eof = preprocessor.next();
+    CHECK(eof.kind == TokenKind::EndOfFile);
+    CHECK_DIAGNOSTICS_EMPTY;
+
+    // The whole first branch, nested conditionals and all, ends up
+    // as a single piece of trivia on the `else directive.
+    REQUIRE(token.trivia().size() == 3);
+    REQUIRE(token.trivia()[1].kind == TriviaKind::Directive);
+    auto elseTrivia = token.trivia()[1].syntax()->getFirstToken().trivia();
+    REQUIRE(elseTrivia.size() == 2);
+    CHECK(elseTrivia[0].kind == TriviaKind::DisabledText);
+    CHECK(elseTrivia[0].getRawText() == "\n  `ifdef NESTED \"`else\" // `endif\n"
+                                        "    x /* `elsif */\n"
+                                        "  `else \\esc`endif\n"
+                                        "  `endif\n"
+                                        "  y");
+    CHECK(elseTrivia[1].kind == TriviaKind::EndOfLine);
+
+    CHECK(SyntaxPrinter().setIncludeDirectives(true).print(token).str() +
+              SyntaxPrinter().setIncludeDirectives(true).print(eof).str() ==
+          text);
+}
+
+TEST_CASE("Inactive region left open by include") {
+    auto& text = "`include \"unterminated_ifdef.svh\"\n"
+                 "bar\n"
+                 "`endif\n"
+                 "baz\n"
+                 "`endif\n"
+                 "qux\n";
+
+    std::string result = preprocess(text);
+    CHECK(result == "// Leaves a conditional open at the end of the file\nqux\n");
+    CHECK_DIAGNOSTICS_EMPTY;
+}
+
+TEST_CASE("Preprocessing with trivia discarded") {
+    auto& text = R"(
+// Leading comment
+`define FOO(a) a + \
+    1 // trailing comment
+`define BAR 8'h /* inline */ 3 // comment ending in a continuation \
+    + 4
+`define STR(x) `"x`"
+
+/* A block comment that
+   spans lines */
+module m;
+    int i = `FOO(2) * `BAR;
+    int j = 8'h 1F;
+    string s = `STR(a   b);
+endmodule
+)";
+
+    auto lexAll = [&](bool discardTrivia) {
+        LexerOptions lexerOptions;
+        lexerOptions.discardTrivia = discardTrivia;
+
+        Bag options;
+        options.add(lexerOptions);
+
+        diagnostics.clear();
+        Preprocessor preprocessor(getSourceManager(), alloc, diagnostics, options);
+        preprocessor.pushSource(getSourceManager().assignText(text));
+
+        std::vector<Token> tokens;
+        while (true) {
+            Token token = preprocessor.next();
+            tokens.push_back(token);
+            if (token.kind == TokenKind::EndOfFile)
+                break;
+        }
+        return tokens;
+    };
+
+    auto expected = lexAll(false);
+    CHECK_DIAGNOSTICS_EMPTY;
+
+    auto actual = lexAll(true);
+    CHECK_DIAGNOSTICS_EMPTY;
+
+    // The same tokens come out, with the same adjacency, except that
+    // whitespace in stringified arguments is collapsed.
+    REQUIRE(actual.size() == expected.size());
+    for (size_t i = 0; i < actual.size(); i++) {
+        CHECK(actual[i].kind == expected[i].kind);
+        CHECK(actual[i].trivia().empty() == expected[i].trivia().empty());
+        if (actual[i].kind == TokenKind::StringLiteral)
+            CHECK(actual[i].valueText() == "a b");
+        else
+            CHECK(actual[i].valueText() == expected[i].valueText());
+    }
+
+    // Printing gives equivalent source, minus most comments and original spacing.
+    // The comment with a line continuation keeps its trivia, since it matters
+    // to the preprocessor.
+    std::string result;
+    for (Token token : actual)
+        result += SyntaxPrinter().setIncludeDirectives(false).print(token).str();
+    CHECK(result == "\nmodule m;\nint i = 2 + \n 1 * 8'h 3 // comment ending in a continuation "
+                    "\\\n    + 4;\nint j = 8'h 1F;\nstring s = \"a b\";\nendmodule\n");
+}
+
+TEST_CASE("Chunk boundaries for parallel lexing") {
+    std::string text = "a\n"
+                       "/* x\n y */\n"
+                       "b \"s\\\nt\"\n"
+                       "c \\\n"
+                       "d\n"
+                       "\\e/*f\n"
+                       "`define S `\"g`\"\n"
+                       "h // \"\n"
+                       "i\n";
+
+    SmallVectorSized<size_t, 16> boundaries;
+    ChunkedLexer::findChunkBoundaries(text, 1, boundaries);
+
+    // Every line break outside of comments, strings and line continuations.
+    auto after = [&](string_view str) { return text.find(str) + str.size(); };
+    std::vector<size_t> expected = { 0,           after("a\n"),    after("*/\n"),
+                                     after("t\"\n"), after("d\n"),  after("\\e/*f\n"),
+                                     after("`\"\n"), after("// \"\n") };
+    CHECK(std::vector<size_t>(boundaries.begin(), boundaries.end()) == expected);
+}
+
+TEST_CASE("Preprocessing with chunked lexing") {
+    std::string text;
+    for (int i = 0; i < 40; i++) {
+        std::string n = std::to_string(i);
+        text += "module m" + n + R"(;
+  /* block comment
+     with "a quote" and // slashes */
+  string s = "a string with /* and \
+continued)" + (i % 4 ? "" : " \\xZZ") + R"(";
+  wire \esc/*aped ; // escaped identifier
+  `define FOO)" + n + R"((x) x + \
+     1 // done
+  int i = `FOO)" + n + R"((2);
+`ifdef NOT_DEFINED
+  this is /* disabled */ text "
+`else
+  int j = 8'hff;
+`endif
+`begin_keywords "1364-1995"
+  wire logic;
+`end_keywords
+endmodule
+)";
+    }
+
+    auto run = [&](ThreadPool* pool, size_t chunkSize, uint32_t maxErrors = 16) {
+        PreprocessorOptions ppOptions;
+        ppOptions.lexPool = pool;
+        ppOptions.lexChunkSize = chunkSize;
+        LexerOptions lexerOptions;
+        lexerOptions.maxErrors = maxErrors;
+        Bag options;
+        options.add(ppOptions);
+        options.add(lexerOptions);
+
+        diagnostics.clear();
+        std::vector<std::tuple<TokenKind, uint32_t, std::string>> tokens;
+        {
+            Preprocessor preprocessor(getSourceManager(), alloc, diagnostics, options);
+            preprocessor.pushSource(getSourceManager().assignText(text));
+            while (true) {
+                Token token = preprocessor.next();
+                tokens.emplace_back(token.kind, token.location().offset(), token.toString());
+                if (token.kind == TokenKind::EndOfFile)
+                    break;
+            }
+        }
+
+        std::vector<std::pair<DiagCode, uint32_t>> diags;
+        for (auto& diag : diagnostics)
+            diags.emplace_back(diag.code, diag.location.offset());
+        return std::make_tuple(tokens, diags);
+    };
+
+    auto [expectedTokens, expectedDiags] = run(nullptr, 0);
+    CHECK(expectedDiags.size() == 10);
+
+    // Chunks small enough to start inside every kind of construct, and big
+    // enough to need the serial fallback to resync within a chunk.
+    ThreadPool pool(4);
+    for (size_t chunkSize : { 1, 37, 200, 1000 }) {
+        auto [tokens, diags] = run(&pool, chunkSize);
+        CHECK(tokens == expectedTokens);
+        CHECK(diags == expectedDiags);
+    }
+
+    // The error limit applies to the buffer as a whole, not to each chunk.
+    auto [limitedTokens, limitedDiags] = run(nullptr, 0, 4);
+    CHECK(limitedDiags.size() < expectedDiags.size());
+    CHECK(limitedDiags.back().first == DiagCode::TooManyLexerErrors);
+    for (size_t chunkSize : { 37, 200, 1000 }) {
+        auto [tokens, diags] = run(&pool, chunkSize, 4);
+        CHECK(tokens == limitedTokens);
+        CHECK(diags == limitedDiags);
+    }
+}
+
+TEST_CASE("Include token cache") {
+    auto& text = "`include \"unguarded.svh\"\n"
+                 "`include \"unguarded.svh\"\n"
+                 "`include \"lex_error.svh\"\n"
+                 "`include \"unguarded.svh\"\n"
+                 "`include \"lex_error.svh\"\n";
+
+    SourceManager sourceManager;
+    sourceManager.addUserDirectory(string_view(findTestDir()));
+
+    auto run = [&](TokenStreamCache* cache, bool discardTrivia) {
+        PreprocessorOptions ppOptions;
+        ppOptions.tokenCache = cache;
+        LexerOptions lexerOptions;
+        lexerOptions.discardTrivia = discardTrivia;
+        Bag options;
+        options.add(ppOptions);
+        options.add(lexerOptions);
+
+        Diagnostics diags;
+        Preprocessor preprocessor(sourceManager, alloc, diags, options);
+        preprocessor.pushSource(sourceManager.assignText("source", text));
+
+        std::vector<std::tuple<std::string, std::string, uint32_t>> tokens;
+        while (true) {
+            Token token = preprocessor.next();
+            SourceLocation loc = token.location();
+            tokens.emplace_back(token.toString(), std::string(sourceManager.getFileName(loc)),
+                                loc.offset());
+            if (token.kind == TokenKind::EndOfFile)
+                break;
+        }
+
+        std::vector<std::tuple<DiagCode, std::string, uint32_t>> diagList;
+        for (auto& diag : diags) {
+            diagList.emplace_back(diag.code, std::string(sourceManager.getFileName(diag.location)),
+                                  diag.location.offset());
+        }
+        return std::make_tuple(tokens, diagList);
+    };
+
+    TokenStreamCache cache;
+    auto [expectedTokens, expectedDiags] = run(nullptr, false);
+    auto [tokens, diags] = run(&cache, false);
+
+    CHECK(tokens == expectedTokens);
+    CHECK(diags == expectedDiags);
+    CHECK(diags.size() == 2);
+
+    // The file with lexer errors is lexed fresh each time so that they get reported.
+    CHECK(cache.size() == 1);
+
+    // A second preprocessor sharing the cache gets the same results.
+    auto [tokens2, diags2] = run(&cache, false);
+    CHECK(tokens2 == expectedTokens);
+    CHECK(diags2 == expectedDiags);
+
+    // One with different lexer options doesn't use the cached tokens.
+    auto [discardedTokens, discardedDiags] = run(nullptr, true);
+    auto [tokens3, diags3] = run(&cache, true);
+    CHECK(discardedTokens != expectedTokens);
+    CHECK(tokens3 == discardedTokens);
+    CHECK(diags3 == discardedDiags);
+}
@@ -75,3 +75,103 @@ module M;
 endmodule
 )");
 }
+
+TEST_CASE("Iterative visiting and rewriting of deep trees") {
+    // A long chain of binary operators makes a tree deep enough that
+    // visiting it recursively would overflow the stack.
+    std::string text = "module M; assign x = a0";
+    for (int i = 1; i < 500000; i++)
+        text += " + a" + std::to_string(i % 10);
+    text += ";\nendmodule\n";
+    auto tree = SyntaxTree::fromText(text);
+
+    struct Renamer : public SyntaxRewriter<Renamer, true> {
+        std::vector<std::string> visited;
+
+        void handle(const IdentifierNameSyntax& name) {
+            if (visited.size() < 4)
+                visited.emplace_back(name.identifier.valueText());
+            if (name.identifier.valueText() == "a0")
+                replace(name, parse(" z"));
+        }
+
+        void visitToken(Token token) {
+            if (visited.size() < 4)
+                visited.emplace_back(token.valueText());
+        }
+    };
+
+    Renamer renamer;
+    auto newTree = renamer.transform(tree);
+    CHECK(renamer.visited == std::vector<std::string>{ "module", "M", ";", "assign" });
+
+    std::string expected = text;
+    for (size_t pos = 0; (pos = expected.find(" a0", pos)) != std::string::npos;)
+        expected.replace(pos, 3, " z");
+    CHECK((SyntaxPrinter::printFile(*newTree) == expected));
+    CHECK((SyntaxPrinter::printFile(*tree) == text));
+
+    auto& module = newTree->root().as<ModuleDeclarationSyntax>();
+    auto& assign = module.members[0]->as<ContinuousAssignSyntax>();
+    auto& expr = assign.assignments[0]->as<BinaryExpressionSyntax>();
+    CHECK(expr.getFirstToken().valueText() == "x");
+    CHECK(expr.getLastToken().valueText() == "a9");
+    CHECK(expr.right->getFirstToken().valueText() == "z");
+}
+
+TEST_CASE("Rewriting shares untouched subtrees") {
+    auto tree = SyntaxTree::fromText(R"(
+module M;
+    assign a = b + c;
+    assign d = e + f;
+endmodule
+)");
+    auto original = SyntaxPrinter::printFile(*tree);
+
+    struct Renamer : public SyntaxRewriter<Renamer> {
+        string_view from;
+        string_view to;
+
+        Renamer(string_view from, string_view to) : from(from), to(to) {}
+
+        void handle(const IdentifierNameSyntax& name) {
+            if (name.identifier.valueText() == from)
+                replace(name, parse(to));
+        }
+    };
+
+    auto newTree = Renamer("c", " g").transform(tree);
+    CHECK(SyntaxPrinter::printFile(*newTree) == R"(
+module M;
+    assign a = b + g;
+    assign d = e + f;
+endmodule
+)");
+    CHECK(SyntaxPrinter::printFile(*tree) == original);
+    CHECK(newTree->getParentTree() == tree.get());
+
+    auto& oldModule = tree->root().as<ModuleDeclarationSyntax>();
+    auto& newModule = newTree->root().as<ModuleDeclarationSyntax>();
+    CHECK(&oldModule != &newModule);
+    CHECK(oldModule.header == newModule.header);
+    CHECK(oldModule.members[0] != newModule.members[0]);
+    CHECK(oldModule.members[1] == newModule.members[1]);
+
+    auto& oldAssign = oldModule.members[0]->as<ContinuousAssignSyntax>();
+    auto& newAssign = newModule.members[0]->as<ContinuousAssignSyntax>();
+    auto& oldExpr = oldAssign.assignments[0]->as<BinaryExpressionSyntax>();
+    auto& newExpr = newAssign.assignments[0]->as<BinaryExpressionSyntax>();
+    CHECK(oldExpr.left == newExpr.left);
+    CHECK(oldExpr.right != newExpr.right);
+
+    // Nodes shared with the original tree still have parents in it, which
+    // rewriting the new tree again has to cope with.
+    auto thirdTree = Renamer("f", " h").transform(newTree);
+    CHECK(SyntaxPrinter::printFile(*thirdTree) == R"(
+module M;
+    assign a = b + g;
+    assign d = e + h;
+endmodule
+)");
+    CHECK(SyntaxPrinter::printFile(*newTree).find("e + f") != std::string::npos);
+}
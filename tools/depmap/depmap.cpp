@@ -15,11 +15,20 @@ using namespace slang;
 
 class DependencyMapper : public SyntaxVisitor<DependencyMapper> {
 public:
+    DependencyMapper() {
+        // Dependencies only depend on names, so there's no need to decode literal values.
+        // Bodies get parsed when visited, so they can be skimmed until then.
+        ParserOptions parserOptions;
+        parserOptions.lazyIntegerLiterals = true;
+        parserOptions.skimBodies = true;
+        options.add(parserOptions);
+    }
+
     void addIncludeDir(const std::string& dir) { sourceManager.addUserDirectory(string_view(dir)); }
 
     void parseFile(const std::string& path) {
         currentFile = path;
-        auto tree = SyntaxTree::fromFile(currentFile, sourceManager);
+        auto tree = SyntaxTree::fromFile(currentFile, sourceManager, options);
         // visitNode(&tree->root());
 
         // printf("%s", tree->root().toString(SyntaxToStringFlags::IncludePreprocessed |
@@ -64,6 +73,7 @@ public:
 
 private:
     SourceManager sourceManager;
+    Bag options;
     std::string currentFile;
 
     // Map from source element (module declaration, package declaration) to file.
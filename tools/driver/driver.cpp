@@ -11,8 +11,10 @@
 
 #include "slang/compilation/Compilation.h"
 #include "slang/diagnostics/DiagnosticWriter.h"
+#include "slang/syntax/ParallelSyntaxTreeBuilder.h"
 #include "slang/syntax/SyntaxPrinter.h"
 #include "slang/syntax/SyntaxTree.h"
+#include "slang/util/ThreadPool.h"
 
 using namespace slang;
 
@@ -70,11 +72,16 @@ bool runPreprocessor(SourceManager& sourceManager, const Bag& options,
 }
 
 bool runCompiler(SourceManager& sourceManager, const Bag& options,
-                 const std::vector<SourceBuffer>& buffers, const std::string& astJsonFile) {
+                 const std::vector<SourceBuffer>& buffers, const std::string& astJsonFile,
+                 uint32_t numThreads) {
 
-    Compilation compilation;
+    ParallelSyntaxTreeBuilder builder(sourceManager, options, numThreads);
     for (const SourceBuffer& buffer : buffers)
-        compilation.addSyntaxTree(SyntaxTree::fromBuffer(buffer, sourceManager, options));
+        builder.addBuffer(buffer);
+
+    Compilation compilation;
+    for (auto& tree : builder.build())
+        compilation.addSyntaxTree(std::move(tree));
 
     auto& diagnostics = compilation.getAllDiagnostics();
     DiagnosticWriter writer(sourceManager);
@@ -98,6 +105,7 @@ int main(int argc, char** argv) try {
     std::string astJsonFile;
 
     bool onlyPreprocess;
+    uint32_t numThreads = 0;
 
     CLI::App cmd("SystemVerilog compiler");
     cmd.add_option("files", sourceFiles, "Source files to compile");
@@ -110,6 +118,8 @@ int main(int argc, char** argv) try {
                    "Undefine macro name at the start of all source files");
     cmd.add_flag("-E,--preprocess", onlyPreprocess,
                  "Only run the preprocessor (and print preprocessed files to stdout)");
+    cmd.add_option("-j,--threads", numThreads,
+                   "Number of threads to use for parsing source files (0 for one per core)");
 
     cmd.add_option("--ast-json", astJsonFile,
                    "Dump the compiled AST in JSON format to the specified file, or '-' for stdout");
@@ -134,7 +144,16 @@ int main(int argc, char** argv) try {
     ppoptions.predefineSource = "<command-line>";
 
     Bag options;
-    options.add(ppoptions);
+
+    // Nothing prints the syntax trees when compiling, so don't keep trivia around,
+    // and don't bother lexing guarded headers that get included more than once.
+    if (!onlyPreprocess) {
+        ppoptions.skipGuardedIncludes = true;
+
+        LexerOptions lexerOptions;
+        lexerOptions.discardTrivia = true;
+        options.add(lexerOptions);
+    }
 
     bool anyErrors = false;
     std::vector<SourceBuffer> buffers;
@@ -154,11 +173,26 @@ int main(int argc, char** argv) try {
         return 1;
     }
 
+    // Very large files (like gate-level netlists) get lexed in chunks on their own threads,
+    // separate from the ones parsing files. Most runs don't have any, so only start
+    // those threads when one shows up.
+    std::unique_ptr<ThreadPool> lexPool;
+    if (numThreads != 1) {
+        for (auto& buffer : buffers) {
+            if (buffer.data.size() > ppoptions.lexChunkSize * 2) {
+                lexPool = std::make_unique<ThreadPool>(numThreads);
+                ppoptions.lexPool = lexPool.get();
+                break;
+            }
+        }
+    }
+    options.add(ppoptions);
+
     try {
         if (onlyPreprocess)
             anyErrors |= !runPreprocessor(sourceManager, options, buffers);
         else
-            anyErrors |= !runCompiler(sourceManager, options, buffers, astJsonFile);
+            anyErrors |= !runCompiler(sourceManager, options, buffers, astJsonFile, numThreads);
     }
     catch (const std::exception& e) {
         fmt::print("internal compiler error: {}\n", e.what());
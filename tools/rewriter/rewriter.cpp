@@ -28,7 +28,14 @@ int main(int argc, char** argv) try {
     _setmode(_fileno(stdout), _O_BINARY);
 #endif
 
-    auto tree = SyntaxTree::fromFile(argv[1]);
+    // We only print the tree back out, so there's no need to decode literal values.
+    ParserOptions parserOptions;
+    parserOptions.lazyIntegerLiterals = true;
+
+    Bag options;
+    options.add(parserOptions);
+
+    auto tree = SyntaxTree::fromFile(argv[1], SyntaxTree::getDefaultSourceManager(), options);
     printf("%s", SyntaxPrinter::printFile(*tree).c_str());
     return 0;
 }